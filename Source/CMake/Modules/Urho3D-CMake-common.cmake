@@ -58,6 +58,7 @@ if (CMAKE_PROJECT_NAME STREQUAL Urho3D)
     option (URHO3D_SAMPLES "Build sample applications")
     cmake_dependent_option (URHO3D_TOOLS "Build standalone tools (Desktop and RPI only; on Android only build Lua standalone tools)" TRUE "NOT IOS;NOT ANDROID OR URHO3D_LUA OR URHO3D_LUAJIT" FALSE)
     cmake_dependent_option (URHO3D_EXTRAS "Build extras (Desktop and RPI only)" FALSE "NOT IOS AND NOT ANDROID" FALSE)
+    cmake_dependent_option (URHO3D_BENCHMARKS "Build headless benchmark suite (Desktop and RPI only)" FALSE "NOT IOS AND NOT ANDROID" FALSE)
     option (URHO3D_DOCS "Generate documentation as part of normal build")
     option (URHO3D_DOCS_QUIET "Generate documentation as part of normal build, suppress generation process from sending anything to stdout")
     cmake_dependent_option (URHO3D_MINIDUMPS "Enable minidumps on crash (VS only)" TRUE "MSVC" FALSE)
@@ -65,6 +66,9 @@ if (CMAKE_PROJECT_NAME STREQUAL Urho3D)
 endif ()
 option (URHO3D_PROFILING "Enable profiling support" TRUE)
 option (URHO3D_LOGGING "Enable logging support" TRUE)
+option (URHO3D_CXX11 "Enable C++11 standard, string hash constants are then evaluated at compile time")
+option (URHO3D_HASH_DEBUG "Enable StringHash collision detection and reverse lookup of hashed strings")
+option (URHO3D_ATOMIC_REFCOUNT "Enable atomic reference counting, which allows SharedPtr and WeakPtr to the same object to be used from multiple threads")
 option (URHO3D_TESTING "Enable testing support")
 if (URHO3D_TESTING)
     set (URHO3D_TEST_TIME_OUT 5 CACHE STRING "Number of seconds to test run the executables")
@@ -147,6 +151,25 @@ if (URHO3D_LOGGING)
     add_definitions (-DURHO3D_LOGGING)
 endif ()
 
+# Enable C++11 standard if requested. Event, event parameter and shader parameter string hashes become constexpr.
+# MSVC enables its supported C++11 features by default, but requires VS2015 for constexpr.
+if (URHO3D_CXX11)
+    add_definitions (-DURHO3D_CXX11)
+    if (NOT MSVC)
+        set (CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -std=c++0x")
+    endif ()
+endif ()
+
+# Enable StringHash collision detection. Every string hashed at runtime is registered to a global map, which has a cost.
+if (URHO3D_HASH_DEBUG)
+    add_definitions (-DURHO3D_HASH_DEBUG)
+endif ()
+
+# Enable atomic reference counting. This has a small cost on every SharedPtr and WeakPtr copy and release.
+if (URHO3D_ATOMIC_REFCOUNT)
+    add_definitions (-DURHO3D_ATOMIC_REFCOUNT)
+endif ()
+
 # If not on MSVC, enable use of OpenGL instead of Direct3D9 (either not compiling on Windows or
 # with a compiler that may not have an up-to-date DirectX SDK). This can also be unconditionally
 # enabled, but Windows graphics card drivers are usually better optimized for Direct3D. Direct3D can
@@ -156,7 +156,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->refs_ >= 0);
-            ++(refCount_->refs_);
+            RefCount::Increment(refCount_->refs_);
         }
     }
     
@@ -166,8 +166,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->refs_ > 0);
-            --(refCount_->refs_);
-            if (!refCount_->refs_)
+            if (!RefCount::Decrement(refCount_->refs_))
             {
                 refCount_->refs_ = -1;
                 delete[] ptr_;
@@ -367,7 +366,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ >= 0);
-            ++(refCount_->weakRefs_);
+            RefCount::Increment(refCount_->weakRefs_);
         }
     }
     
@@ -379,7 +378,7 @@ private:
             assert(refCount_->weakRefs_ >= 0);
             
             if (refCount_->weakRefs_ > 0)
-                --(refCount_->weakRefs_);
+                RefCount::Decrement(refCount_->weakRefs_);
             
             if (Expired() && !refCount_->weakRefs_)
                 delete refCount_;
@@ -110,9 +110,9 @@ public:
         if (ptr_)
         {
             RefCount* refCount = RefCountPtr();
-            ++refCount->refs_; // 2 refs
+            RefCount::Increment(refCount->refs_); // 2 refs
             Reset(); // 1 ref
-            --refCount->refs_; // 0 refs
+            RefCount::Decrement(refCount->refs_); // 0 refs
         }
     }
     
@@ -384,7 +384,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ >= 0);
-            ++(refCount_->weakRefs_);
+            RefCount::Increment(refCount_->weakRefs_);
         }
     }
     
@@ -394,9 +394,9 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ > 0);
-            --(refCount_->weakRefs_);
-            
-            if (Expired() && !refCount_->weakRefs_)
+            // The object holds a weak reference to itself until destroyed, so only the last weak reference release
+            // sees the count go to zero, and the object has then always expired
+            if (!RefCount::Decrement(refCount_->weakRefs_) && Expired())
                 delete refCount_;
         }
         
@@ -34,7 +34,7 @@ RefCounted::RefCounted() :
     refCount_(new RefCount())
 {
     // Hold a weak ref to self to avoid possible double delete of the refcount
-    (refCount_->weakRefs_)++;
+    RefCount::Increment(refCount_->weakRefs_);
 }
 
 RefCounted::~RefCounted()
@@ -45,8 +45,7 @@ RefCounted::~RefCounted()
     
     // Mark object as expired, release the self weak ref and delete the refcount if no other weak refs exist
     refCount_->refs_ = -1;
-    (refCount_->weakRefs_)--;
-    if (!refCount_->weakRefs_)
+    if (!RefCount::Decrement(refCount_->weakRefs_))
         delete refCount_;
     
     refCount_ = 0;
@@ -55,15 +54,14 @@ RefCounted::~RefCounted()
 void RefCounted::AddRef()
 {
     assert(refCount_->refs_ >= 0);
-    (refCount_->refs_)++;
+    RefCount::Increment(refCount_->refs_);
 }
 
 void RefCounted::ReleaseRef()
 {
     assert(refCount_->refs_ > 0);
-    (refCount_->refs_)--;
-    if (!refCount_->refs_)
-        delete this;
+    if (!RefCount::Decrement(refCount_->refs_))
+        Destroy();
 }
 
 int RefCounted::Refs() const
@@ -77,4 +75,9 @@ int RefCounted::WeakRefs() const
     return refCount_->weakRefs_ - 1;
 }
 
+void RefCounted::Destroy()
+{
+    delete this;
+}
+
 }
@@ -24,6 +24,10 @@
 
 #include "Urho3D.h"
 
+#if defined(URHO3D_ATOMIC_REFCOUNT) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace Urho3D
 {
 
@@ -45,6 +49,34 @@ struct RefCount
         weakRefs_ = -1;
     }
     
+    /// Increment a reference count and return the new value. Atomic with relaxed ordering if URHO3D_ATOMIC_REFCOUNT is enabled.
+    static int Increment(int& count)
+    {
+        #if !defined(URHO3D_ATOMIC_REFCOUNT)
+        return ++count;
+        #elif defined(_MSC_VER)
+        return _InterlockedIncrement(reinterpret_cast<volatile long*>(&count));
+        #elif defined(__ATOMIC_RELAXED)
+        return __atomic_add_fetch(&count, 1, __ATOMIC_RELAXED);
+        #else
+        return __sync_add_and_fetch(&count, 1);
+        #endif
+    }
+    
+    /// Decrement a reference count and return the new value. Atomic with acquire-release ordering if URHO3D_ATOMIC_REFCOUNT is enabled, so that all writes to the object are visible to the thread that destroys it.
+    static int Decrement(int& count)
+    {
+        #if !defined(URHO3D_ATOMIC_REFCOUNT)
+        return --count;
+        #elif defined(_MSC_VER)
+        return _InterlockedDecrement(reinterpret_cast<volatile long*>(&count));
+        #elif defined(__ATOMIC_ACQ_REL)
+        return __atomic_sub_fetch(&count, 1, __ATOMIC_ACQ_REL);
+        #else
+        return __sync_sub_and_fetch(&count, 1);
+        #endif
+    }
+    
     /// Reference count. If below zero, the object has been destroyed.
     int refs_;
     /// Weak reference count.
@@ -71,6 +103,10 @@ public:
     /// Return pointer to the reference count structure.
     RefCount* RefCountPtr() { return refCount_; }
     
+protected:
+    /// Delete self when the reference count reaches zero. Can be overridden to return the memory elsewhere than the heap.
+    virtual void Destroy();
+    
 private:
     /// Prevent copy construction.
     RefCounted(const RefCounted& rhs);
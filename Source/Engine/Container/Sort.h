@@ -23,24 +23,35 @@
 #pragma once
 
 #include "Swap.h"
-#include "VectorBase.h"
+#include "Vector.h"
 
 namespace Urho3D
 {
 
-static const int QUICKSORT_THRESHOLD = 16;
+/// Ranges shorter than this are finished with insertion sort.
+static const int QUICKSORT_THRESHOLD = 24;
+/// Ranges longer than this choose the quicksort pivot as a pseudomedian of nine instead of a median of three.
+static const int NINTHER_THRESHOLD = 128;
+/// Maximum number of element moves before an insertion sort on a range that looks already sorted gives up.
+static const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+/// Length of the runs that stable sort sorts with insertion sort before merging.
+static const int STABLE_SORT_RUN = 32;
 
-// Based on Comparison of several sorting algorithms by Juha Nieminen
-// http://warp.povusers.org/SortComparison/
+/// Default compare function for sorting in ascending order.
+template <class T> struct SortLess
+{
+    /// Return whether lhs should be sorted before rhs.
+    bool operator () (const T& lhs, const T& rhs) const { return lhs < rhs; }
+};
 
-/// Perform insertion sort on an array.
-template <class T> void InsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
+/// Perform insertion sort on an array using a compare function. Stable.
+template <class T, class U> void InsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
 {
     for (RandomAccessIterator<T> i = begin + 1; i < end; ++i)
     {
         T temp = *i;
         RandomAccessIterator<T> j = i;
-        while (j > begin && temp < *(j - 1))
+        while (j > begin && compare(temp, *(j - 1)))
         {
             *j = *(j - 1);
             --j;
@@ -49,96 +60,340 @@ template <class T> void InsertionSort(RandomAccessIterator<T> begin, RandomAcces
     }
 }
 
-/// Perform insertion sort on an array using a compare function.
-template <class T, class U> void InsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+/// Perform insertion sort on an array. Stable.
+template <class T> void InsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
+{
+    InsertionSort(begin, end, SortLess<T>());
+}
+
+/// Perform insertion sort on an array whose preceding element is known to not sort after any element of the array, which allows skipping the bounds check.
+template <class T, class U> void UnguardedInsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
 {
     for (RandomAccessIterator<T> i = begin + 1; i < end; ++i)
     {
-        T temp = *i;
-        RandomAccessIterator<T> j = i;
-        while (j > begin && compare(temp, *(j - 1)))
+        if (compare(*i, *(i - 1)))
         {
-            *j = *(j - 1);
-            --j;
+            T temp = *i;
+            RandomAccessIterator<T> j = i;
+            do
+            {
+                *j = *(j - 1);
+                --j;
+            }
+            while (compare(temp, *(j - 1)));
+            *j = temp;
         }
-        *j = temp;
     }
 }
 
-/// Perform quick sort initial pass on an array. Does not sort fully.
-template <class T> void InitialQuickSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
+/// Attempt insertion sort on an array that is expected to be nearly sorted. Return false without finishing if too many elements need to be moved.
+template <class T, class U> bool PartialInsertionSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
 {
-    while (end - begin > QUICKSORT_THRESHOLD)
+    int moves = 0;
+    
+    for (RandomAccessIterator<T> i = begin + 1; i < end; ++i)
     {
-        // Choose the pivot by median
-        RandomAccessIterator<T> pivot = begin + ((end - begin) / 2);
-        if (*begin < *pivot && *(end - 1) < *begin)
-            pivot = begin;
-        else if (*(end - 1) < *pivot && *begin < *(end - 1))
-            pivot = end - 1;
+        if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+            return false;
         
-        // Partition and sort recursively
-        RandomAccessIterator<T> i = begin - 1;
-        RandomAccessIterator<T> j = end;
-        T pivotValue = *pivot;
-        for (;;)
+        if (compare(*i, *(i - 1)))
         {
-            while (pivotValue < *(--j));
-            while (*(++i) < pivotValue);
-            if (i < j)
-                Swap(*i, *j);
-            else
-                break;
+            T temp = *i;
+            RandomAccessIterator<T> j = i;
+            do
+            {
+                *j = *(j - 1);
+                --j;
+            }
+            while (j > begin && compare(temp, *(j - 1)));
+            *j = temp;
+            moves += i - j;
         }
-        
-        InitialQuickSort(begin, j + 1);
-        begin = j + 1;
     }
+    
+    return true;
 }
 
-/// Perform quick sort initial pass on an array using a compare function. Does not sort fully.
-template <class T, class U> void InitialQuickSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+/// Restore the heap property below an element of a max-heap.
+template <class T, class U> void SiftDown(RandomAccessIterator<T> begin, int root, int size, U compare)
 {
-    while (end - begin > QUICKSORT_THRESHOLD)
+    T value = *(begin + root);
+    
+    for (;;)
     {
-        // Choose the pivot by median
-        RandomAccessIterator<T> pivot = begin + ((end - begin) / 2);
-        if (compare(*begin, *pivot) && compare(*(end - 1), *begin))
-            pivot = begin;
-        else if (compare(*(end - 1), *pivot) && compare(*begin, *(end - 1)))
-            pivot = end - 1;
-        
-        // Partition and sort recursively
-        RandomAccessIterator<T> i = begin - 1;
-        RandomAccessIterator<T> j = end;
-        T pivotValue = *pivot;
-        for (;;)
+        int child = root * 2 + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && compare(*(begin + child), *(begin + (child + 1))))
+            ++child;
+        if (!compare(value, *(begin + child)))
+            break;
+        *(begin + root) = *(begin + child);
+        root = child;
+    }
+    
+    *(begin + root) = value;
+}
+
+/// Perform heap sort on an array using a compare function. Guaranteed O(n log n), used as the fallback when quicksort partitions badly.
+template <class T, class U> void HeapSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+{
+    int size = end - begin;
+    
+    for (int i = size / 2 - 1; i >= 0; --i)
+        SiftDown(begin, i, size, compare);
+    for (int i = size - 1; i > 0; --i)
+    {
+        Swap(*begin, *(begin + i));
+        SiftDown(begin, 0, i, compare);
+    }
+}
+
+/// Order two elements.
+template <class T, class U> void SortTwo(RandomAccessIterator<T> a, RandomAccessIterator<T> b, U compare)
+{
+    if (compare(*b, *a))
+        Swap(*a, *b);
+}
+
+/// Order three elements, so that the median ends up in the middle.
+template <class T, class U> void SortThree(RandomAccessIterator<T> a, RandomAccessIterator<T> b, RandomAccessIterator<T> c, U compare)
+{
+    SortTwo(a, b, compare);
+    SortTwo(b, c, compare);
+    SortTwo(a, b, compare);
+}
+
+/// Partition an array around the pivot at its beginning, moving elements equal to the pivot to the right side. Return the final pivot position, and whether no elements had to be swapped.
+template <class T, class U> RandomAccessIterator<T> PartitionRight(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare,
+    bool& alreadyPartitioned)
+{
+    T pivot = *begin;
+    RandomAccessIterator<T> first = begin;
+    RandomAccessIterator<T> last = end;
+    
+    // The pivot selection guarantees an element not less than the pivot, so this scan needs no bounds check
+    while (compare(*(++first), pivot));
+    
+    // Check bounds on the second scan only if no element less than the pivot has been seen yet
+    if (first - 1 == begin)
+    {
+        while (first < last && !compare(*(--last), pivot));
+    }
+    else
+    {
+        while (!compare(*(--last), pivot));
+    }
+    
+    alreadyPartitioned = first >= last;
+    
+    while (first < last)
+    {
+        Swap(*first, *last);
+        while (compare(*(++first), pivot));
+        while (!compare(*(--last), pivot));
+    }
+    
+    RandomAccessIterator<T> pivotPos = first - 1;
+    *begin = *pivotPos;
+    *pivotPos = pivot;
+    return pivotPos;
+}
+
+/// Partition an array around the pivot at its beginning, moving elements equal to the pivot to the left side. Used when the pivot equals the element preceding the array, so that runs of equal elements are skipped at once.
+template <class T, class U> RandomAccessIterator<T> PartitionLeft(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+{
+    T pivot = *begin;
+    RandomAccessIterator<T> first = begin;
+    RandomAccessIterator<T> last = end;
+    
+    while (compare(pivot, *(--last)));
+    
+    if (last + 1 == end)
+    {
+        while (first < last && !compare(pivot, *(++first)));
+    }
+    else
+    {
+        while (!compare(pivot, *(++first)));
+    }
+    
+    while (first < last)
+    {
+        Swap(*first, *last);
+        while (compare(pivot, *(--last)));
+        while (!compare(pivot, *(++first)));
+    }
+    
+    RandomAccessIterator<T> pivotPos = last;
+    *begin = *pivotPos;
+    *pivotPos = pivot;
+    return pivotPos;
+}
+
+/// Pattern-defeating quicksort pass. Sorts the left partition recursively and the right by looping. Falls back to heap sort after too many unbalanced partitions.
+template <class T, class U> void QuickSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare, int badAllowed, bool leftmost)
+{
+    for (;;)
+    {
+        int size = end - begin;
+        if (size < QUICKSORT_THRESHOLD)
         {
-            while (compare(pivotValue, *(--j)));
-            while (compare(*(++i), pivotValue));
-            if (i < j)
-                Swap(*i, *j);
+            if (leftmost)
+                InsertionSort(begin, end, compare);
             else
-                break;
+                UnguardedInsertionSort(begin, end, compare);
+            return;
+        }
+        
+        // Choose the pivot and move it to the beginning
+        int half = size / 2;
+        if (size > NINTHER_THRESHOLD)
+        {
+            SortThree(begin, begin + half, end - 1, compare);
+            SortThree(begin + 1, begin + (half - 1), end - 2, compare);
+            SortThree(begin + 2, begin + (half + 1), end - 3, compare);
+            SortThree(begin + (half - 1), begin + half, begin + (half + 1), compare);
+            Swap(*begin, *(begin + half));
+        }
+        else
+            SortThree(begin + half, begin, end - 1, compare);
+        
+        // If the preceding element is not less than the pivot, they are equal, and no element of the range sorts before the pivot
+        if (!leftmost && !compare(*(begin - 1), *begin))
+        {
+            begin = PartitionLeft(begin, end, compare) + 1;
+            continue;
+        }
+        
+        bool alreadyPartitioned;
+        RandomAccessIterator<T> pivotPos = PartitionRight(begin, end, compare, alreadyPartitioned);
+        int leftSize = pivotPos - begin;
+        int rightSize = end - (pivotPos + 1);
+        
+        if (leftSize < size / 8 || rightSize < size / 8)
+        {
+            // Highly unbalanced partition. Give up on quicksort if this keeps happening, otherwise shuffle some elements to
+            // break the input pattern
+            if (--badAllowed == 0)
+            {
+                HeapSort(begin, end, compare);
+                return;
+            }
+            
+            if (leftSize >= QUICKSORT_THRESHOLD)
+            {
+                Swap(*begin, *(begin + leftSize / 4));
+                Swap(*(pivotPos - 1), *(pivotPos - leftSize / 4));
+                if (leftSize > NINTHER_THRESHOLD)
+                {
+                    Swap(*(begin + 1), *(begin + (leftSize / 4 + 1)));
+                    Swap(*(begin + 2), *(begin + (leftSize / 4 + 2)));
+                    Swap(*(pivotPos - 2), *(pivotPos - (leftSize / 4 + 1)));
+                    Swap(*(pivotPos - 3), *(pivotPos - (leftSize / 4 + 2)));
+                }
+            }
+            if (rightSize >= QUICKSORT_THRESHOLD)
+            {
+                Swap(*(pivotPos + 1), *(pivotPos + (1 + rightSize / 4)));
+                Swap(*(end - 1), *(end - rightSize / 4));
+                if (rightSize > NINTHER_THRESHOLD)
+                {
+                    Swap(*(pivotPos + 2), *(pivotPos + (2 + rightSize / 4)));
+                    Swap(*(pivotPos + 3), *(pivotPos + (3 + rightSize / 4)));
+                    Swap(*(end - 2), *(end - (1 + rightSize / 4)));
+                    Swap(*(end - 3), *(end - (2 + rightSize / 4)));
+                }
+            }
+        }
+        else if (alreadyPartitioned && PartialInsertionSort(begin, pivotPos, compare) && PartialInsertionSort(pivotPos + 1, end,
+            compare))
+        {
+            // The range needed no swaps to partition and both sides turned out nearly sorted, which is common when sorting
+            // data that changes little from frame to frame
+            return;
         }
         
-        InitialQuickSort(begin, j + 1, compare);
-        begin = j + 1;
+        QuickSort(begin, pivotPos, compare, badAllowed, leftmost);
+        begin = pivotPos + 1;
+        leftmost = false;
     }
 }
 
-/// Sort in ascending order using quicksort for initial passes, then an insertion sort to finalize.
+/// Sort in ascending order using a compare function. Uses pattern-defeating quicksort, which is O(n log n) in the worst case and close to linear for sorted, reverse sorted and nearly sorted input. Not stable.
+template <class T, class U> void Sort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+{
+    int size = end - begin;
+    int badAllowed = 1;
+    while (size >>= 1)
+        ++badAllowed;
+    
+    QuickSort(begin, end, compare, badAllowed, true);
+}
+
+/// Sort in ascending order. Uses pattern-defeating quicksort, which is O(n log n) in the worst case and close to linear for sorted, reverse sorted and nearly sorted input. Not stable.
 template <class T> void Sort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
 {
-    InitialQuickSort(begin, end);
-    InsertionSort(begin, end);
+    Sort(begin, end, SortLess<T>());
 }
 
-/// Sort in ascending order using quicksort for initial passes, then an insertion sort to finalize, using a compare function.
-template <class T, class U> void Sort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+/// Merge two adjacent sorted ranges into a destination. Elements of the first range go first when equal.
+template <class T, class U> void MergeSorted(RandomAccessIterator<T> first, RandomAccessIterator<T> middle, RandomAccessIterator<T> last,
+    RandomAccessIterator<T> dest, U compare)
+{
+    RandomAccessIterator<T> i = first;
+    RandomAccessIterator<T> j = middle;
+    
+    while (i < middle && j < last)
+    {
+        if (compare(*j, *i))
+            *dest++ = *j++;
+        else
+            *dest++ = *i++;
+    }
+    while (i < middle)
+        *dest++ = *i++;
+    while (j < last)
+        *dest++ = *j++;
+}
+
+/// Sort in ascending order using a compare function, keeping the order of equal elements. Uses merge sort with a temporary buffer.
+template <class T, class U> void StableSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+{
+    int size = end - begin;
+    
+    for (int i = 0; i < size; i += STABLE_SORT_RUN)
+        InsertionSort(begin + i, begin + (i + STABLE_SORT_RUN < size ? i + STABLE_SORT_RUN : size), compare);
+    if (size <= STABLE_SORT_RUN)
+        return;
+    
+    // Merge runs of doubling width, alternating between the array and the buffer
+    Vector<T> buffer(size);
+    RandomAccessIterator<T> src = begin;
+    RandomAccessIterator<T> dest = buffer.Begin();
+    
+    for (int width = STABLE_SORT_RUN; width < size; width *= 2)
+    {
+        for (int i = 0; i < size; i += width * 2)
+        {
+            int middle = i + width < size ? i + width : size;
+            int last = i + width * 2 < size ? i + width * 2 : size;
+            MergeSorted(src + i, src + middle, src + last, dest + i, compare);
+        }
+        Swap(src, dest);
+    }
+    
+    if (src != begin)
+    {
+        for (int i = 0; i < size; ++i)
+            *(begin + i) = *(src + i);
+    }
+}
+
+/// Sort in ascending order, keeping the order of equal elements. Uses merge sort with a temporary buffer.
+template <class T> void StableSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
 {
-    InitialQuickSort(begin, end, compare);
-    InsertionSort(begin, end, compare);
+    StableSort(begin, end, SortLess<T>());
 }
 
 }
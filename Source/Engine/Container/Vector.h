@@ -153,6 +153,12 @@ public:
     void Push(const T& value) { Resize(size_ + 1, &value); }
     /// Add another vector at the end.
     void Push(const Vector<T>& vector) { Resize(size_ + vector.size_, vector.Buffer()); }
+    /// Add a default-constructed element at the end and return it, to fill in place instead of copying a temporary.
+    T& EmplaceBack()
+    {
+        Resize(size_ + 1, 0);
+        return Back();
+    }
     
     /// Remove the last element.
     void Pop()
@@ -241,6 +247,25 @@ public:
         return Begin() + pos;
     }
     
+    /// Insert elements from an iterator range of another container, such as a List or a HashSet. Reallocates at most once.
+    template <class InputIterator> Iterator Insert(const Iterator& dest, InputIterator start, InputIterator end)
+    {
+        unsigned pos = dest - Begin();
+        if (pos > size_)
+            pos = size_;
+        unsigned length = 0;
+        for (InputIterator it = start; it != end; ++it)
+            ++length;
+        Resize(size_ + length, 0);
+        MoveRange(pos + length, pos, size_ - pos - length);
+        
+        T* destPtr = Buffer() + pos;
+        for (InputIterator it = start; it != end; ++it)
+            *destPtr++ = *it;
+        
+        return Begin() + pos;
+    }
+    
     /// Erase a range of elements.
     void Erase(unsigned pos, unsigned length = 1)
     {
@@ -380,14 +405,7 @@ private:
             // Allocate new buffer if necessary and copy the current elements
             if (newSize > capacity_)
             {
-                if (!capacity_)
-                    capacity_ = newSize;
-                else
-                {
-                    while (capacity_ < newSize)
-                        capacity_ += (capacity_ + 1) >> 1;
-                }
-                
+                capacity_ = CalculateCapacity(capacity_, newSize);
                 unsigned char* newBuffer = AllocateBuffer(capacity_ * sizeof(T));
                 if (buffer_)
                 {
@@ -590,6 +608,16 @@ public:
         CopyElements(Buffer() + oldSize, vector.Buffer(), vector.size_);
     }
     
+    /// Add an uninitialized element at the end and return it, to fill in place instead of copying a temporary.
+    T& EmplaceBack()
+    {
+        if (size_ < capacity_)
+            ++size_;
+        else
+            Resize(size_ + 1);
+        return Back();
+    }
+    
     /// Remove the last element.
     void Pop()
     {
@@ -657,6 +685,12 @@ public:
         return Begin() + pos;
     }
     
+    /// Insert a vector partially by non-const iterators.
+    Iterator Insert(const Iterator& dest, const Iterator& start, const Iterator& end)
+    {
+        return Insert(dest, ConstIterator(start), ConstIterator(end));
+    }
+    
     /// Insert elements.
     Iterator Insert(const Iterator& dest, const T* start, const T* end)
     {
@@ -674,6 +708,25 @@ public:
         return Begin() + pos;
     }
     
+    /// Insert elements from an iterator range of another container, such as a List or a HashSet. Reallocates at most once.
+    template <class InputIterator> Iterator Insert(const Iterator& dest, InputIterator start, InputIterator end)
+    {
+        unsigned pos = dest - Begin();
+        if (pos > size_)
+            pos = size_;
+        unsigned length = 0;
+        for (InputIterator it = start; it != end; ++it)
+            ++length;
+        Resize(size_ + length);
+        MoveRange(pos + length, pos, size_ - pos - length);
+        
+        T* destPtr = Buffer() + pos;
+        for (InputIterator it = start; it != end; ++it)
+            *destPtr++ = *it;
+        
+        return Begin() + pos;
+    }
+    
     /// Erase a range of elements.
     void Erase(unsigned pos, unsigned length = 1)
     {
@@ -729,14 +782,7 @@ public:
     {
         if (newSize > capacity_)
         {
-            if (!capacity_)
-                capacity_ = newSize;
-            else
-            {
-                while (capacity_ < newSize)
-                    capacity_ += (capacity_ + 1) >> 1;
-            }
-            
+            capacity_ = CalculateCapacity(capacity_, newSize);
             unsigned char* newBuffer = AllocateBuffer(capacity_ * sizeof(T));
             // Move the data into the new buffer and delete the old
             if (buffer_)
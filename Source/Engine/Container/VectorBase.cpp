@@ -21,15 +21,100 @@
 //
 
 #include "Precompiled.h"
-#include "VectorBase.h"
+#include "Mutex.h"
+#include "Vector.h"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define RETURN_ADDRESS _ReturnAddress()
+#else
+#define RETURN_ADDRESS __builtin_return_address(0)
+#endif
 
 #include "DebugNew.h"
 
 namespace Urho3D
 {
 
+/// Maximum number of code sites tracked by the allocation statistics. Allocations from further sites are counted on a null site.
+static const unsigned MAX_ALLOCATION_SITES = 4096;
+
+unsigned VectorBase::growthPercent = 50;
+bool VectorBase::allocationStats = false;
+
+/// Allocation statistics hash table, indexed by the site address. Not allocated from the heap, as vectors are used to return it.
+static VectorAllocationSite allocationSites[MAX_ALLOCATION_SITES];
+/// Null site for allocations when the table is full.
+static VectorAllocationSite overflowSite;
+/// Lock for the allocation statistics.
+static SpinLock allocationSitesLock;
+
+/// Record a buffer allocation.
+static void RecordAllocation(void* address, unsigned size)
+{
+    LockGuard<SpinLock> lock(allocationSitesLock);
+    
+    unsigned index = (unsigned)(((size_t)address >> 2) * 2654435761u) & (MAX_ALLOCATION_SITES - 1);
+    for (unsigned i = 0; i < MAX_ALLOCATION_SITES; ++i)
+    {
+        VectorAllocationSite& site = allocationSites[index];
+        if (!site.address_ || site.address_ == address)
+        {
+            site.address_ = address;
+            ++site.count_;
+            site.bytes_ += size;
+            return;
+        }
+        index = (index + 1) & (MAX_ALLOCATION_SITES - 1);
+    }
+    
+    ++overflowSite.count_;
+    overflowSite.bytes_ += size;
+}
+
+void VectorBase::SetGrowthPercent(unsigned percent)
+{
+    growthPercent = percent ? percent : 1;
+}
+
+void VectorBase::SetAllocationStats(bool enable)
+{
+    allocationStats = enable;
+}
+
+void VectorBase::ResetAllocationStats()
+{
+    LockGuard<SpinLock> lock(allocationSitesLock);
+    
+    memset(allocationSites, 0, sizeof allocationSites);
+    memset(&overflowSite, 0, sizeof overflowSite);
+}
+
+void VectorBase::GetAllocationStats(PODVector<VectorAllocationSite>& dest)
+{
+    // Reserve first, as the destination can not allocate while the lock is held
+    dest.Clear();
+    dest.Reserve(MAX_ALLOCATION_SITES + 1);
+    
+    LockGuard<SpinLock> lock(allocationSitesLock);
+    
+    for (unsigned i = 0; i < MAX_ALLOCATION_SITES; ++i)
+    {
+        if (allocationSites[i].address_)
+            dest.Push(allocationSites[i]);
+    }
+    if (overflowSite.count_)
+        dest.Push(overflowSite);
+}
+
 unsigned char* VectorBase::AllocateBuffer(unsigned size)
 {
+    if (allocationStats)
+        RecordAllocation(RETURN_ADDRESS, size);
+    
     return new unsigned char[size];
 }
 
@@ -28,6 +28,19 @@
 namespace Urho3D
 {
 
+template <class T> class PODVector;
+
+/// Buffer allocation statistics of one code site that grows vectors.
+struct VectorAllocationSite
+{
+    /// Return address of the allocation. Identifies the function that grew the vector when the vector operations are inlined into it.
+    void* address_;
+    /// Number of buffer allocations.
+    unsigned count_;
+    /// Total bytes allocated.
+    unsigned long long bytes_;
+};
+
 /// Random access iterator.
 template <class T> struct RandomAccessIterator
 {
@@ -167,15 +180,49 @@ public:
         Urho3D::Swap(buffer_, rhs.buffer_);
     }
     
+    /// Set how many percent the capacity grows by when a vector runs out of space. Affects all vectors. Default 50.
+    static void SetGrowthPercent(unsigned percent);
+    /// Set whether to count buffer allocations per allocating code site, to find reallocation hot spots. Default false.
+    static void SetAllocationStats(bool enable);
+    /// Clear the allocation statistics.
+    static void ResetAllocationStats();
+    /// Return capacity growth percent.
+    static unsigned GetGrowthPercent() { return growthPercent; }
+    /// Return whether allocation statistics are being collected.
+    static bool GetAllocationStats() { return allocationStats; }
+    /// Return the allocation statistics of each code site, in no particular order.
+    static void GetAllocationStats(PODVector<VectorAllocationSite>& dest);
+    
 protected:
+    /// Allocate a buffer, and record the allocation if statistics are enabled.
     static unsigned char* AllocateBuffer(unsigned size);
     
+    /// Return capacity for a new size according to the growth policy.
+    static unsigned CalculateCapacity(unsigned capacity, unsigned newSize)
+    {
+        if (!capacity)
+            return newSize;
+        
+        while (capacity < newSize)
+        {
+            unsigned growth = (unsigned)(((unsigned long long)capacity * growthPercent + 99) / 100);
+            capacity += growth ? growth : 1;
+        }
+        
+        return capacity;
+    }
+    
     /// Size of vector.
     unsigned size_;
     /// Buffer capacity.
     unsigned capacity_;
     /// Buffer.
     unsigned char* buffer_;
+    
+    /// Capacity growth percent.
+    static unsigned growthPercent;
+    /// Allocation statistics enabled flag.
+    static bool allocationStats;
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include "Precompiled.h"
 #include "Condition.h"
+#include "Mutex.h"
 
 #ifdef WIN32
 #include <windows.h>
@@ -54,6 +55,14 @@ void Condition::Wait()
 {
     WaitForSingleObject((HANDLE)event_, INFINITE);
 }
+
+void Condition::Wait(FastMutex& mutex)
+{
+    // The event stays signaled until a thread wakes up, so a Set() between releasing the mutex and waiting is not lost
+    mutex.Release();
+    WaitForSingleObject((HANDLE)event_, INFINITE);
+    mutex.Acquire();
+}
 #else
 Condition::Condition() :
     mutex_(new pthread_mutex_t),
@@ -90,6 +99,11 @@ void Condition::Wait()
     pthread_cond_wait(cond, mutex);
     pthread_mutex_unlock(mutex);
 }
+
+void Condition::Wait(FastMutex& mutex)
+{
+    pthread_cond_wait((pthread_cond_t*)event_, (pthread_mutex_t*)mutex.handle_);
+}
 #endif
 
 }
@@ -27,6 +27,8 @@
 namespace Urho3D
 {
 
+class FastMutex;
+
 /// %Condition on which a thread can wait.
 class URHO3D_API Condition
 {
@@ -42,6 +44,8 @@ public:
     
     /// Wait on the condition.
     void Wait();
+    /// Wait on the condition while holding a fast mutex, which is released during the wait and reacquired before returning. Setting the condition while holding the same mutex ensures the wakeup can not be missed between checking a predicate and waiting, but the predicate should be rechecked after waking. Do not mix with the mutexless wait on the same condition.
+    void Wait(FastMutex& mutex);
     
 private:
     #ifndef WIN32
@@ -193,6 +193,12 @@ Object* Context::GetEventSender() const
         return 0;
 }
 
+ObjectFactory* Context::GetObjectFactory(StringHash objectType) const
+{
+    HashMap<StringHash, SharedPtr<ObjectFactory> >::ConstIterator i = factories_.Find(objectType);
+    return i != factories_.End() ? i->second_.Get() : 0;
+}
+
 const String& Context::GetTypeName(StringHash objectType) const
 {
     // Search factories to find the hash-to-name mapping
@@ -27,6 +27,11 @@
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
 #endif
 
 #include "DebugNew.h"
@@ -34,6 +39,31 @@
 namespace Urho3D
 {
 
+/// Spin count of critical sections used as fast mutexes.
+static const unsigned FAST_MUTEX_SPIN_COUNT = 4000;
+/// Maximum number of pause instructions between spin lock acquire attempts before yielding instead.
+static const unsigned MAX_SPIN_BACKOFF = 64;
+
+/// Hint the CPU that the thread is spin waiting.
+static inline void CpuPause()
+{
+    #if defined(WIN32)
+    YieldProcessor();
+    #elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+    #endif
+}
+
+/// Give the rest of the thread's time slice to other threads.
+static inline void YieldThread()
+{
+    #ifdef WIN32
+    SwitchToThread();
+    #else
+    sched_yield();
+    #endif
+}
+
 #ifdef WIN32
 Mutex::Mutex() :
     handle_(new CRITICAL_SECTION)
@@ -99,4 +129,221 @@ MutexLock::~MutexLock()
     mutex_.Release();
 }
 
+#ifdef WIN32
+FastMutex::FastMutex() :
+    handle_(new CRITICAL_SECTION)
+{
+    InitializeCriticalSectionAndSpinCount((CRITICAL_SECTION*)handle_, FAST_MUTEX_SPIN_COUNT);
+}
+
+FastMutex::~FastMutex()
+{
+    CRITICAL_SECTION* cs = (CRITICAL_SECTION*)handle_;
+    DeleteCriticalSection(cs);
+    delete cs;
+    handle_ = 0;
+}
+
+void FastMutex::Acquire()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)handle_);
+}
+
+bool FastMutex::TryAcquire()
+{
+    return TryEnterCriticalSection((CRITICAL_SECTION*)handle_) != FALSE;
+}
+
+void FastMutex::Release()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)handle_);
+}
+#else
+FastMutex::FastMutex() :
+    handle_(new pthread_mutex_t)
+{
+    pthread_mutex_init((pthread_mutex_t*)handle_, 0);
+}
+
+FastMutex::~FastMutex()
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*)handle_;
+    pthread_mutex_destroy(mutex);
+    delete mutex;
+    handle_ = 0;
+}
+
+void FastMutex::Acquire()
+{
+    pthread_mutex_lock((pthread_mutex_t*)handle_);
+}
+
+bool FastMutex::TryAcquire()
+{
+    return pthread_mutex_trylock((pthread_mutex_t*)handle_) == 0;
+}
+
+void FastMutex::Release()
+{
+    pthread_mutex_unlock((pthread_mutex_t*)handle_);
+}
+#endif
+
+SpinLock::SpinLock() :
+    locked_(0)
+{
+}
+
+void SpinLock::Acquire()
+{
+    unsigned backoff = 1;
+    
+    while (!TryAcquire())
+    {
+        // Wait until the lock looks free before retrying the atomic exchange, to not bounce the cache line between threads
+        while (locked_)
+        {
+            if (backoff <= MAX_SPIN_BACKOFF)
+            {
+                for (unsigned i = 0; i < backoff; ++i)
+                    CpuPause();
+                backoff <<= 1;
+            }
+            else
+                YieldThread();
+        }
+    }
+}
+
+bool SpinLock::TryAcquire()
+{
+    #ifdef _MSC_VER
+    return _InterlockedExchange(reinterpret_cast<volatile long*>(&locked_), 1) == 0;
+    #else
+    return __sync_lock_test_and_set(&locked_, 1) == 0;
+    #endif
+}
+
+void SpinLock::Release()
+{
+    #ifdef _MSC_VER
+    _InterlockedExchange(reinterpret_cast<volatile long*>(&locked_), 0);
+    #else
+    __sync_lock_release(&locked_);
+    #endif
+}
+
+#if defined(WIN32) && _WIN32_WINNT >= 0x0600
+RWLock::RWLock() :
+    handle_(new SRWLOCK)
+{
+    InitializeSRWLock((SRWLOCK*)handle_);
+}
+
+RWLock::~RWLock()
+{
+    delete (SRWLOCK*)handle_;
+    handle_ = 0;
+}
+
+void RWLock::Acquire()
+{
+    AcquireSRWLockExclusive((SRWLOCK*)handle_);
+}
+
+void RWLock::Release()
+{
+    ReleaseSRWLockExclusive((SRWLOCK*)handle_);
+}
+
+void RWLock::AcquireShared()
+{
+    AcquireSRWLockShared((SRWLOCK*)handle_);
+}
+
+void RWLock::ReleaseShared()
+{
+    ReleaseSRWLockShared((SRWLOCK*)handle_);
+}
+#elif defined(WIN32)
+RWLock::RWLock() :
+    handle_(new CRITICAL_SECTION)
+{
+    InitializeCriticalSectionAndSpinCount((CRITICAL_SECTION*)handle_, FAST_MUTEX_SPIN_COUNT);
+}
+
+RWLock::~RWLock()
+{
+    CRITICAL_SECTION* cs = (CRITICAL_SECTION*)handle_;
+    DeleteCriticalSection(cs);
+    delete cs;
+    handle_ = 0;
+}
+
+void RWLock::Acquire()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)handle_);
+}
+
+void RWLock::Release()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)handle_);
+}
+
+void RWLock::AcquireShared()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)handle_);
+}
+
+void RWLock::ReleaseShared()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)handle_);
+}
+#else
+RWLock::RWLock() :
+    handle_(new pthread_rwlock_t)
+{
+    pthread_rwlock_init((pthread_rwlock_t*)handle_, 0);
+}
+
+RWLock::~RWLock()
+{
+    pthread_rwlock_t* lock = (pthread_rwlock_t*)handle_;
+    pthread_rwlock_destroy(lock);
+    delete lock;
+    handle_ = 0;
+}
+
+void RWLock::Acquire()
+{
+    pthread_rwlock_wrlock((pthread_rwlock_t*)handle_);
+}
+
+void RWLock::Release()
+{
+    pthread_rwlock_unlock((pthread_rwlock_t*)handle_);
+}
+
+void RWLock::AcquireShared()
+{
+    pthread_rwlock_rdlock((pthread_rwlock_t*)handle_);
+}
+
+void RWLock::ReleaseShared()
+{
+    pthread_rwlock_unlock((pthread_rwlock_t*)handle_);
+}
+#endif
+
+ReadLock::ReadLock(RWLock& lock) :
+    lock_(lock)
+{
+    lock_.AcquireShared();
+}
+
+ReadLock::~ReadLock()
+{
+    lock_.ReleaseShared();
+}
+
 }
@@ -65,4 +65,130 @@ private:
     Mutex& mutex_;
 };
 
+/// Non-recursive operating system mutual exclusion primitive. Cheaper than Mutex, but acquiring it again from the thread that holds it deadlocks. On Windows it is a critical section with a spin count, which does not detect recursion.
+class URHO3D_API FastMutex
+{
+    friend class Condition;
+    
+public:
+    /// Construct.
+    FastMutex();
+    /// Destruct.
+    ~FastMutex();
+    
+    /// Acquire the mutex. Block if already acquired.
+    void Acquire();
+    /// Try to acquire the mutex without blocking. Return true if successful.
+    bool TryAcquire();
+    /// Release the mutex.
+    void Release();
+    
+private:
+    /// Prevent copy construction.
+    FastMutex(const FastMutex& rhs);
+    /// Prevent assignment.
+    FastMutex& operator = (const FastMutex& rhs);
+    
+    /// Mutex handle.
+    void* handle_;
+};
+
+/// Adaptive spin lock for very short critical sections. Spins with increasing backoff, then yields the thread's time slice while waiting. Not recursive.
+class URHO3D_API SpinLock
+{
+public:
+    /// Construct.
+    SpinLock();
+    
+    /// Acquire the lock. Spin and then yield if already acquired.
+    void Acquire();
+    /// Try to acquire the lock without waiting. Return true if successful.
+    bool TryAcquire();
+    /// Release the lock.
+    void Release();
+    
+private:
+    /// Prevent copy construction.
+    SpinLock(const SpinLock& rhs);
+    /// Prevent assignment.
+    SpinLock& operator = (const SpinLock& rhs);
+    
+    /// Locked flag.
+    volatile int locked_;
+};
+
+/// Reader-writer lock which allows either multiple readers or a single writer. Not recursive. On Windows versions before Vista readers also exclude each other.
+class URHO3D_API RWLock
+{
+public:
+    /// Construct.
+    RWLock();
+    /// Destruct.
+    ~RWLock();
+    
+    /// Acquire for writing. Block if any readers or a writer hold the lock.
+    void Acquire();
+    /// Release after writing.
+    void Release();
+    /// Acquire for reading. Block if a writer holds the lock.
+    void AcquireShared();
+    /// Release after reading.
+    void ReleaseShared();
+    
+private:
+    /// Prevent copy construction.
+    RWLock(const RWLock& rhs);
+    /// Prevent assignment.
+    RWLock& operator = (const RWLock& rhs);
+    
+    /// Lock handle.
+    void* handle_;
+};
+
+/// Lock that automatically acquires and releases a FastMutex, SpinLock or RWLock (for writing.)
+template <class T> class LockGuard
+{
+public:
+    /// Construct and acquire the lock.
+    LockGuard(T& lock) :
+        lock_(lock)
+    {
+        lock_.Acquire();
+    }
+    
+    /// Destruct. Release the lock.
+    ~LockGuard()
+    {
+        lock_.Release();
+    }
+    
+private:
+    /// Prevent copy construction.
+    LockGuard(const LockGuard<T>& rhs);
+    /// Prevent assignment.
+    LockGuard<T>& operator = (const LockGuard<T>& rhs);
+    
+    /// Lock reference.
+    T& lock_;
+};
+
+/// Lock that automatically acquires and releases a reader-writer lock for reading.
+class URHO3D_API ReadLock
+{
+public:
+    /// Construct and acquire the lock for reading.
+    ReadLock(RWLock& lock);
+    /// Destruct. Release the lock.
+    ~ReadLock();
+    
+private:
+    /// Prevent copy construction.
+    ReadLock(const ReadLock& rhs);
+    /// Prevent assignment.
+    ReadLock& operator = (const ReadLock& rhs);
+    
+    /// Lock reference.
+    RWLock& lock_;
+};
+
 }
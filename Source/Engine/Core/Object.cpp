@@ -21,6 +21,7 @@
 //
 
 #include "Precompiled.h"
+#include "Allocator.h"
 #include "Context.h"
 #include "Log.h"
 #include "Thread.h"
@@ -31,7 +32,8 @@ namespace Urho3D
 {
 
 Object::Object(Context* context) :
-    context_(context)
+    context_(context),
+    poolFactory_(0)
 {
     assert(context_);
 }
@@ -372,6 +374,21 @@ const String& Object::GetCategory() const
     return String::EMPTY;
 }
 
+void Object::Destroy()
+{
+    ObjectFactory* factory = poolFactory_;
+    if (!factory)
+    {
+        delete this;
+        return;
+    }
+    
+    // Destruct in place and return the memory to the pool. The factory stays alive while it has pooled objects
+    void* memory = reinterpret_cast<unsigned char*>(this) - factory->poolOffset_;
+    this->~Object();
+    factory->FreePoolMemory(memory);
+}
+
 EventHandler* Object::FindEventHandler(StringHash eventType, EventHandler** previous) const
 {
     EventHandler* handler = eventHandlers_.First();
@@ -447,4 +464,101 @@ void Object::RemoveEventSender(Object* sender)
     }
 }
 
+ObjectFactory::~ObjectFactory()
+{
+    AllocatorUninitialize(pool_);
+}
+
+void ObjectFactory::SetPooling(bool enable, unsigned initialCapacity)
+{
+    if (enable && !objectSize_)
+    {
+        LOGERROR("Object factory for " + typeName_ + " does not support pooling");
+        return;
+    }
+    
+    LockGuard<SpinLock> lock(poolLock_);
+    
+    pooling_ = enable;
+    if (enable && !pool_)
+        pool_ = AllocatorInitialize(objectSize_, initialCapacity);
+    else if (!enable && pool_ && !numPooledObjects_)
+    {
+        // If pooled objects are still alive, the memory will be freed once the last of them is destroyed
+        AllocatorUninitialize(pool_);
+        pool_ = 0;
+    }
+}
+
+unsigned ObjectFactory::GetPoolCapacity() const
+{
+    LockGuard<SpinLock> lock(poolLock_);
+    
+    return pool_ ? pool_->capacity_ : 0;
+}
+
+void* ObjectFactory::ReservePoolMemory()
+{
+    LockGuard<SpinLock> lock(poolLock_);
+    
+    if (!pooling_ || !pool_)
+        return 0;
+    
+    void* memory = AllocatorReserve(pool_);
+    ++numPoolAllocations_;
+    if (++numPooledObjects_ > maxPooledObjects_)
+        maxPooledObjects_ = numPooledObjects_;
+    
+    return memory;
+}
+
+void ObjectFactory::SetPooledObject(Object* object, void* memory)
+{
+    object->poolFactory_ = this;
+    poolOffset_ = (unsigned)(reinterpret_cast<unsigned char*>(object) - static_cast<unsigned char*>(memory));
+}
+
+void ObjectFactory::FreePoolMemory(void* memory)
+{
+    bool destroy = false;
+    
+    {
+        LockGuard<SpinLock> lock(poolLock_);
+        
+        AllocatorFree(pool_, memory);
+        --numPooledObjects_;
+        
+        if (!numPooledObjects_)
+        {
+            if (!pooling_)
+            {
+                AllocatorUninitialize(pool_);
+                pool_ = 0;
+            }
+            destroy = destroyPending_;
+        }
+    }
+    
+    // Delete only after the lock has been released, as the lock is part of the factory
+    if (destroy)
+        delete this;
+}
+
+void ObjectFactory::Destroy()
+{
+    // Pooled objects do not hold references to the factory, as they may be destroyed in worker threads and the reference
+    // count is not atomic by default. Instead the factory waits for them to be destroyed before deleting itself
+    {
+        LockGuard<SpinLock> lock(poolLock_);
+        
+        if (numPooledObjects_)
+        {
+            destroyPending_ = true;
+            return;
+        }
+    }
+    
+    delete this;
+}
+
 }
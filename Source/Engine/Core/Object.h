@@ -23,13 +23,18 @@
 #pragma once
 
 #include "LinkedList.h"
+#include "Mutex.h"
 #include "Variant.h"
 
+#include <new>
+
 namespace Urho3D
 {
 
+struct AllocatorBlock;
 class Context;
 class EventHandler;
+class ObjectFactory;
 
 #define OBJECT(typeName) \
     public: \
@@ -49,6 +54,7 @@ class URHO3D_API Object : public RefCounted
     BASEOBJECT(Object);
     
     friend class Context;
+    friend class ObjectFactory;
     
 public:
     /// Construct.
@@ -106,6 +112,9 @@ public:
     const String& GetCategory() const;
     
 protected:
+    /// Destroy self when the reference count reaches zero. Return the memory to the factory's pool if pooled.
+    virtual void Destroy();
+    
     /// Execution context.
     Context* context_;
     
@@ -121,6 +130,8 @@ private:
     
     /// Event handlers. Sender is null for non-specific handlers.
     LinkedList<EventHandler> eventHandlers_;
+    /// Factory whose pool holds the object's memory. Null if allocated from the heap.
+    ObjectFactory* poolFactory_;
 };
 
 template <class T> T* Object::GetSubsystem() const { return static_cast<T*>(GetSubsystem(T::GetTypeStatic())); }
@@ -128,17 +139,33 @@ template <class T> T* Object::GetSubsystem() const { return static_cast<T*>(GetS
 /// Base class for object factories.
 class URHO3D_API ObjectFactory : public RefCounted
 {
+    friend class Object;
+    
 public:
     /// Construct.
     ObjectFactory(Context* context) :
-        context_(context)
+        context_(context),
+        objectSize_(0),
+        pool_(0),
+        poolOffset_(0),
+        pooling_(false),
+        numPoolAllocations_(0),
+        numPooledObjects_(0),
+        maxPooledObjects_(0),
+        destroyPending_(false)
     {
         assert(context_);
     }
     
+    /// Destruct. Free the pool memory.
+    virtual ~ObjectFactory();
+    
     /// Create an object. Implemented in templated subclasses.
     virtual SharedPtr<Object> CreateObject() = 0;
     
+    /// Set whether to allocate objects from a pool of recycled memory instead of the heap, and the initial pool capacity in objects. Objects must not be deleted other than through reference counting while pooling is enabled.
+    void SetPooling(bool enable, unsigned initialCapacity = 16);
+    
     /// Return execution context.
     Context* GetContext() const { return context_; }
     /// Return type hash of objects created by this factory.
@@ -147,8 +174,25 @@ public:
     StringHash GetBaseType() const { return baseType_; }
     /// Return type name of objects created by this factory.
     const String& GetTypeName() const { return typeName_; }
+    /// Return whether objects are allocated from a pool.
+    bool IsPooling() const { return pooling_; }
+    /// Return how many objects the pool can hold without allocating more memory.
+    unsigned GetPoolCapacity() const;
+    /// Return total number of objects allocated from the pool.
+    unsigned GetNumPoolAllocations() const { return numPoolAllocations_; }
+    /// Return number of pooled objects currently alive.
+    unsigned GetNumPooledObjects() const { return numPooledObjects_; }
+    /// Return highest number of pooled objects alive at the same time.
+    unsigned GetMaxPooledObjects() const { return maxPooledObjects_; }
     
 protected:
+    /// Reserve memory for a new object from the pool. Return null if pooling is disabled.
+    void* ReservePoolMemory();
+    /// Associate an object constructed into pooled memory with the pool.
+    void SetPooledObject(Object* object, void* memory);
+    /// Delete self when the reference count reaches zero, or defer that until the last pooled object has been destroyed.
+    virtual void Destroy();
+    
     /// Execution context.
     Context* context_;
     /// Object type.
@@ -157,6 +201,29 @@ protected:
     StringHash baseType_;
     /// Object type name.
     String typeName_;
+    /// Object size in bytes.
+    unsigned objectSize_;
+    
+private:
+    /// Return the memory of a destroyed pooled object to the pool.
+    void FreePoolMemory(void* memory);
+    
+    /// Pool memory.
+    AllocatorBlock* pool_;
+    /// Lock for pool access, as objects may be created and destroyed in worker threads.
+    mutable SpinLock poolLock_;
+    /// Offset of the Object base from the start of the pooled memory.
+    unsigned poolOffset_;
+    /// Pooling enabled flag.
+    bool pooling_;
+    /// Total number of pool allocations.
+    unsigned numPoolAllocations_;
+    /// Number of pooled objects alive.
+    unsigned numPooledObjects_;
+    /// Highest number of pooled objects alive.
+    unsigned maxPooledObjects_;
+    /// Reference count reached zero while pooled objects were alive flag. The last of them deletes the factory.
+    bool destroyPending_;
 };
 
 /// Template implementation of the object factory.
@@ -170,10 +237,20 @@ public:
         type_ = T::GetTypeStatic();
         baseType_ = T::GetBaseTypeStatic();
         typeName_ = T::GetTypeNameStatic();
+        objectSize_ = sizeof(T);
     }
     
     /// Create an object of the specific type.
-    virtual SharedPtr<Object>(CreateObject()) { return SharedPtr<Object>(new T(context_)); }
+    virtual SharedPtr<Object>(CreateObject())
+    {
+        void* memory = IsPooling() ? ReservePoolMemory() : 0;
+        if (!memory)
+            return SharedPtr<Object>(new T(context_));
+        
+        T* newObject = new(memory) T(context_);
+        SetPooledObject(newObject, memory);
+        return SharedPtr<Object>(newObject);
+    }
 };
 
 /// Internal helper class for invoking event handler functions.
@@ -265,8 +342,8 @@ private:
     HandlerFunctionPtr function_;
 };
 
-#define EVENT(eventID, eventName) static const Urho3D::StringHash eventID(#eventName); namespace eventName
-#define PARAM(paramID, paramName) static const Urho3D::StringHash paramID(#paramName)
+#define EVENT(eventID, eventName) static STRINGHASH_CONSTANT(eventID, #eventName); namespace eventName
+#define PARAM(paramID, paramName) static STRINGHASH_CONSTANT(paramID, #paramName)
 #define HANDLER(className, function) (new Urho3D::EventHandlerImpl<className>(this, &className::function))
 #define HANDLER_USERDATA(className, function, userData) (new Urho3D::EventHandlerImpl<className>(this, &className::function, userData))
 
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "Sort.h"
+#include "Thread.h"
+#include "WorkQueue.h"
+
+namespace Urho3D
+{
+
+/// Arrays shorter than this are sorted on the calling thread, as splitting them into work items costs more than it saves.
+static const int PARALLEL_SORT_THRESHOLD = 16384;
+
+/// Parallel sort merge task.
+template <class T, class U> struct ParallelMergeTask
+{
+    /// Start of the first sorted range.
+    T* first_;
+    /// End of the first and start of the second sorted range.
+    T* middle_;
+    /// End of the second sorted range.
+    T* last_;
+    /// Destination to merge to.
+    T* dest_;
+    /// Compare function.
+    U* compare_;
+};
+
+/// Parallel sort work function. Sorts one chunk of the array.
+template <class T, class U> void ParallelSortWork(const WorkItem* item, unsigned threadIndex)
+{
+    Sort(RandomAccessIterator<T>(reinterpret_cast<T*>(item->start_)), RandomAccessIterator<T>(reinterpret_cast<T*>(item->end_)),
+        *reinterpret_cast<U*>(item->aux_));
+}
+
+/// Parallel sort work function. Merges two sorted chunks.
+template <class T, class U> void ParallelMergeWork(const WorkItem* item, unsigned threadIndex)
+{
+    const ParallelMergeTask<T, U>* task = reinterpret_cast<const ParallelMergeTask<T, U>*>(item->start_);
+    MergeSorted(RandomAccessIterator<T>(task->first_), RandomAccessIterator<T>(task->middle_), RandomAccessIterator<T>(task->last_),
+        RandomAccessIterator<T>(task->dest_), *task->compare_);
+}
+
+/// Sort in ascending order using a compare function and the worker threads. The array is split into one chunk per thread, the chunks are sorted with Sort(), and then merged pairwise in rounds, which keeps chunks of equal elements in order but is not stable overall. Falls back to Sort() for short arrays, if there are no worker threads, or if not called from the main thread. The compare function is called from several threads at once.
+template <class T, class U> void ParallelSort(WorkQueue* queue, RandomAccessIterator<T> begin, RandomAccessIterator<T> end, U compare)
+{
+    int size = end - begin;
+    unsigned numThreads = queue ? queue->GetNumThreads() + 1 : 1;
+    if (size < PARALLEL_SORT_THRESHOLD || numThreads < 2 || !Thread::IsMainThread())
+    {
+        Sort(begin, end, compare);
+        return;
+    }
+    
+    // Use a power of two number of chunks, at least one per thread, so that each merge round halves the chunk count
+    int numChunks = 1;
+    while ((unsigned)numChunks < numThreads && size / (numChunks * 2) >= PARALLEL_SORT_THRESHOLD / 2)
+        numChunks *= 2;
+    
+    T* data = &(*begin);
+    PODVector<int> bounds(numChunks + 1);
+    for (int i = 0; i <= numChunks; ++i)
+        bounds[i] = (int)((long long)size * i / numChunks);
+    
+    for (int i = 0; i < numChunks; ++i)
+    {
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = ParallelSortWork<T, U>;
+        item->start_ = data + bounds[i];
+        item->end_ = data + bounds[i + 1];
+        item->aux_ = &compare;
+        queue->AddWorkItem(item);
+    }
+    queue->Complete(M_MAX_UNSIGNED);
+    
+    // Merge pairs of chunks in rounds, alternating between the array and the buffer
+    Vector<T> buffer(size);
+    T* src = data;
+    T* dest = &buffer[0];
+    PODVector<ParallelMergeTask<T, U> > tasks(numChunks / 2);
+    
+    for (int step = 1; step < numChunks; step *= 2)
+    {
+        unsigned numTasks = 0;
+        for (int i = 0; i < numChunks; i += step * 2)
+        {
+            ParallelMergeTask<T, U>& task = tasks[numTasks++];
+            task.first_ = src + bounds[i];
+            task.middle_ = src + bounds[i + step];
+            task.last_ = src + bounds[i + step * 2];
+            task.dest_ = dest + bounds[i];
+            task.compare_ = &compare;
+            
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = ParallelMergeWork<T, U>;
+            item->start_ = &task;
+            queue->AddWorkItem(item);
+        }
+        queue->Complete(M_MAX_UNSIGNED);
+        Swap(src, dest);
+    }
+    
+    if (src != data)
+    {
+        for (int i = 0; i < size; ++i)
+            data[i] = src[i];
+    }
+}
+
+/// Sort in ascending order using the worker threads.
+template <class T> void ParallelSort(WorkQueue* queue, RandomAccessIterator<T> begin, RandomAccessIterator<T> end)
+{
+    ParallelSort(queue, begin, end, SortLess<T>());
+}
+
+}
@@ -28,6 +28,11 @@
 #include <cstdio>
 #include <fcntl.h>
 
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
 #ifdef __APPLE__
 #include "TargetConditionals.h"
 #endif
@@ -102,6 +107,72 @@ void GetCPUData(struct cpu_id_t* data)
 }
 #endif
 
+#ifdef __linux__
+/// Read an unsigned value from a /sys file. Return false if could not be read.
+static bool ReadSysValue(const char* path, unsigned& value)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+    bool success = fscanf(file, "%u", &value) == 1;
+    fclose(file);
+    return success;
+}
+
+/// Read the logical CPU topology from /sys. Return false if not available.
+static bool GetSysCPUTopology(PODVector<CPUTopologyInfo>& dest)
+{
+    dest.Clear();
+    
+    long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+    PODVector<Pair<unsigned, unsigned> > coreKeys;
+    char path[256];
+    
+    for (unsigned i = 0; i < (unsigned)numCPUs; ++i)
+    {
+        // CPU 0 usually has no online file, as it can not be taken offline
+        unsigned online = 1;
+        sprintf(path, "/sys/devices/system/cpu/cpu%u/online", i);
+        ReadSysValue(path, online);
+        if (!online)
+            continue;
+        
+        CPUTopologyInfo info;
+        info.cpu_ = i;
+        unsigned coreID;
+        sprintf(path, "/sys/devices/system/cpu/cpu%u/topology/core_id", i);
+        if (!ReadSysValue(path, coreID))
+            continue;
+        sprintf(path, "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", i);
+        ReadSysValue(path, info.package_);
+        
+        // Core IDs are only unique within a package and may have gaps, so renumber them
+        Pair<unsigned, unsigned> key = MakePair(info.package_, coreID);
+        PODVector<Pair<unsigned, unsigned> >::Iterator j = coreKeys.Find(key);
+        info.core_ = (unsigned)(j - coreKeys.Begin());
+        if (j == coreKeys.End())
+            coreKeys.Push(key);
+        
+        // The NUMA node is linked from the CPU directory as nodeN
+        sprintf(path, "/sys/devices/system/cpu/cpu%u", i);
+        DIR* dir = opendir(path);
+        if (dir)
+        {
+            while (dirent* de = readdir(dir))
+            {
+                if (!strncmp(de->d_name, "node", 4) && sscanf(de->d_name + 4, "%u", &info.node_) == 1)
+                    break;
+            }
+            closedir(dir);
+        }
+        
+        dest.Push(info);
+    }
+    
+    return !dest.Empty();
+}
+#endif
+
 void InitFPU()
 {
     #if !defined(URHO3D_LUAJIT) && !defined(ANDROID) && !defined(IOS) && !defined(RASPI) && !defined(__x86_64__) && !defined(_M_AMD64)
@@ -358,6 +429,21 @@ String GetPlatform()
 
 unsigned GetNumPhysicalCPUs()
 {
+    #if defined(__linux__) && !defined(ANDROID) && !defined(RASPI)
+    // CPUID only describes the package the calling thread runs on, so count the cores of all packages from /sys if possible
+    PODVector<CPUTopologyInfo> topology;
+    if (GetSysCPUTopology(topology))
+    {
+        unsigned numCores = 0;
+        for (unsigned i = 0; i < topology.Size(); ++i)
+        {
+            if (topology[i].core_ >= numCores)
+                numCores = topology[i].core_ + 1;
+        }
+        return numCores;
+    }
+    #endif
+    
     #if defined(IOS)
     host_basic_info_data_t data;
     GetCPUData(&data);
@@ -379,6 +465,12 @@ unsigned GetNumPhysicalCPUs()
 
 unsigned GetNumLogicalCPUs()
 {
+    #if defined(__linux__) && !defined(ANDROID) && !defined(RASPI)
+    PODVector<CPUTopologyInfo> topology;
+    if (GetSysCPUTopology(topology))
+        return topology.Size();
+    #endif
+    
     #if defined(IOS)
     host_basic_info_data_t data;
     GetCPUData(&data);
@@ -397,4 +489,36 @@ unsigned GetNumLogicalCPUs()
     #endif
 }
 
+void GetCPUTopology(PODVector<CPUTopologyInfo>& dest)
+{
+    #ifdef __linux__
+    if (GetSysCPUTopology(dest))
+        return;
+    #endif
+    
+    unsigned numLogical = GetNumLogicalCPUs();
+    unsigned numPhysical = GetNumPhysicalCPUs();
+    unsigned cpusPerCore = numPhysical && numLogical > numPhysical ? numLogical / numPhysical : 1;
+    
+    dest.Resize(numLogical);
+    for (unsigned i = 0; i < numLogical; ++i)
+    {
+        dest[i] = CPUTopologyInfo();
+        dest[i].cpu_ = i;
+        dest[i].core_ = i / cpusPerCore;
+    }
+}
+
+unsigned GetCurrentCPU()
+{
+    #if defined(__linux__) && !defined(ANDROID)
+    int cpu = sched_getcpu();
+    return cpu >= 0 ? (unsigned)cpu : 0;
+    #elif defined(WIN32) && _WIN32_WINNT >= 0x0600
+    return GetCurrentProcessorNumber();
+    #else
+    return 0;
+    #endif
+}
+
 }
@@ -31,6 +31,28 @@ namespace Urho3D
 
 class Mutex;
 
+/// Location of a logical CPU in the processor topology.
+struct CPUTopologyInfo
+{
+    /// Construct.
+    CPUTopologyInfo() :
+        cpu_(0),
+        core_(0),
+        package_(0),
+        node_(0)
+    {
+    }
+    
+    /// Operating system index of the logical CPU.
+    unsigned cpu_;
+    /// Physical core index, unique across all packages.
+    unsigned core_;
+    /// Processor package (socket) index.
+    unsigned package_;
+    /// NUMA node index.
+    unsigned node_;
+};
+
 /// Initialize the FPU to round-to-nearest, single precision mode.
 URHO3D_API void InitFPU();
 /// Display an error dialog with the specified title and message.
@@ -65,5 +87,9 @@ URHO3D_API String GetPlatform();
 URHO3D_API unsigned GetNumPhysicalCPUs();
 /// Return the number of logical CPUs (different from physical if hyperthreading is used.)
 URHO3D_API unsigned GetNumLogicalCPUs();
+/// Return the topology of the online logical CPUs, ordered by CPU index. Read from /sys on Linux, otherwise estimated assuming a single package with the hyperthreads of each core numbered consecutively.
+URHO3D_API void GetCPUTopology(PODVector<CPUTopologyInfo>& dest);
+/// Return the logical CPU the calling thread is currently running on, or 0 if unknown.
+URHO3D_API unsigned GetCurrentCPU();
 
 }
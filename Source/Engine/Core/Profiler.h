@@ -203,6 +203,19 @@ public:
         }
     }
     
+    /// Add time measured elsewhere, for example by a work item in a worker thread, to a child block of the current block as one call.
+    void AddBlockTime(const char* name, long long time)
+    {
+        if (!Thread::IsMainThread())
+            return;
+        
+        ProfilerBlock* block = current_->GetChild(name);
+        ++block->count_;
+        block->time_ += time;
+        if (time > block->maxTime_)
+            block->maxTime_ = time;
+    }
+    
     /// Begin the profiling frame. Called by HandleBeginFrame().
     void BeginFrame();
     /// End the profiling frame. Called by HandleEndFrame().
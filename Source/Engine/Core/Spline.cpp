@@ -135,23 +135,26 @@ Variant Spline::BezierInterpolation(const Vector<Variant>& knots, float t) const
     }
     else
     {
-        Vector<Variant> interpolatedKnots;
-        for (unsigned i = 1; i < knots.Size(); i++)
+        switch (knots[0].GetType())
+        {
+        case VAR_FLOAT:
+        case VAR_VECTOR2:
+        case VAR_VECTOR3:
+        case VAR_VECTOR4:
+        case VAR_COLOR:
+            break;
+        default:
+            return Variant::EMPTY;
+        }
+
+        // De Casteljau's algorithm, interpolating in place on a single copy of the knots
+        Vector<Variant> interpolatedKnots(knots);
+        for (unsigned n = interpolatedKnots.Size() - 1; n > 0; --n)
         {
-            switch (knots[0].GetType())
-            {
-            case VAR_FLOAT:
-            case VAR_VECTOR2:
-            case VAR_VECTOR3:
-            case VAR_VECTOR4:
-            case VAR_COLOR:
-                interpolatedKnots.Push(LinearInterpolation(knots[i - 1], knots[i], t));
-                break;
-            default:
-                return Variant::EMPTY;
-            }
+            for (unsigned i = 0; i < n; ++i)
+                interpolatedKnots[i] = LinearInterpolation(interpolatedKnots[i], interpolatedKnots[i + 1], t);
         }
-        return BezierInterpolation(interpolatedKnots, t);
+        return interpolatedKnots[0];
     }
 }
 
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Precompiled.h"
+#include "ProcessUtils.h"
+#include "StringHashRegister.h"
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+StringHashRegister::StringHashRegister() :
+    numCollisions_(0)
+{
+}
+
+bool StringHashRegister::RegisterString(const StringHash& hash, const char* str)
+{
+    if (!hash || !str)
+        return true;
+    
+    LockGuard<RWLock> lock(lock_);
+    
+    HashMap<StringHash, String>::Iterator i = map_.Find(hash);
+    if (i == map_.End())
+    {
+        map_[hash] = str;
+        return true;
+    }
+    
+    // Hashing is case-insensitive, so only a case-insensitive mismatch is a collision
+    if (i->second_.Compare(str, false) != 0)
+    {
+        ++numCollisions_;
+        // May be called during static initialization before the Log subsystem exists, so print directly
+        PrintLine("StringHash collision detected: " + i->second_ + " and " + String(str) + " both hash to " + hash.ToString(),
+            true);
+        return false;
+    }
+    
+    return true;
+}
+
+String StringHashRegister::GetString(const StringHash& hash) const
+{
+    ReadLock lock(lock_);
+    
+    HashMap<StringHash, String>::ConstIterator i = map_.Find(hash);
+    return i != map_.End() ? i->second_ : String::EMPTY;
+}
+
+bool StringHashRegister::Contains(const StringHash& hash) const
+{
+    ReadLock lock(lock_);
+    return map_.Contains(hash);
+}
+
+unsigned StringHashRegister::GetNumStrings() const
+{
+    ReadLock lock(lock_);
+    return map_.Size();
+}
+
+}
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "HashMap.h"
+#include "Mutex.h"
+#include "StringHash.h"
+
+namespace Urho3D
+{
+
+/// Registry of hashed strings for reverse lookup and hash collision detection. Enabled with the URHO3D_HASH_DEBUG build option.
+class URHO3D_API StringHashRegister
+{
+public:
+    /// Construct.
+    StringHashRegister();
+    
+    /// Register a string with its hash. Report an error if a different string is already registered with the same hash, and return false in that case.
+    bool RegisterString(const StringHash& hash, const char* str);
+    /// Return the string registered for a hash, or empty if not found.
+    String GetString(const StringHash& hash) const;
+    /// Return whether a hash has been registered.
+    bool Contains(const StringHash& hash) const;
+    /// Return number of registered strings.
+    unsigned GetNumStrings() const;
+    /// Return number of hash collisions detected so far.
+    unsigned GetNumCollisions() const { return numCollisions_; }
+    
+private:
+    /// Hash to string map.
+    HashMap<StringHash, String> map_;
+    /// Lock for registering and looking up from multiple threads.
+    mutable RWLock lock_;
+    /// Number of collisions detected.
+    unsigned numCollisions_;
+};
+
+}
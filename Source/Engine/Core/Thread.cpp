@@ -38,6 +38,10 @@ namespace Urho3D
 DWORD WINAPI ThreadFunctionStatic(void* data)
 {
     Thread* thread = static_cast<Thread*>(data);
+    if (!thread->GetName().Empty())
+        Thread::SetCurrentThreadName(thread->GetName());
+    if (!thread->GetAffinity().Empty())
+        Thread::SetCurrentThreadAffinity(thread->GetAffinity());
     thread->ThreadFunction();
     return 0;
 }
@@ -45,12 +49,33 @@ DWORD WINAPI ThreadFunctionStatic(void* data)
 void* ThreadFunctionStatic(void* data)
 {
     Thread* thread = static_cast<Thread*>(data);
+    if (!thread->GetName().Empty())
+        Thread::SetCurrentThreadName(thread->GetName());
+    if (!thread->GetAffinity().Empty())
+        Thread::SetCurrentThreadAffinity(thread->GetAffinity());
     thread->ThreadFunction();
     pthread_exit((void*)0);
     return 0;
 }
 #endif
 
+#ifdef _MSC_VER
+#pragma pack(push, 8)
+/// Thread name information for the debugger exception.
+struct ThreadNameInfo
+{
+    /// Must be 0x1000.
+    DWORD type_;
+    /// Thread name.
+    const char* name_;
+    /// Thread ID, or -1 for the calling thread.
+    DWORD threadID_;
+    /// Reserved, must be zero.
+    DWORD flags_;
+};
+#pragma pack(pop)
+#endif
+
 ThreadID Thread::mainThreadID;
 
 Thread::Thread() :
@@ -134,4 +159,55 @@ bool Thread::IsMainThread()
     return GetCurrentThreadID() == mainThreadID;
 }
 
+void Thread::SetCurrentThreadName(const String& name)
+{
+    #if defined(_MSC_VER)
+    // Visual Studio picks up the name from a special exception raised for the debugger
+    ThreadNameInfo info;
+    info.type_ = 0x1000;
+    info.name_ = name.CString();
+    info.threadID_ = (DWORD)-1;
+    info.flags_ = 0;
+    __try
+    {
+        RaiseException(0x406D1388, 0, sizeof(info) / sizeof(ULONG_PTR), (ULONG_PTR*)&info);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER)
+    {
+    }
+    #elif defined(__APPLE__)
+    pthread_setname_np(name.CString());
+    #elif defined(__linux__) && !defined(ANDROID)
+    // The kernel limits thread names to 15 characters
+    pthread_setname_np(pthread_self(), name.Substring(0, 15).CString());
+    #endif
+}
+
+bool Thread::SetCurrentThreadAffinity(const PODVector<unsigned>& cpus)
+{
+    if (cpus.Empty())
+        return false;
+    
+    #if defined(WIN32)
+    DWORD_PTR mask = 0;
+    for (unsigned i = 0; i < cpus.Size(); ++i)
+    {
+        if (cpus[i] < sizeof(DWORD_PTR) * 8)
+            mask |= (DWORD_PTR)1 << cpus[i];
+    }
+    return mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+    #elif defined(__linux__) && !defined(ANDROID)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned i = 0; i < cpus.Size(); ++i)
+    {
+        if (cpus[i] < CPU_SETSIZE)
+            CPU_SET(cpus[i], &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #else
+    return false;
+    #endif
+}
+
 }
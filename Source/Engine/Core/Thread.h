@@ -22,7 +22,7 @@
 
 #pragma once
 
-#include "Urho3D.h"
+#include "Str.h"
 
 #ifndef WIN32
 #include <pthread.h>
@@ -52,9 +52,17 @@ public:
     void Stop();
     /// Set thread priority. The thread must have been started first.
     void SetPriority(int priority);
+    /// Set thread name shown in debuggers and profilers. Takes effect when the thread is started.
+    void SetName(const String& name) { name_ = name; }
+    /// Set the logical CPUs the thread may run on, or empty to not restrict. Takes effect when the thread is started.
+    void SetAffinity(const PODVector<unsigned>& cpus) { affinity_ = cpus; }
     
     /// Return whether thread exists.
     bool IsStarted() const { return handle_ != 0; }
+    /// Return thread name.
+    const String& GetName() const { return name_; }
+    /// Return the logical CPUs the thread may run on.
+    const PODVector<unsigned>& GetAffinity() const { return affinity_; }
 
     /// Set the current thread as the main thread.
     static void SetMainThread();
@@ -62,12 +70,20 @@ public:
     static ThreadID GetCurrentThreadID();
     /// Return whether is executing in the main thread.
     static bool IsMainThread();
+    /// Set the current thread's name. On Linux names longer than 15 characters are truncated. Not supported on Windows when compiled with MinGW.
+    static void SetCurrentThreadName(const String& name);
+    /// Restrict the current thread to run on the given logical CPUs. Return true if successful. Not supported on Apple platforms.
+    static bool SetCurrentThreadAffinity(const PODVector<unsigned>& cpus);
     
 protected:
     /// Thread handle.
     void* handle_;
     /// Running flag.
     volatile bool shouldRun_;
+    /// Thread name.
+    String name_;
+    /// Logical CPUs to run on.
+    PODVector<unsigned> affinity_;
     
     /// Main thread's thread ID.
     static ThreadID mainThreadID;
@@ -31,7 +31,9 @@
 #include <windows.h>
 #include <mmsystem.h>
 #else
+#include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #endif
 
@@ -154,6 +156,31 @@ void Time::Sleep(unsigned mSec)
     #endif
 }
 
+void Time::SleepUSec(long long uSec)
+{
+    if (uSec <= 0)
+        return;
+    
+    #ifdef WIN32
+    // Windows only supports millisecond sleep granularity (assuming the timer period has been set to 1 ms)
+    ::Sleep((DWORD)(uSec / 1000));
+    #else
+    struct timespec request;
+    request.tv_sec = (time_t)(uSec / 1000000LL);
+    request.tv_nsec = (long)((uSec % 1000000LL) * 1000);
+    #if defined(__linux__) && !defined(ANDROID)
+    // Restart the sleep with the remaining time if interrupted by a signal
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR)
+    {
+    }
+    #else
+    while (nanosleep(&request, &request) == -1 && errno == EINTR)
+    {
+    }
+    #endif
+    #endif
+}
+
 Timer::Timer()
 {
     Reset();
@@ -205,10 +232,15 @@ long long HiresTimer::GetUSec(bool reset)
     }
     else
         currentTime = timeGetTime();
-    #else
+    #elif defined(__APPLE__)
     struct timeval time;
     gettimeofday(&time, NULL);
     currentTime = time.tv_sec * 1000000LL + time.tv_usec;
+    #else
+    // Use the monotonic clock so that system time adjustments do not disturb timing
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    currentTime = time.tv_sec * 1000000LL + time.tv_nsec / 1000;
     #endif
     
     long long elapsedTime = currentTime - startTime_;
@@ -234,10 +266,14 @@ void HiresTimer::Reset()
     }
     else
         startTime_ = timeGetTime();
-    #else
+    #elif defined(__APPLE__)
     struct timeval time;
     gettimeofday(&time, NULL);
     startTime_ = time.tv_sec * 1000000LL + time.tv_usec;
+    #else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    startTime_ = time.tv_sec * 1000000LL + time.tv_nsec / 1000;
     #endif
 }
 
@@ -106,6 +106,8 @@ public:
     static String GetTimeStamp();
     /// Sleep for a number of milliseconds.
     static void Sleep(unsigned mSec);
+    /// Sleep for a number of microseconds. Uses a high-resolution sleep where available, but the actual sleep may still be longer depending on the operating system scheduler.
+    static void SleepUSec(long long uSec);
     
 private:
     /// Elapsed time since program start.
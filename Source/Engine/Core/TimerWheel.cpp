@@ -0,0 +1,285 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Precompiled.h"
+#include "MathDefs.h"
+#include "TimerWheel.h"
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+static const unsigned FIRST_LEVEL_BITS = 8;
+static const unsigned FIRST_LEVEL_SLOTS = 1 << FIRST_LEVEL_BITS;
+static const unsigned LEVEL_BITS = 6;
+static const unsigned LEVEL_SLOTS = 1 << LEVEL_BITS;
+static const unsigned NUM_LEVELS = 4;
+static const unsigned DUE_SLOT = FIRST_LEVEL_SLOTS + (NUM_LEVELS - 1) * LEVEL_SLOTS;
+static const unsigned NUM_SLOTS = DUE_SLOT + 1;
+static const long long MAX_TICKS = 1LL << (FIRST_LEVEL_BITS + (NUM_LEVELS - 1) * LEVEL_BITS);
+
+TimerWheel::TimerWheel(float resolution) :
+    time_(0.0),
+    nextTick_(1),
+    resolution_(Max(resolution, M_EPSILON)),
+    numTimers_(0),
+    numFirstLevelTimers_(0)
+{
+}
+
+unsigned TimerWheel::AddTimer(float delay, float period, bool repeat)
+{
+    // Allocate the slots on first use, as many owners never add timers
+    if (slotHeads_.Empty())
+    {
+        slotHeads_.Resize(NUM_SLOTS);
+        slotTails_.Resize(NUM_SLOTS);
+        for (unsigned i = 0; i < NUM_SLOTS; ++i)
+            slotHeads_[i] = slotTails_[i] = M_MAX_UNSIGNED;
+    }
+
+    unsigned index;
+    if (freeEntries_.Size())
+    {
+        index = freeEntries_.Back();
+        freeEntries_.Pop();
+    }
+    else
+    {
+        index = entries_.Size();
+        entries_.Resize(index + 1);
+    }
+
+    TimerWheelEntry& entry = entries_[index];
+    entry.expiry_ = time_ + Max(delay, 0.0f) / resolution_;
+    entry.period_ = repeat ? Max(period, 0.0f) / resolution_ : 0.0;
+    entry.slot_ = M_MAX_UNSIGNED;
+    entry.repeat_ = repeat;
+    entry.active_ = true;
+    ++numTimers_;
+
+    Insert(index);
+    return index + 1;
+}
+
+bool TimerWheel::RemoveTimer(unsigned handle)
+{
+    if (!HasTimer(handle))
+        return false;
+
+    unsigned index = handle - 1;
+    if (entries_[index].slot_ != M_MAX_UNSIGNED)
+        Unlink(index);
+    entries_[index].active_ = false;
+    --numTimers_;
+    releasedEntries_.Push(index);
+    return true;
+}
+
+void TimerWheel::RemoveAllTimers()
+{
+    for (unsigned i = 0; i < entries_.Size(); ++i)
+    {
+        if (entries_[i].active_)
+            RemoveTimer(i + 1);
+    }
+}
+
+void TimerWheel::Advance(float timeStep, PODVector<unsigned>& fired)
+{
+    fired.Clear();
+
+    // Entries released before this call may be reused from now on
+    freeEntries_.Push(releasedEntries_);
+    releasedEntries_.Clear();
+
+    time_ += Max(timeStep, 0.0f) / resolution_;
+    long long lastTick = (long long)(time_ + 0.5);
+    if (!numTimers_)
+    {
+        nextTick_ = lastTick + 1;
+        return;
+    }
+
+    // Timers that were already due when added or rescheduled fire first
+    while (slotHeads_[DUE_SLOT] != M_MAX_UNSIGNED)
+        Expire(slotHeads_[DUE_SLOT], fired);
+
+    while (nextTick_ <= lastTick)
+    {
+        if (!numTimers_)
+        {
+            nextTick_ = lastTick + 1;
+            break;
+        }
+
+        // If the first level is empty, skip ahead to its next wraparound where the higher levels cascade down
+        if (!numFirstLevelTimers_ && (nextTick_ & (FIRST_LEVEL_SLOTS - 1)))
+        {
+            long long wrapTick = (nextTick_ | (FIRST_LEVEL_SLOTS - 1)) + 1;
+            if (wrapTick > lastTick)
+            {
+                nextTick_ = lastTick + 1;
+                break;
+            }
+            nextTick_ = wrapTick;
+        }
+
+        unsigned slot = (unsigned)(nextTick_ & (FIRST_LEVEL_SLOTS - 1));
+        if (!slot)
+        {
+            for (unsigned level = 1; level < NUM_LEVELS; ++level)
+            {
+                if (Cascade(level))
+                    break;
+            }
+        }
+
+        while (slotHeads_[slot] != M_MAX_UNSIGNED)
+            Expire(slotHeads_[slot], fired);
+
+        ++nextTick_;
+    }
+
+    // Reschedule the fired repeating timers only now, so that they fire at most once per call
+    for (unsigned i = 0; i < firedRepeating_.Size(); ++i)
+    {
+        unsigned index = firedRepeating_[i];
+        entries_[index].expiry_ += entries_[index].period_;
+        Insert(index);
+    }
+    firedRepeating_.Clear();
+}
+
+float TimerWheel::GetRemainingTime(unsigned handle) const
+{
+    if (!HasTimer(handle))
+        return 0.0f;
+
+    return Max((float)((entries_[handle - 1].expiry_ - time_) * resolution_), 0.0f);
+}
+
+void TimerWheel::Insert(unsigned index)
+{
+    long long tick = (long long)(entries_[index].expiry_ + 0.5);
+    long long delta = tick - nextTick_;
+
+    if (delta < 0)
+        Link(index, DUE_SLOT);
+    else if (delta < FIRST_LEVEL_SLOTS)
+        Link(index, (unsigned)(tick & (FIRST_LEVEL_SLOTS - 1)));
+    else
+    {
+        // Timers beyond the range of the wheel wait on the last level and are re-inserted when it cascades
+        if (delta >= MAX_TICKS)
+        {
+            delta = MAX_TICKS - 1;
+            tick = nextTick_ + delta;
+        }
+
+        unsigned level = 1;
+        unsigned shift = FIRST_LEVEL_BITS;
+        while (delta >= (1LL << (shift + LEVEL_BITS)))
+        {
+            ++level;
+            shift += LEVEL_BITS;
+        }
+
+        Link(index, FIRST_LEVEL_SLOTS + (level - 1) * LEVEL_SLOTS + (unsigned)((tick >> shift) & (LEVEL_SLOTS - 1)));
+    }
+}
+
+void TimerWheel::Link(unsigned index, unsigned slot)
+{
+    TimerWheelEntry& entry = entries_[index];
+    entry.slot_ = slot;
+    entry.next_ = M_MAX_UNSIGNED;
+    entry.prev_ = slotTails_[slot];
+
+    if (slotTails_[slot] != M_MAX_UNSIGNED)
+        entries_[slotTails_[slot]].next_ = index;
+    else
+        slotHeads_[slot] = index;
+    slotTails_[slot] = index;
+
+    if (slot < FIRST_LEVEL_SLOTS)
+        ++numFirstLevelTimers_;
+}
+
+void TimerWheel::Unlink(unsigned index)
+{
+    TimerWheelEntry& entry = entries_[index];
+    unsigned slot = entry.slot_;
+
+    if (entry.prev_ != M_MAX_UNSIGNED)
+        entries_[entry.prev_].next_ = entry.next_;
+    else
+        slotHeads_[slot] = entry.next_;
+    if (entry.next_ != M_MAX_UNSIGNED)
+        entries_[entry.next_].prev_ = entry.prev_;
+    else
+        slotTails_[slot] = entry.prev_;
+
+    entry.slot_ = M_MAX_UNSIGNED;
+
+    if (slot < FIRST_LEVEL_SLOTS)
+        --numFirstLevelTimers_;
+}
+
+void TimerWheel::Expire(unsigned index, PODVector<unsigned>& fired)
+{
+    Unlink(index);
+    fired.Push(index + 1);
+
+    TimerWheelEntry& entry = entries_[index];
+    if (entry.repeat_)
+        firedRepeating_.Push(index);
+    else
+    {
+        entry.active_ = false;
+        --numTimers_;
+        releasedEntries_.Push(index);
+    }
+}
+
+unsigned TimerWheel::Cascade(unsigned level)
+{
+    unsigned shift = FIRST_LEVEL_BITS + (level - 1) * LEVEL_BITS;
+    unsigned slotIndex = (unsigned)((nextTick_ >> shift) & (LEVEL_SLOTS - 1));
+    unsigned slot = FIRST_LEVEL_SLOTS + (level - 1) * LEVEL_SLOTS + slotIndex;
+
+    // Detach the whole list first so that the entries can be re-inserted while iterating
+    unsigned index = slotHeads_[slot];
+    slotHeads_[slot] = slotTails_[slot] = M_MAX_UNSIGNED;
+    while (index != M_MAX_UNSIGNED)
+    {
+        unsigned next = entries_[index].next_;
+        Insert(index);
+        index = next;
+    }
+
+    return slotIndex;
+}
+
+}
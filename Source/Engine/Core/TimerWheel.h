@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "Vector.h"
+
+namespace Urho3D
+{
+
+/// Timer wheel entry.
+struct TimerWheelEntry
+{
+    /// Expiration time in ticks.
+    double expiry_;
+    /// Repeat period in ticks.
+    double period_;
+    /// Next entry in the slot list.
+    unsigned next_;
+    /// Previous entry in the slot list.
+    unsigned prev_;
+    /// Slot list the entry is in, or M_MAX_UNSIGNED if none.
+    unsigned slot_;
+    /// Repeat flag.
+    bool repeat_;
+    /// Active flag. Cleared when the timer is removed or a non-repeating timer fires.
+    bool active_;
+};
+
+/// Hierarchical timer wheel for scheduling one-shot and repeating timers. Adding and removing timers is constant time, and advancing time costs in proportion to the fired timers and elapsed ticks rather than the number of pending timers.
+class URHO3D_API TimerWheel
+{
+public:
+    /// Construct with tick length in seconds.
+    TimerWheel(float resolution = 0.001f);
+
+    /// Add a timer and return its handle. A repeating timer fires again each period after the delay, but at most once per Advance() call.
+    unsigned AddTimer(float delay, float period, bool repeat);
+    /// Add a timer that repeats with the same period as its initial delay and return its handle.
+    unsigned AddTimer(float delay, bool repeat) { return AddTimer(delay, delay, repeat); }
+    /// Remove a timer. Return true if it was pending.
+    bool RemoveTimer(unsigned handle);
+    /// Remove all timers.
+    void RemoveAllTimers();
+    /// Advance time and return the handles of the fired timers in firing order. A handle is not reused before the next Advance() call, even if its timer is removed in the meanwhile.
+    void Advance(float timeStep, PODVector<unsigned>& fired);
+
+    /// Return tick length in seconds.
+    float GetResolution() const { return resolution_; }
+    /// Return number of pending timers.
+    unsigned GetNumTimers() const { return numTimers_; }
+    /// Return whether a timer is pending.
+    bool HasTimer(unsigned handle) const { return handle && handle <= entries_.Size() && entries_[handle - 1].active_; }
+    /// Return time in seconds until a timer fires next, or zero if not pending.
+    float GetRemainingTime(unsigned handle) const;
+
+private:
+    /// Insert an entry into the slot matching its expiration time.
+    void Insert(unsigned index);
+    /// Unlink an entry from its slot.
+    void Unlink(unsigned index);
+    /// Link an entry to the end of a slot.
+    void Link(unsigned index, unsigned slot);
+    /// Unlink a fired entry, report it and release it unless it repeats.
+    void Expire(unsigned index, PODVector<unsigned>& fired);
+    /// Move the entries of the current slot on a higher level down. Return the slot index within the level.
+    unsigned Cascade(unsigned level);
+
+    /// Entries. Handles are entry indices plus one.
+    PODVector<TimerWheelEntry> entries_;
+    /// First entry of each slot.
+    PODVector<unsigned> slotHeads_;
+    /// Last entry of each slot.
+    PODVector<unsigned> slotTails_;
+    /// Free entry indices.
+    PODVector<unsigned> freeEntries_;
+    /// Entry indices released since the last Advance() call.
+    PODVector<unsigned> releasedEntries_;
+    /// Repeating timers fired during the current Advance() call.
+    PODVector<unsigned> firedRepeating_;
+    /// Elapsed time in ticks.
+    double time_;
+    /// Next tick to process.
+    long long nextTick_;
+    /// Tick length in seconds.
+    float resolution_;
+    /// Number of pending timers.
+    unsigned numTimers_;
+    /// Number of pending timers on the first level.
+    unsigned numFirstLevelTimers_;
+};
+
+}
@@ -68,8 +68,14 @@ WorkQueue::WorkQueue(Context* context) :
     paused_(false),
     tolerance_(10),
     lastSize_(0),
-    maxNonThreadedWorkMs_(5)
+    maxNonThreadedWorkMs_(5),
+    numReservedCores_(0),
+    threadAffinity_(false),
+    localNodeOnly_(false)
 {
+    busyTime_.Resize(1);
+    busyTime_[0] = 0;
+    
     SubscribeToEvent(E_BEGINFRAME, HANDLER(WorkQueue, HandleBeginFrame));
 }
 
@@ -93,14 +99,43 @@ void WorkQueue::CreateThreads(unsigned numThreads)
     // Start threads in paused mode
     Pause();
     
+    busyTime_.Resize(numThreads + 1);
+    for (unsigned i = 1; i < busyTime_.Size(); ++i)
+        busyTime_[i] = 0;
+    
+    // Place the reserved cores right after the main thread's core, and the worker threads on the remaining cores
+    Vector<PODVector<unsigned> > cores;
+    GetUsableCores(cores);
+    unsigned numReserved = cores.Size() > 1 ? Min((int)numReservedCores_, (int)cores.Size() - 1) : 0;
+    unsigned firstWorkerCore = numReserved + 1;
+    unsigned numWorkerCores = cores.Size() - firstWorkerCore;
+    
+    reservedCPUs_.Clear();
+    if (threadAffinity_ && cores.Size() > 1)
+    {
+        Thread::SetCurrentThreadAffinity(cores[0]);
+        for (unsigned i = 1; i < firstWorkerCore; ++i)
+            reservedCPUs_.Push(cores[i]);
+    }
+    
     for (unsigned i = 0; i < numThreads; ++i)
     {
         SharedPtr<WorkerThread> thread(new WorkerThread(this, i + 1));
+        thread->SetName("Worker " + String(i + 1));
+        if (threadAffinity_ && numWorkerCores)
+            thread->SetAffinity(cores[firstWorkerCore + i % numWorkerCores]);
         thread->Run();
         threads_.Push(thread);
     }
 }
 
+unsigned WorkQueue::GetDefaultNumThreads() const
+{
+    Vector<PODVector<unsigned> > cores;
+    GetUsableCores(cores);
+    return cores.Size() > numReservedCores_ + 1 ? cores.Size() - numReservedCores_ - 1 : 0;
+}
+
 SharedPtr<WorkItem> WorkQueue::GetFreeItem()
 {
     if (poolItems_.Size() > 0)
@@ -198,7 +233,9 @@ void WorkQueue::Complete(unsigned priority)
                 WorkItem* item = queue_.Front();
                 queue_.PopFront();
                 queueMutex_.Release();
+                HiresTimer timer;
                 item->workFunction_(item, 0);
+                busyTime_[0] += timer.GetUSec(false);
                 item->completed_ = true;
             }
             else
@@ -224,7 +261,9 @@ void WorkQueue::Complete(unsigned priority)
         {
             WorkItem* item = queue_.Front();
             queue_.PopFront();
+            HiresTimer timer;
             item->workFunction_(item, 0);
+            busyTime_[0] += timer.GetUSec(false);
             item->completed_ = true;
         }
     }
@@ -243,9 +282,77 @@ bool WorkQueue::IsCompleted(unsigned priority) const
     return true;
 }
 
+long long WorkQueue::GetBusyTime(unsigned threadIndex)
+{
+    if (threadIndex >= busyTime_.Size())
+        return 0;
+    
+    // When paused, the main thread already holds the queue mutex and the worker threads can not update their times
+    if (!threadIndex || paused_)
+        return busyTime_[threadIndex];
+    
+    LockGuard<FastMutex> lock(queueMutex_);
+    return busyTime_[threadIndex];
+}
+
+void WorkQueue::GetUsableCores(Vector<PODVector<unsigned> >& dest) const
+{
+    PODVector<CPUTopologyInfo> topology;
+    GetCPUTopology(topology);
+    
+    unsigned currentCPU = GetCurrentCPU();
+    unsigned mainCore = 0;
+    unsigned mainNode = 0;
+    for (unsigned i = 0; i < topology.Size(); ++i)
+    {
+        if (topology[i].cpu_ == currentCPU)
+        {
+            mainCore = topology[i].core_;
+            mainNode = topology[i].node_;
+            break;
+        }
+    }
+    
+    dest.Clear();
+    PODVector<unsigned> coreIndices;
+    
+    // First gather the cores of the main thread's node, then the rest
+    for (unsigned pass = 0; pass < 2; ++pass)
+    {
+        if (pass && localNodeOnly_)
+            break;
+        
+        for (unsigned i = 0; i < topology.Size(); ++i)
+        {
+            const CPUTopologyInfo& info = topology[i];
+            if ((info.node_ == mainNode) == (pass != 0))
+                continue;
+            
+            PODVector<unsigned>::Iterator j = coreIndices.Find(info.core_);
+            unsigned index = (unsigned)(j - coreIndices.Begin());
+            if (j == coreIndices.End())
+            {
+                coreIndices.Push(info.core_);
+                dest.Push(PODVector<unsigned>());
+            }
+            dest[index].Push(info.cpu_);
+        }
+    }
+    
+    PODVector<unsigned>::Iterator j = coreIndices.Find(mainCore);
+    if (j != coreIndices.End() && j != coreIndices.Begin())
+    {
+        unsigned index = (unsigned)(j - coreIndices.Begin());
+        PODVector<unsigned> mainCPUs = dest[index];
+        dest.Erase(index);
+        dest.Insert(0, mainCPUs);
+    }
+}
+
 void WorkQueue::ProcessItems(unsigned threadIndex)
 {
     bool wasActive = false;
+    long long busyTime = 0;
     
     for (;;)
     {
@@ -257,6 +364,10 @@ void WorkQueue::ProcessItems(unsigned threadIndex)
         else
         {
             queueMutex_.Acquire();
+            // Account the previous item's execution time while holding the mutex anyway
+            busyTime_[threadIndex] += busyTime;
+            busyTime = 0;
+            
             if (!queue_.Empty())
             {
                 wasActive = true;
@@ -264,7 +375,9 @@ void WorkQueue::ProcessItems(unsigned threadIndex)
                 WorkItem* item = queue_.Front();
                 queue_.PopFront();
                 queueMutex_.Release();
+                HiresTimer timer;
                 item->workFunction_(item, threadIndex);
+                busyTime = timer.GetUSec(false);
                 item->completed_ = true;
             }
             else
@@ -346,7 +459,9 @@ void WorkQueue::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
         {
             WorkItem* item = queue_.Front();
             queue_.PopFront();
+            HiresTimer itemTimer;
             item->workFunction_(item, 0);
+            busyTime_[0] += itemTimer.GetUSec(false);
             item->completed_ = true;
         }
     }
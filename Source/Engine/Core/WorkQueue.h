@@ -86,6 +86,12 @@ public:
     
     /// Create worker threads. Can only be called once.
     void CreateThreads(unsigned numThreads);
+    /// Set whether to pin the main thread and each worker thread to a physical core of its own. Call before creating the threads.
+    void SetThreadAffinity(bool enable) { threadAffinity_ = enable; }
+    /// Set whether to place worker threads only on the cores of the main thread's NUMA node, to avoid cache traffic between processor packages. Call before creating the threads.
+    void SetLocalNodeOnly(bool enable) { localNodeOnly_ = enable; }
+    /// Set number of physical cores next to the main thread's core to keep free of worker threads for audio mixing, background loading and I/O threads. Call before creating the threads.
+    void SetNumReservedCores(unsigned num) { numReservedCores_ = num; }
     /// Get pointer to an usable WorkItem from the item pool. Allocate one if no more free items.
     SharedPtr<WorkItem> GetFreeItem();
     /// Add a work item and resume worker threads.
@@ -103,14 +109,28 @@ public:
     
     /// Return number of worker threads.
     unsigned GetNumThreads() const { return threads_.Size(); }
+    /// Return default number of worker threads: one for each usable physical core, except the main thread's core and the reserved cores. Hyperthreads are not counted, as using them leads to unpredictable extra synchronization overhead.
+    unsigned GetDefaultNumThreads() const;
+    /// Return whether threads are pinned to physical cores.
+    bool GetThreadAffinity() const { return threadAffinity_; }
+    /// Return whether worker threads are placed only on the main thread's NUMA node.
+    bool GetLocalNodeOnly() const { return localNodeOnly_; }
+    /// Return number of physical cores reserved for audio mixing, background loading and I/O threads.
+    unsigned GetNumReservedCores() const { return numReservedCores_; }
+    /// Return the logical CPUs of the reserved cores, to run background loading and I/O threads on. Empty if thread affinity is disabled, no cores are reserved or the worker threads have not been created.
+    const PODVector<unsigned>& GetReservedCPUs() const { return reservedCPUs_; }
     /// Return whether all work with at least the specified priority is finished.
     bool IsCompleted(unsigned priority) const;
     /// Return the pool tolerance.
     int GetTolerance() const { return tolerance_; }
     /// Return how many milliseconds maximum to spend on non-threaded low-priority work.
     int GetNonThreadedWorkMs() const { return maxNonThreadedWorkMs_; }
+    /// Return total microseconds spent executing work items in a thread (0 = main thread.) Worker thread times lag behind by the item each thread is currently executing. Call only from the main thread.
+    long long GetBusyTime(unsigned threadIndex);
     
 private:
+    /// Return the logical CPUs of each usable physical core. The main thread's core is first, followed by the other cores of its NUMA node.
+    void GetUsableCores(Vector<PODVector<unsigned> >& dest) const;
     /// Process work items until shut down. Called by the worker threads.
     void ProcessItems(unsigned threadIndex);
     /// Purge completed work items which have at least the specified priority, and send completion events as necessary.
@@ -128,8 +148,8 @@ private:
     List<SharedPtr<WorkItem> > workItems_;
     /// Work item prioritized queue for worker threads. Pointers are guaranteed to be valid (point to workItems.)
     List<WorkItem*> queue_;
-    /// Worker queue mutex.
-    Mutex queueMutex_;
+    /// Worker queue mutex. Not recursive, and held by the main thread while the worker threads are paused.
+    FastMutex queueMutex_;
     /// Shutting down flag.
     volatile bool shutDown_;
     /// Pausing flag. Indicates the worker threads should not contend for the queue mutex.
@@ -142,6 +162,16 @@ private:
     unsigned lastSize_;
     /// Maximum milliseconds per frame to spend on low-priority work, when there are no worker threads.
     int maxNonThreadedWorkMs_;
+    /// Microseconds spent executing work items per thread. Worker thread entries are guarded by the queue mutex.
+    PODVector<long long> busyTime_;
+    /// Logical CPUs of the reserved cores.
+    PODVector<unsigned> reservedCPUs_;
+    /// Number of physical cores reserved for other threads.
+    unsigned numReservedCores_;
+    /// Thread pinning flag.
+    bool threadAffinity_;
+    /// Main thread's NUMA node only flag.
+    bool localNodeOnly_;
 };
 
 }
@@ -121,14 +121,19 @@ void DebugHud::Update()
             batches = renderer->GetNumBatches();
         }
 
+        // Show the frame and present times in milliseconds, rounded to two decimals
+        Engine* engine = GetSubsystem<Engine>();
         String stats;
-        stats.AppendWithFormat("Triangles %u\nBatches %u\nViews %u\nLights %u\nShadowmaps %u\nOccluders %u",
+        stats.AppendWithFormat("Triangles %u\nBatches %u\nViews %u\nLights %u\nShadowmaps %u\nOccluders %u\nFrame time %f ms\n"
+            "Present time %f ms",
             primitives,
             batches,
             renderer->GetNumViews(),
             renderer->GetNumLights(true),
             renderer->GetNumShadowMaps(true),
-            renderer->GetNumOccluders(true));
+            renderer->GetNumOccluders(true),
+            (int)(engine->GetAverageFrameTime() * 100000.0f + 0.5f) / 100.0f,
+            (int)(engine->GetPresentTime() * 100000.0f + 0.5f) / 100.0f);
 
         if (!appStats_.Empty())
         {
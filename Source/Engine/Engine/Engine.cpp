@@ -27,11 +27,17 @@
 #include "CoreEvents.h"
 #include "DebugHud.h"
 #include "Engine.h"
+#include "EngineEvents.h"
 #include "FileSystem.h"
+#include "FrameRecorder.h"
 #include "Graphics.h"
 #include "Input.h"
 #include "InputEvents.h"
 #include "Log.h"
+#ifdef URHO3D_NETWORK
+#include "HttpClient.h"
+#include "MetricsServer.h"
+#endif
 #ifdef URHO3D_NAVIGATION
 #include "NavigationMesh.h"
 #endif
@@ -48,11 +54,14 @@
 #include "ResourceCache.h"
 #include "Scene.h"
 #include "SceneEvents.h"
+#include "Sort.h"
 #include "UI.h"
 #include "Urho2D.h"
 #include "WorkQueue.h"
 #include "XMLFile.h"
 
+#include <cstdio>
+
 #include "DebugNew.h"
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -77,8 +86,32 @@ namespace Urho3D
 
 extern const char* logLevelPrefixes[];
 
+/// Initial estimate of how much a sleep overshoots the requested time, in microseconds.
+static const long long DEFAULT_SLEEP_OVERSHOOT = 1000;
+/// Maximum sleep overshoot estimate, in microseconds. Limits the busy-wait after a sleep.
+static const long long MAX_SLEEP_OVERSHOOT = 4000;
+/// Maximum number of vector allocation sites to dump.
+static const unsigned MAX_DUMPED_ALLOCATION_SITES = 50;
+/// Interval for publishing frame time statistics, in microseconds.
+static const long long FRAME_STATS_INTERVAL = 1000000;
+
 Engine::Engine(Context* context) :
     Object(context),
+    nextTickTime_(0),
+    sleepOvershoot_(DEFAULT_SLEEP_OVERSHOOT),
+    statsFrames_(0),
+    statsTotalTime_(0),
+    statsSquaredTime_(0.0),
+    statsMinTime_(M_MAX_INT),
+    statsMaxTime_(0),
+    statsMaxDeviation_(0),
+    statsSpinTime_(0),
+    statsPresentTime_(0),
+    averageFrameTime_(0.0f),
+    frameTimeDeviation_(0.0f),
+    maxFrameTimeDeviation_(0.0f),
+    frameLimiterSpinTime_(0.0f),
+    presentTime_(0.0f),
     timeStep_(0.0f),
     timeStepSmoothing_(2),
     minFps_(10),
@@ -98,7 +131,11 @@ Engine::Engine(Context* context) :
     initialized_(false),
     exiting_(false),
     headless_(false),
-    audioPaused_(false)
+    serverProfile_(false),
+    audioPaused_(false),
+    serverTickMode_(false),
+    pipelinedPresent_(false),
+    presentPending_(false)
 {
     // Register self as a subsystem
     context_->RegisterSubsystem(this);
@@ -114,8 +151,11 @@ Engine::Engine(Context* context) :
     context_->RegisterSubsystem(new Log(context_));
     #endif
     context_->RegisterSubsystem(new ResourceCache(context_));
+    context_->RegisterSubsystem(new FrameRecorder(context_));
     #ifdef URHO3D_NETWORK
     context_->RegisterSubsystem(new Network(context_));
+    context_->RegisterSubsystem(new HttpClient(context_));
+    context_->RegisterSubsystem(new MetricsServer(context_));
     #endif
     context_->RegisterSubsystem(new Input(context_));
     context_->RegisterSubsystem(new Audio(context_));
@@ -146,8 +186,10 @@ bool Engine::Initialize(const VariantMap& parameters)
 
     PROFILE(InitEngine);
 
-    // Set headless mode
-    headless_ = GetParameter(parameters, "Headless", false).GetBool();
+    // Set headless mode. The dedicated server profile and replaying a recording are always headless
+    serverProfile_ = GetParameter(parameters, "ServerProfile", false).GetBool();
+    headless_ = serverProfile_ || GetParameter(parameters, "Headless", false).GetBool() ||
+        !GetParameter(parameters, "ReplayFile", String::EMPTY).GetString().Empty();
 
     // Register the rest of the subsystems
     if (!headless_)
@@ -180,15 +222,22 @@ bool Engine::Initialize(const VariantMap& parameters)
     // Configure max FPS
     if (GetParameter(parameters, "FrameLimiter", true) == false)
         SetMaxFps(0);
+    SetServerTickMode(GetParameter(parameters, "ServerTickMode", false).GetBool());
+    SetPipelinedPresent(GetParameter(parameters, "PipelinedPresent", false).GetBool());
 
     // Set amount of worker threads according to the available physical CPU cores. Using also hyperthreaded cores results in
-    // unpredictable extra synchronization overhead. Also reserve one core for the main thread
-    unsigned numThreads = GetParameter(parameters, "WorkerThreads", true).GetBool() ? GetNumPhysicalCPUs() - 1 : 0;
+    // unpredictable extra synchronization overhead. Also reserve one core for the main thread, and optionally cores for audio and I/O
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    queue->SetThreadAffinity(GetParameter(parameters, "WorkerThreadAffinity", false).GetBool());
+    queue->SetLocalNodeOnly(GetParameter(parameters, "WorkerThreadsLocalNode", false).GetBool());
+    queue->SetNumReservedCores(Max(GetParameter(parameters, "ReservedCores", 0).GetInt(), 0));
+    unsigned numThreads = GetParameter(parameters, "WorkerThreads", true).GetBool() ? queue->GetDefaultNumThreads() : 0;
     if (numThreads)
     {
-        GetSubsystem<WorkQueue>()->CreateThreads(numThreads);
+        queue->CreateThreads(numThreads);
 
-        LOGINFOF("Created %u worker thread%s", numThreads, numThreads > 1 ? "s" : "");
+        LOGINFOF("Created %u worker thread%s%s", numThreads, numThreads > 1 ? "s" : "", queue->GetThreadAffinity() ?
+            " pinned to physical cores" : "");
     }
 
     // Add resource paths
@@ -373,10 +422,29 @@ bool Engine::Initialize(const VariantMap& parameters)
     // Init FPU state of main thread
     InitFPU();
 
+    // Start the metrics server if requested
+    #ifdef URHO3D_NETWORK
+    if (GetParameter(parameters, "MetricsPort", 0).GetInt() > 0)
+        GetSubsystem<MetricsServer>()->Start((unsigned short)GetParameter(parameters, "MetricsPort").GetInt());
+    #endif
+
     // Initialize input
     if (HasParameter(parameters, "TouchEmulation"))
         GetSubsystem<Input>()->SetTouchEmulation(GetParameter(parameters, "TouchEmulation").GetBool());
 
+    // Start recording or replaying frames if requested. A replay requested this way exits the engine when finished
+    FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+    String replayFile = GetParameter(parameters, "ReplayFile", String::EMPTY).GetString();
+    if (!replayFile.Empty())
+    {
+        if (recorder->StartReplay(replayFile, GetParameter(parameters, "ReplayProfileFile", String::EMPTY).GetString()))
+            SubscribeToEvent(recorder, E_REPLAYFINISHED, HANDLER(Engine, HandleReplayFinished));
+        else
+            return false;
+    }
+    else if (HasParameter(parameters, "RecordFile"))
+        recorder->StartRecording(GetParameter(parameters, "RecordFile").GetString());
+
     #ifdef URHO3D_TESTING
     if (HasParameter(parameters, "TimeOut"))
         timeOut_ = GetParameter(parameters, "TimeOut", 0).GetInt() * 1000000LL;
@@ -391,6 +459,9 @@ bool Engine::Initialize(const VariantMap& parameters)
 
     frameTimer_.Reset();
 
+    if (serverProfile_)
+        LOGINFO("Server profile active subsystems: " + String::Joined(GetActiveSubsystems(), ", "));
+
     LOGINFO("Initialized engine");
     initialized_ = true;
     return true;
@@ -412,8 +483,12 @@ void Engine::RunFrame()
     Time* time = GetSubsystem<Time>();
     Input* input = GetSubsystem<Input>();
     Audio* audio = GetSubsystem<Audio>();
+    FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
 
+    // When replaying, the frame recorder overrides the time step and then feeds the recorded input and network traffic
+    recorder->BeginFrame(timeStep_);
     time->BeginFrame(timeStep_);
+    recorder->DispatchFrame();
 
     // If pause when minimized -mode is in use, stop updates and audio as necessary
     if (pauseMinimized_ && input->IsMinimized())
@@ -436,10 +511,13 @@ void Engine::RunFrame()
         Update();
     }
 
+    // In pipelined present mode the previous frame is presented only now, after the update has been overlapped with it
+    Present();
     Render();
     ApplyFrameLimit();
 
     time->EndFrame();
+    recorder->EndFrame();
 }
 
 Console* Engine::CreateConsole()
@@ -499,6 +577,19 @@ void Engine::SetPauseMinimized(bool enable)
     pauseMinimized_ = enable;
 }
 
+void Engine::SetServerTickMode(bool enable)
+{
+    if (enable && !serverTickMode_)
+        nextTickTime_ = tickTimer_.GetUSec(false);
+    
+    serverTickMode_ = enable;
+}
+
+void Engine::SetPipelinedPresent(bool enable)
+{
+    pipelinedPresent_ = enable;
+}
+
 void Engine::SetAutoExit(bool enable)
 {
     // On mobile platforms exit is mandatory if requested by the platform itself and should not be attempted to be disabled
@@ -574,6 +665,12 @@ void Engine::DumpResources(bool dumpFileName)
     #endif
 }
 
+/// Compare vector allocation sites for sorting by allocation count.
+static bool CompareAllocationSites(const VectorAllocationSite& lhs, const VectorAllocationSite& rhs)
+{
+    return lhs.count_ > rhs.count_;
+}
+
 void Engine::DumpMemory()
 {
     #ifdef URHO3D_LOGGING
@@ -611,9 +708,43 @@ void Engine::DumpMemory()
     #else
     LOGRAW("DumpMemory() supported on MSVC debug mode only\n\n");
     #endif
+    
+    if (VectorBase::GetAllocationStats())
+    {
+        PODVector<VectorAllocationSite> sites;
+        VectorBase::GetAllocationStats(sites);
+        Sort(sites.Begin(), sites.End(), CompareAllocationSites);
+        
+        unsigned numSites = Min((int)sites.Size(), (int)MAX_DUMPED_ALLOCATION_SITES);
+        for (unsigned i = 0; i < numSites; ++i)
+        {
+            char address[32];
+            sprintf(address, "%p", sites[i].address_);
+            LOGRAW("Vector allocation site " + String(address) + ": " + String(sites[i].count_) + " allocations, " +
+                String(sites[i].bytes_) + " bytes\n");
+        }
+        LOGRAW("\n");
+    }
     #endif
 }
 
+Vector<String> Engine::GetActiveSubsystems() const
+{
+    Vector<String> ret;
+    
+    const HashMap<StringHash, SharedPtr<Object> >& subsystems = context_->GetSubsystems();
+    for (HashMap<StringHash, SharedPtr<Object> >::ConstIterator i = subsystems.Begin(); i != subsystems.End(); ++i)
+    {
+        Object* subsystem = i->second_;
+        if (subsystem->HasSubscribedToEvent(E_BEGINFRAME) || subsystem->HasSubscribedToEvent(E_UPDATE) ||
+            subsystem->HasSubscribedToEvent(E_POSTUPDATE) || subsystem->HasSubscribedToEvent(E_RENDERUPDATE) ||
+            subsystem->HasSubscribedToEvent(E_POSTRENDERUPDATE) || subsystem->HasSubscribedToEvent(E_ENDFRAME))
+            ret.Push(subsystem->GetTypeName());
+    }
+    
+    return ret;
+}
+
 void Engine::Update()
 {
     PROFILE(Update);
@@ -628,11 +759,12 @@ void Engine::Update()
     // Logic post-update event
     SendEvent(E_POSTUPDATE, eventData);
 
-    // Rendering update event
+    // Rendering update event. Also needed in headless mode to update octrees for raycasts and animation
     SendEvent(E_RENDERUPDATE, eventData);
 
-    // Post-render update event
-    SendEvent(E_POSTRENDERUPDATE, eventData);
+    // Post-render update event. Mainly used for drawing debug geometry, so it is not sent in the dedicated server profile
+    if (!serverProfile_)
+        SendEvent(E_POSTRENDERUPDATE, eventData);
 }
 
 void Engine::Render()
@@ -649,7 +781,30 @@ void Engine::Render()
 
     GetSubsystem<Renderer>()->Render();
     GetSubsystem<UI>()->Render();
-    graphics->EndFrame();
+    
+    presentPending_ = true;
+    // In pipelined present mode, submit the frame's commands to the GPU now, so that it renders them while the next frame
+    // is being updated, instead of the driver holding them until the buffers are swapped
+    if (pipelinedPresent_)
+        graphics->Flush();
+    else
+        Present();
+}
+
+void Engine::Present()
+{
+    if (!presentPending_)
+        return;
+    
+    presentPending_ = false;
+    
+    Graphics* graphics = GetSubsystem<Graphics>();
+    if (graphics)
+    {
+        HiresTimer presentTimer;
+        graphics->EndFrame();
+        statsPresentTime_ += presentTimer.GetUSec(false);
+    }
 }
 
 void Engine::ApplyFrameLimit()
@@ -661,32 +816,81 @@ void Engine::ApplyFrameLimit()
     Input* input = GetSubsystem<Input>();
     if (input && !input->HasFocus())
         maxFps = Min(maxInactiveFps_, maxFps);
+    // Replay runs as fast as possible, as the time step comes from the recording
+    FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+    if (recorder && recorder->IsReplaying())
+        maxFps = 0;
 
     long long elapsed = 0;
+    long long targetMax = maxFps ? 1000000LL / maxFps : 0;
+    long long spinTime = 0;
+    bool onTickSchedule = false;
 
     // Perform waiting loop if maximum FPS set
     if (maxFps)
     {
         PROFILE(ApplyFrameLimit);
 
-        long long targetMax = 1000000LL / maxFps;
-
-        for (;;)
+        if (serverTickMode_)
+        {
+            // Sleep until the next tick of a fixed schedule, so that sleep inaccuracy does not accumulate. If more than one
+            // tick behind, resynchronize the schedule instead of running ticks back-to-back to catch up
+            long long now = tickTimer_.GetUSec(false);
+            nextTickTime_ += targetMax;
+            if (now - nextTickTime_ > targetMax)
+                nextTickTime_ = now;
+            else
+            {
+                Time::SleepUSec(nextTickTime_ - now);
+                onTickSchedule = true;
+            }
+        }
+        else
         {
-            elapsed = frameTimer_.GetUSec(false);
-            if (elapsed >= targetMax)
-                break;
+            long long sleepTime = 0;
+            long long startTime = frameTimer_.GetUSec(false);
 
-            // Sleep if 1 ms or more off the frame limiting goal
-            if (targetMax - elapsed >= 1000LL)
+            for (;;)
             {
-                unsigned sleepTime = (unsigned)((targetMax - elapsed) / 1000LL);
-                Time::Sleep(sleepTime);
+                elapsed = frameTimer_.GetUSec(false);
+                long long remaining = targetMax - elapsed;
+                if (remaining <= 0)
+                    break;
+
+                // Sleep while further off the goal than a sleep is expected to overshoot, then busy-wait the rest
+                if (remaining > sleepOvershoot_)
+                {
+                    long long request = remaining - sleepOvershoot_;
+                    HiresTimer sleepTimer;
+                    Time::SleepUSec(request);
+                    long long actual = sleepTimer.GetUSec(false);
+                    sleepTime += actual;
+
+                    // Calibrate the overshoot estimate: adapt quickly upward to avoid missing the goal, and slowly downward
+                    long long overshoot = actual - request;
+                    if (overshoot > sleepOvershoot_)
+                        sleepOvershoot_ = (sleepOvershoot_ + overshoot) / 2;
+                    else
+                        sleepOvershoot_ = (sleepOvershoot_ * 15 + overshoot) / 16;
+                    if (sleepOvershoot_ < 0)
+                        sleepOvershoot_ = 0;
+                    else if (sleepOvershoot_ > MAX_SLEEP_OVERSHOOT)
+                        sleepOvershoot_ = MAX_SLEEP_OVERSHOOT;
+                }
             }
+
+            spinTime = elapsed - startTime - sleepTime;
+            if (spinTime < 0)
+                spinTime = 0;
         }
     }
 
     elapsed = frameTimer_.GetUSec(true);
+    UpdateFrameStats(elapsed, targetMax, spinTime);
+
+    // In server tick mode use the fixed tick length as the timestep while on schedule
+    if (onTickSchedule)
+        elapsed = targetMax;
     #ifdef URHO3D_TESTING
     if (timeOut_ > 0)
     {
@@ -732,6 +936,8 @@ VariantMap Engine::ParseParameters(const Vector<String>& arguments)
 
             if (argument == "headless")
                 ret["Headless"] = true;
+            else if (argument == "serverprofile")
+                ret["ServerProfile"] = true;
             else if (argument == "nolimit")
                 ret["FrameLimiter"] = false;
             else if (argument == "flushgpu")
@@ -756,6 +962,12 @@ VariantMap Engine::ParseParameters(const Vector<String>& arguments)
                 ret["LowQualityShadows"] = true;
             else if (argument == "nothreads")
                 ret["WorkerThreads"] = false;
+            else if (argument == "pinthreads")
+                ret["WorkerThreadAffinity"] = true;
+            else if (argument == "localnode")
+                ret["WorkerThreadsLocalNode"] = true;
+            else if (argument == "pipelined")
+                ret["PipelinedPresent"] = true;
             else if (argument == "sm2")
                 ret["ForceSM2"] = true;
             else if (argument == "v")
@@ -804,6 +1016,31 @@ VariantMap Engine::ParseParameters(const Vector<String>& arguments)
                 ret["SoundMixRate"] = ToInt(value);
                 ++i;
             }
+            else if (argument == "reservecores" && !value.Empty())
+            {
+                ret["ReservedCores"] = ToInt(value);
+                ++i;
+            }
+            else if (argument == "metricsport" && !value.Empty())
+            {
+                ret["MetricsPort"] = ToInt(value);
+                ++i;
+            }
+            else if (argument == "record" && !value.Empty())
+            {
+                ret["RecordFile"] = value;
+                ++i;
+            }
+            else if (argument == "replay" && !value.Empty())
+            {
+                ret["ReplayFile"] = value;
+                ++i;
+            }
+            else if (argument == "replayprofile" && !value.Empty())
+            {
+                ret["ReplayProfileFile"] = value;
+                ++i;
+            }
             else if (argument == "p" && !value.Empty())
             {
                 ret["ResourcePaths"] = value;
@@ -878,6 +1115,53 @@ void Engine::HandleExitRequested(StringHash eventType, VariantMap& eventData)
     }
 }
 
+void Engine::HandleReplayFinished(StringHash eventType, VariantMap& eventData)
+{
+    Exit();
+}
+
+void Engine::UpdateFrameStats(long long frameTime, long long targetFrameTime, long long spinTime)
+{
+    ++statsFrames_;
+    statsTotalTime_ += frameTime;
+    statsSquaredTime_ += (double)frameTime * (double)frameTime;
+    if (frameTime < statsMinTime_)
+        statsMinTime_ = frameTime;
+    if (frameTime > statsMaxTime_)
+        statsMaxTime_ = frameTime;
+    if (targetFrameTime)
+    {
+        long long deviation = frameTime > targetFrameTime ? frameTime - targetFrameTime : targetFrameTime - frameTime;
+        if (deviation > statsMaxDeviation_)
+            statsMaxDeviation_ = deviation;
+    }
+    statsSpinTime_ += spinTime;
+
+    if (statsTotalTime_ < FRAME_STATS_INTERVAL)
+        return;
+
+    double average = (double)statsTotalTime_ / statsFrames_;
+    double variance = statsSquaredTime_ / statsFrames_ - average * average;
+    // If not frame limiting, measure the deviation from the average instead
+    if (!targetFrameTime)
+        statsMaxDeviation_ = (long long)Max((float)(statsMaxTime_ - average), (float)(average - statsMinTime_));
+
+    averageFrameTime_ = (float)(average / 1000000.0);
+    frameTimeDeviation_ = variance > 0.0 ? (float)(sqrt(variance) / 1000000.0) : 0.0f;
+    maxFrameTimeDeviation_ = statsMaxDeviation_ / 1000000.0f;
+    frameLimiterSpinTime_ = (float)((double)statsSpinTime_ / statsFrames_ / 1000000.0);
+    presentTime_ = (float)((double)statsPresentTime_ / statsFrames_ / 1000000.0);
+
+    statsFrames_ = 0;
+    statsTotalTime_ = 0;
+    statsSquaredTime_ = 0.0;
+    statsMinTime_ = M_MAX_INT;
+    statsMaxTime_ = 0;
+    statsMaxDeviation_ = 0;
+    statsSpinTime_ = 0;
+    statsPresentTime_ = 0;
+}
+
 void Engine::DoExit()
 {
     Graphics* graphics = GetSubsystem<Graphics>();
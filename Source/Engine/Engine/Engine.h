@@ -62,6 +62,10 @@ public:
     void SetPauseMinimized(bool enable);
     /// Set whether to exit automatically on exit request (window close button.)
     void SetAutoExit(bool enable);
+    /// Set whether to use server tick mode: the frame limiter sleeps until the next fixed tick without busy-waiting, and the timestep is the fixed tick length while on schedule. Intended for dedicated servers.
+    void SetServerTickMode(bool enable);
+    /// Set whether to present the rendered frame only after the next frame's update, so that the update runs while the GPU is still finishing the previous frame. Adds one frame of display latency.
+    void SetPipelinedPresent(bool enable);
     /// Override timestep of the next frame. Should be called in between RunFrame() calls.
     void SetNextTimeStep(float seconds);
     /// Close the graphics window and set the exit flag. No-op on iOS, as an iOS application can not legally exit.
@@ -70,7 +74,7 @@ public:
     void DumpProfiler();
     /// Dump information of all resources to the log.
     void DumpResources(bool dumpFileName = false);
-    /// Dump information of all memory allocations to the log. Supported in MSVC debug mode only.
+    /// Dump information of all memory allocations to the log. Supported in MSVC debug mode only. Also dump the vector allocation sites if their statistics are enabled.
     void DumpMemory();
     
     /// Get timestep of the next frame. Updated by ApplyFrameLimit().
@@ -87,17 +91,37 @@ public:
     bool GetPauseMinimized() const { return pauseMinimized_; }
     /// Return whether to exit automatically on exit request.
     bool GetAutoExit() const { return autoExit_; }
+    /// Return whether server tick mode is in use.
+    bool GetServerTickMode() const { return serverTickMode_; }
+    /// Return average frame time in seconds, measured over the last second.
+    float GetAverageFrameTime() const { return averageFrameTime_; }
+    /// Return standard deviation of frame time in seconds, measured over the last second.
+    float GetFrameTimeDeviation() const { return frameTimeDeviation_; }
+    /// Return largest deviation of frame time from the frame limiter target (or from the average if not limiting) in seconds, measured over the last second.
+    float GetMaxFrameTimeDeviation() const { return maxFrameTimeDeviation_; }
+    /// Return average time per frame spent busy-waiting in the frame limiter in seconds, measured over the last second.
+    float GetFrameLimiterSpinTime() const { return frameLimiterSpinTime_; }
+    /// Return average time per frame spent presenting in seconds, including any wait for the GPU or vertical sync, measured over the last second.
+    float GetPresentTime() const { return presentTime_; }
+    /// Return whether presenting is pipelined with the next frame's update.
+    bool GetPipelinedPresent() const { return pipelinedPresent_; }
     /// Return whether engine has been initialized.
     bool IsInitialized() const { return initialized_; }
     /// Return whether exit has been requested.
     bool IsExiting() const { return exiting_; }
     /// Return whether the engine has been created in headless mode.
     bool IsHeadless() const { return headless_; }
+    /// Return whether the engine has been created in dedicated server profile, which implies headless mode.
+    bool IsServerProfile() const { return serverProfile_; }
+    /// Return type names of the subsystems that currently subscribe to per-frame events.
+    Vector<String> GetActiveSubsystems() const;
     
     /// Send frame update events.
     void Update();
-    /// Render after frame update.
+    /// Render after frame update. In pipelined present mode the frame is only presented after the next frame's update.
     void Render();
+    /// Present a frame rendered in pipelined present mode, if pending. Called automatically by RunFrame().
+    void Present();
     /// Get the timestep for the next frame and sleep for frame limiting if necessary.
     void ApplyFrameLimit();
     
@@ -111,11 +135,47 @@ public:
 private:
     /// Handle exit requested event. Auto-exit if enabled.
     void HandleExitRequested(StringHash eventType, VariantMap& eventData);
+    /// Handle replay finished event. Exit if the replay was requested with the startup parameters.
+    void HandleReplayFinished(StringHash eventType, VariantMap& eventData);
     /// Actually perform the exit actions.
     void DoExit();
+    /// Accumulate frame time statistics and publish them once per second.
+    void UpdateFrameStats(long long frameTime, long long targetFrameTime, long long spinTime);
     
     /// Frame update timer.
     HiresTimer frameTimer_;
+    /// Timer for the server tick schedule. Never reset.
+    HiresTimer tickTimer_;
+    /// Time of the next server tick in microseconds, measured by the tick timer.
+    long long nextTickTime_;
+    /// Estimated sleep overshoot in microseconds, calibrated from actual sleeps. The frame limiter busy-waits for this time after sleeping.
+    long long sleepOvershoot_;
+    /// Accumulated frame time statistics: number of frames.
+    unsigned statsFrames_;
+    /// Accumulated frame time statistics: total frame time in microseconds.
+    long long statsTotalTime_;
+    /// Accumulated frame time statistics: sum of squared frame times.
+    double statsSquaredTime_;
+    /// Accumulated frame time statistics: shortest frame time in microseconds.
+    long long statsMinTime_;
+    /// Accumulated frame time statistics: longest frame time in microseconds.
+    long long statsMaxTime_;
+    /// Accumulated frame time statistics: largest deviation from the frame limiter target in microseconds.
+    long long statsMaxDeviation_;
+    /// Accumulated frame time statistics: total busy-wait time in microseconds.
+    long long statsSpinTime_;
+    /// Accumulated frame time statistics: total present time in microseconds.
+    long long statsPresentTime_;
+    /// Average frame time in seconds.
+    float averageFrameTime_;
+    /// Frame time standard deviation in seconds.
+    float frameTimeDeviation_;
+    /// Largest frame time deviation in seconds.
+    float maxFrameTimeDeviation_;
+    /// Average busy-wait time per frame in seconds.
+    float frameLimiterSpinTime_;
+    /// Average present time per frame in seconds.
+    float presentTime_;
     /// Previous timesteps for smoothing.
     PODVector<float> lastTimeSteps_;
     /// Next frame timestep in seconds.
@@ -142,8 +202,16 @@ private:
     bool exiting_;
     /// Headless mode flag.
     bool headless_;
+    /// Dedicated server profile flag.
+    bool serverProfile_;
     /// Audio paused flag.
     bool audioPaused_;
+    /// Server tick mode flag.
+    bool serverTickMode_;
+    /// Pipelined present flag.
+    bool pipelinedPresent_;
+    /// Rendered frame waiting to be presented flag.
+    bool presentPending_;
 };
 
 }
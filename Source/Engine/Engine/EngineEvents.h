@@ -34,4 +34,9 @@ EVENT(E_CONSOLECOMMAND, ConsoleCommand)
     PARAM(P_ID, Id);                        // String
 }
 
+/// Frame recorder replay has reached the end of the recording.
+EVENT(E_REPLAYFINISHED, ReplayFinished)
+{
+}
+
 }
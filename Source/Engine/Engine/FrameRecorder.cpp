@@ -0,0 +1,414 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "Context.h"
+#include "EngineEvents.h"
+#include "File.h"
+#include "FileSystem.h"
+#include "FrameRecorder.h"
+#include "Input.h"
+#include "InputEvents.h"
+#include "Log.h"
+#ifdef URHO3D_NETWORK
+#include "Network.h"
+#endif
+#include "Profiler.h"
+#include "Random.h"
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Recorded frame item types.
+enum RecordedItemType
+{
+    RECORDED_EVENT = 0,
+    RECORDED_CLIENTCONNECTED,
+    RECORDED_CLIENTDISCONNECTED,
+    RECORDED_CLIENTMESSAGE
+};
+
+/// Return whether an event type is one of the input events, which are replayed through the Input subsystem.
+static bool IsInputEvent(StringHash eventType)
+{
+    return eventType == E_MOUSEBUTTONDOWN || eventType == E_MOUSEBUTTONUP || eventType == E_MOUSEMOVE ||
+        eventType == E_MOUSEWHEEL || eventType == E_KEYDOWN || eventType == E_KEYUP || eventType == E_TEXTINPUT ||
+        eventType == E_JOYSTICKBUTTONDOWN || eventType == E_JOYSTICKBUTTONUP || eventType == E_JOYSTICKAXISMOVE ||
+        eventType == E_JOYSTICKHATMOVE || eventType == E_TOUCHBEGIN || eventType == E_TOUCHEND || eventType == E_TOUCHMOVE;
+}
+
+/// Write the frame time of profiler blocks used during the frame, with paths from the root separated with slashes.
+static void WriteProfilerBlocks(Serializer& dest, const String& prefix, const ProfilerBlock* block, const String& parentPath)
+{
+    for (PODVector<ProfilerBlock*>::ConstIterator i = block->children_.Begin(); i != block->children_.End(); ++i)
+    {
+        const ProfilerBlock* child = *i;
+        if (!child->frameCount_)
+            continue;
+        
+        String path = parentPath.Empty() ? String(child->name_) : parentPath + "/" + child->name_;
+        dest.WriteLine(prefix + path + "\t" + String(child->frameTime_ / 1000.0f) + "\t" + String(child->frameCount_));
+        WriteProfilerBlocks(dest, prefix, child, path);
+    }
+}
+
+FrameRecorder::FrameRecorder(Context* context) :
+    Object(context),
+    numFrameItems_(0),
+    frameTimeStep_(0.0f),
+    frameRandomSeed_(0),
+    numFrames_(0),
+    nextConnectionID_(0)
+{
+    recordedEvents_.Insert(E_MOUSEBUTTONDOWN);
+    recordedEvents_.Insert(E_MOUSEBUTTONUP);
+    recordedEvents_.Insert(E_MOUSEMOVE);
+    recordedEvents_.Insert(E_MOUSEWHEEL);
+    recordedEvents_.Insert(E_KEYDOWN);
+    recordedEvents_.Insert(E_KEYUP);
+    recordedEvents_.Insert(E_TEXTINPUT);
+    recordedEvents_.Insert(E_JOYSTICKBUTTONDOWN);
+    recordedEvents_.Insert(E_JOYSTICKBUTTONUP);
+    recordedEvents_.Insert(E_JOYSTICKAXISMOVE);
+    recordedEvents_.Insert(E_JOYSTICKHATMOVE);
+    recordedEvents_.Insert(E_TOUCHBEGIN);
+    recordedEvents_.Insert(E_TOUCHEND);
+    recordedEvents_.Insert(E_TOUCHMOVE);
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    StopRecording();
+    StopReplay();
+}
+
+bool FrameRecorder::StartRecording(const String& fileName)
+{
+    StopRecording();
+    
+    if (IsReplaying())
+    {
+        LOGERROR("Can not record while replaying");
+        return false;
+    }
+    
+    SharedPtr<File> file(new File(context_, fileName, FILE_WRITE));
+    if (!file->IsOpen())
+    {
+        LOGERROR("Could not open recording file " + fileName);
+        return false;
+    }
+    
+    file->WriteFileID("UREC");
+    file->WriteUInt(GetRandomSeed());
+    recordFile_ = file;
+    numFrames_ = 0;
+    frameData_.Clear();
+    numFrameItems_ = 0;
+    recordedConnections_.Clear();
+    nextConnectionID_ = 0;
+    
+    for (HashSet<StringHash>::ConstIterator i = recordedEvents_.Begin(); i != recordedEvents_.End(); ++i)
+        SubscribeToEvent(*i, HANDLER(FrameRecorder, HandleRecordedEvent));
+    
+    LOGINFO("Started recording to " + fileName);
+    return true;
+}
+
+void FrameRecorder::StopRecording()
+{
+    if (!recordFile_)
+        return;
+    
+    for (HashSet<StringHash>::ConstIterator i = recordedEvents_.Begin(); i != recordedEvents_.End(); ++i)
+        UnsubscribeFromEvent(*i);
+    
+    LOGINFO("Stopped recording after " + String(numFrames_) + " frames");
+    recordFile_.Reset();
+    frameData_.Clear();
+    numFrameItems_ = 0;
+    recordedConnections_.Clear();
+}
+
+bool FrameRecorder::StartReplay(const String& fileName, const String& profileFileName)
+{
+    StopReplay();
+    
+    if (IsRecording())
+    {
+        LOGERROR("Can not replay while recording");
+        return false;
+    }
+    
+    SharedPtr<File> file(new File(context_, fileName, FILE_READ));
+    if (!file->IsOpen())
+    {
+        LOGERROR("Could not open recording file " + fileName);
+        return false;
+    }
+    if (file->ReadFileID() != "UREC")
+    {
+        LOGERROR(fileName + " is not a valid recording file");
+        return false;
+    }
+    
+    if (!profileFileName.Empty())
+    {
+        profileFile_ = new File(context_, profileFileName, FILE_WRITE);
+        if (!profileFile_->IsOpen())
+        {
+            LOGERROR("Could not open profiling output file " + profileFileName);
+            profileFile_.Reset();
+            return false;
+        }
+        profileFile_->WriteLine("frame\tblock\tms\tcount");
+    }
+    
+    SetRandomSeed(file->ReadUInt());
+    replayFile_ = file;
+    numFrames_ = 0;
+    numFrameItems_ = 0;
+    
+    LOGINFO("Started replaying " + fileName);
+    return true;
+}
+
+void FrameRecorder::StopReplay()
+{
+    if (!replayFile_)
+        return;
+    
+    #ifdef URHO3D_NETWORK
+    // Disconnect the replayed client connections that were still connected at the end of the recording
+    Network* network = GetSubsystem<Network>();
+    if (network)
+    {
+        for (HashMap<unsigned, SharedPtr<Connection> >::Iterator i = replayConnections_.Begin(); i != replayConnections_.End(); ++i)
+            network->RemoveReplayConnection(i->second_);
+    }
+    replayConnections_.Clear();
+    #endif
+    
+    LOGINFO("Stopped replay after " + String(numFrames_) + " frames");
+    replayFile_.Reset();
+    profileFile_.Reset();
+    numFrameItems_ = 0;
+}
+
+void FrameRecorder::AddRecordedEvent(StringHash eventType)
+{
+    recordedEvents_.Insert(eventType);
+    if (recordFile_)
+        SubscribeToEvent(eventType, HANDLER(FrameRecorder, HandleRecordedEvent));
+}
+
+void FrameRecorder::RemoveRecordedEvent(StringHash eventType)
+{
+    recordedEvents_.Erase(eventType);
+    if (recordFile_)
+        UnsubscribeFromEvent(eventType);
+}
+
+void FrameRecorder::BeginFrame(float& timeStep)
+{
+    if (recordFile_)
+    {
+        frameTimeStep_ = timeStep;
+        frameRandomSeed_ = GetRandomSeed();
+    }
+    else if (replayFile_)
+    {
+        if (replayFile_->IsEof())
+        {
+            StopReplay();
+            SendEvent(E_REPLAYFINISHED);
+            return;
+        }
+        
+        timeStep = replayFile_->ReadFloat();
+        SetRandomSeed(replayFile_->ReadUInt());
+        numFrameItems_ = replayFile_->ReadVLE();
+        frameTimer_.Reset();
+    }
+}
+
+void FrameRecorder::DispatchFrame()
+{
+    if (!replayFile_)
+        return;
+    
+    PROFILE(DispatchReplayFrame);
+    
+    Input* input = GetSubsystem<Input>();
+    input->BeginReplayFrame();
+    #ifdef URHO3D_NETWORK
+    Network* network = GetSubsystem<Network>();
+    #endif
+    
+    while (numFrameItems_ && !replayFile_->IsEof())
+    {
+        --numFrameItems_;
+        
+        switch (replayFile_->ReadUByte())
+        {
+        case RECORDED_EVENT:
+            {
+                StringHash eventType = replayFile_->ReadStringHash();
+                VariantMap eventData = replayFile_->ReadVariantMap();
+                if (IsInputEvent(eventType))
+                    input->ReplayEvent(eventType, eventData);
+                else
+                    SendEvent(eventType, eventData);
+            }
+            break;
+            
+        case RECORDED_CLIENTCONNECTED:
+            {
+                unsigned id = replayFile_->ReadVLE();
+                #ifdef URHO3D_NETWORK
+                if (network)
+                    replayConnections_[id] = network->AddReplayConnection();
+                #endif
+            }
+            break;
+            
+        case RECORDED_CLIENTDISCONNECTED:
+            {
+                unsigned id = replayFile_->ReadVLE();
+                #ifdef URHO3D_NETWORK
+                HashMap<unsigned, SharedPtr<Connection> >::Iterator i = replayConnections_.Find(id);
+                if (i != replayConnections_.End())
+                {
+                    network->RemoveReplayConnection(i->second_);
+                    replayConnections_.Erase(i);
+                }
+                #endif
+            }
+            break;
+            
+        case RECORDED_CLIENTMESSAGE:
+            {
+                unsigned id = replayFile_->ReadVLE();
+                int msgID = replayFile_->ReadInt();
+                PODVector<unsigned char> data = replayFile_->ReadBuffer();
+                #ifdef URHO3D_NETWORK
+                HashMap<unsigned, SharedPtr<Connection> >::Iterator i = replayConnections_.Find(id);
+                if (i != replayConnections_.End())
+                    network->ReplayMessage(i->second_, msgID, data.Size() ? &data[0] : 0, data.Size());
+                #endif
+            }
+            break;
+            
+        default:
+            LOGERROR("Corrupt recording data on frame " + String(numFrames_));
+            numFrameItems_ = 0;
+            break;
+        }
+    }
+}
+
+void FrameRecorder::EndFrame()
+{
+    if (recordFile_)
+    {
+        recordFile_->WriteFloat(frameTimeStep_);
+        recordFile_->WriteUInt(frameRandomSeed_);
+        recordFile_->WriteVLE(numFrameItems_);
+        recordFile_->Write(frameData_.GetData(), frameData_.GetSize());
+        frameData_.Clear();
+        numFrameItems_ = 0;
+        ++numFrames_;
+    }
+    else if (replayFile_)
+    {
+        if (profileFile_)
+            WriteFrameProfile(frameTimer_.GetUSec(false));
+        ++numFrames_;
+    }
+}
+
+void FrameRecorder::RecordClientConnected(Connection* connection)
+{
+    if (!recordFile_)
+        return;
+    
+    unsigned id = nextConnectionID_++;
+    recordedConnections_[connection] = id;
+    frameData_.WriteUByte(RECORDED_CLIENTCONNECTED);
+    frameData_.WriteVLE(id);
+    ++numFrameItems_;
+}
+
+void FrameRecorder::RecordClientDisconnected(Connection* connection)
+{
+    if (!recordFile_)
+        return;
+    
+    HashMap<Connection*, unsigned>::Iterator i = recordedConnections_.Find(connection);
+    if (i == recordedConnections_.End())
+        return;
+    
+    frameData_.WriteUByte(RECORDED_CLIENTDISCONNECTED);
+    frameData_.WriteVLE(i->second_);
+    ++numFrameItems_;
+    recordedConnections_.Erase(i);
+}
+
+void FrameRecorder::RecordClientMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes)
+{
+    if (!recordFile_)
+        return;
+    
+    // Messages from clients that connected before the recording started can not be replayed
+    HashMap<Connection*, unsigned>::ConstIterator i = recordedConnections_.Find(connection);
+    if (i == recordedConnections_.End())
+        return;
+    
+    frameData_.WriteUByte(RECORDED_CLIENTMESSAGE);
+    frameData_.WriteVLE(i->second_);
+    frameData_.WriteInt(msgID);
+    frameData_.WriteVLE(numBytes);
+    frameData_.Write(data, numBytes);
+    ++numFrameItems_;
+}
+
+void FrameRecorder::HandleRecordedEvent(StringHash eventType, VariantMap& eventData)
+{
+    frameData_.WriteUByte(RECORDED_EVENT);
+    frameData_.WriteStringHash(eventType);
+    frameData_.WriteVariantMap(eventData);
+    ++numFrameItems_;
+}
+
+void FrameRecorder::WriteFrameProfile(long long frameTime)
+{
+    String prefix = String(numFrames_) + "\t";
+    profileFile_->WriteLine(prefix + "Frame\t" + String(frameTime / 1000.0f) + "\t1");
+    
+    Profiler* profiler = GetSubsystem<Profiler>();
+    if (profiler)
+        WriteProfilerBlocks(*profileFile_, prefix, profiler->GetRootBlock(), String::EMPTY);
+}
+
+}
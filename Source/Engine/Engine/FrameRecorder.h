@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "HashMap.h"
+#include "HashSet.h"
+#include "Object.h"
+#include "Timer.h"
+#include "VectorBuffer.h"
+
+namespace Urho3D
+{
+
+class Connection;
+class File;
+
+/// Records the time steps, random seeds, input events and client network traffic of each frame to a file, and replays them deterministically in place of the live input and network traffic, optionally writing per-frame profiling data.
+class URHO3D_API FrameRecorder : public Object
+{
+    OBJECT(FrameRecorder);
+    
+public:
+    /// Construct.
+    FrameRecorder(Context* context);
+    /// Destruct. Stop recording or replay.
+    ~FrameRecorder();
+    
+    /// Start recording to a file from the next frame. Return true if successful.
+    bool StartRecording(const String& fileName);
+    /// Stop recording and close the file.
+    void StopRecording();
+    /// Start replaying a recording from the next frame, optionally writing per-frame profiling data to a text file. Return true if successful.
+    bool StartReplay(const String& fileName, const String& profileFileName = String::EMPTY);
+    /// Stop replay and close the files.
+    void StopReplay();
+    /// Add an event type to record in addition to the input events. The event is resent on replay with the recorder as the sender.
+    void AddRecordedEvent(StringHash eventType);
+    /// Remove an event type from recording.
+    void RemoveRecordedEvent(StringHash eventType);
+    
+    /// Begin a frame: in record mode store the time step and random seed, in replay mode read the next frame and override them. Called by Engine.
+    void BeginFrame(float& timeStep);
+    /// Dispatch the replayed input events and network messages of the frame. Called by Engine after the frame begin event.
+    void DispatchFrame();
+    /// End a frame: in record mode write the frame, in replay mode write its profiling data. Called by Engine.
+    void EndFrame();
+    
+    /// Record a new client connection. Called by Network.
+    void RecordClientConnected(Connection* connection);
+    /// Record a client disconnection. Called by Network.
+    void RecordClientDisconnected(Connection* connection);
+    /// Record a message received from a client. Called by Network.
+    void RecordClientMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes);
+    
+    /// Return whether is recording.
+    bool IsRecording() const { return recordFile_.NotNull(); }
+    /// Return whether is replaying.
+    bool IsReplaying() const { return replayFile_.NotNull(); }
+    /// Return number of frames recorded or replayed so far.
+    unsigned GetNumFrames() const { return numFrames_; }
+    
+private:
+    /// Handle a recorded event.
+    void HandleRecordedEvent(StringHash eventType, VariantMap& eventData);
+    /// Write the profiling data of a replayed frame.
+    void WriteFrameProfile(long long frameTime);
+    
+    /// Recording file.
+    SharedPtr<File> recordFile_;
+    /// Replay file.
+    SharedPtr<File> replayFile_;
+    /// Per-frame profiling output file.
+    SharedPtr<File> profileFile_;
+    /// Recorded event types.
+    HashSet<StringHash> recordedEvents_;
+    /// Items recorded during the current frame.
+    VectorBuffer frameData_;
+    /// Number of items recorded during, or remaining to be replayed for, the current frame.
+    unsigned numFrameItems_;
+    /// Time step of the current frame.
+    float frameTimeStep_;
+    /// Random seed at the beginning of the current frame.
+    unsigned frameRandomSeed_;
+    /// Number of frames recorded or replayed.
+    unsigned numFrames_;
+    /// Replayed frame timer.
+    HiresTimer frameTimer_;
+    /// IDs of the recorded client connections.
+    HashMap<Connection*, unsigned> recordedConnections_;
+    /// Replayed client connections by ID.
+    HashMap<unsigned, SharedPtr<Connection> > replayConnections_;
+    /// Next recorded client connection ID.
+    unsigned nextConnectionID_;
+};
+
+}
@@ -201,6 +201,10 @@ void AnimatedModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQu
 
 void AnimatedModel::Update(const FrameInfo& frame)
 {
+    // In the dedicated server profile the model is never in view, so only animate if invisible update is enabled
+    if (!frame.camera_ && !updateInvisible_ && GetSkipPresentationUpdates())
+        return;
+    
     // If node was invisible last frame, need to decide animation LOD distance here
     // If headless, retain the current animation distance (should be 0)
     if (frame.camera_ && abs((int)frame.frameNumber_ - (int)viewFrameNumber_) > 1)
@@ -735,10 +735,10 @@ void BatchQueue::SortBackToFront()
 
 void BatchQueue::SortFrontToBack()
 {
-    sortedBatches_.Clear();
+    sortedBatches_.Resize(batches_.Size());
     
     for (unsigned i = 0; i < batches_.Size(); ++i)
-        sortedBatches_.Push(&batches_[i]);
+        sortedBatches_[i] = &batches_[i];
     
     SortFrontToBack2Pass(sortedBatches_);
     
@@ -155,13 +155,11 @@ struct BatchGroup : public Batch
     /// Add world transform(s) from a batch.
     void AddTransforms(const Batch& batch)
     {
-        InstanceData newInstance;
-        newInstance.distance_ = batch.distance_;
-        
         for (unsigned i = 0; i < batch.numWorldTransforms_; ++i)
         {
+            InstanceData& newInstance = instances_.EmplaceBack();
             newInstance.worldTransform_ = &batch.worldTransform_[i];
-            instances_.Push(newInstance);
+            newInstance.distance_ = batch.distance_;
         }
     }
     
@@ -822,6 +822,18 @@ void Graphics::EndFrame()
     CleanupScratchBuffers();
 }
 
+void Graphics::Flush()
+{
+    if (!IsInitialized() || !impl_->frameQuery_)
+        return;
+    
+    // Polling a query with the flush flag submits the command buffer. Reuse the frame query if it is already pending, so that
+    // the GPU flush at the end of the frame still waits for the same point
+    if (!queryIssued_)
+        impl_->frameQuery_->Issue(D3DISSUE_END);
+    impl_->frameQuery_->GetData(0, 0, D3DGETDATA_FLUSH);
+}
+
 void Graphics::Clear(unsigned flags, const Color& color, float depth, unsigned stencil)
 {
     DWORD d3dFlags = 0;
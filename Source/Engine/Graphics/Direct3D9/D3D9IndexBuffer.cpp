@@ -43,7 +43,8 @@ IndexBuffer::IndexBuffer(Context* context) :
     lockStart_(0),
     lockCount_(0),
     lockScratchData_(0),
-    shadowed_(false)
+    shadowed_(false),
+    dataRevision_(0)
 {
     // Force shadowing mode if graphics subsystem does not exist
     if (!graphics_)
@@ -105,6 +106,7 @@ void IndexBuffer::SetShadowed(bool enable)
             shadowData_.Reset();
         
         shadowed_ = enable;
+        ++dataRevision_;
     }
 }
 
@@ -131,6 +133,7 @@ bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
     else
         shadowData_.Reset();
     
+    ++dataRevision_;
     return Create();
 }
 
@@ -148,6 +151,7 @@ bool IndexBuffer::SetData(const void* data)
         return false;
     }
     
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, indexCount_ * indexSize_);
     
@@ -200,6 +204,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     if (!count)
         return true;
     
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * indexSize_ != data)
         memcpy(shadowData_.Get() + start * indexSize_, data, count * indexSize_);
     
@@ -59,7 +59,8 @@ VertexBuffer::VertexBuffer(Context* context) :
     lockStart_(0),
     lockCount_(0),
     lockScratchData_(0),
-    shadowed_(false)
+    shadowed_(false),
+    dataRevision_(0)
 {
     UpdateOffsets();
     
@@ -126,6 +127,7 @@ void VertexBuffer::SetShadowed(bool enable)
             shadowData_.Reset();
         
         shadowed_ = enable;
+        ++dataRevision_;
     }
 }
 
@@ -154,6 +156,7 @@ bool VertexBuffer::SetSize(unsigned vertexCount, unsigned elementMask, bool dyna
     else
         shadowData_.Reset();
     
+    ++dataRevision_;
     return Create();
 }
 
@@ -171,6 +174,7 @@ bool VertexBuffer::SetData(const void* data)
         return false;
     }
     
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, vertexCount_ * vertexSize_);
     
@@ -223,6 +227,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     if (!count)
         return true;
     
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * vertexSize_ != data)
         memcpy(shadowData_.Get() + start * vertexSize_, data, count * vertexSize_);
     
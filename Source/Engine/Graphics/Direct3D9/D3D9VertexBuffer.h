@@ -80,6 +80,8 @@ public:
     unsigned char* GetShadowData() const { return shadowData_.Get(); }
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<unsigned char> GetShadowDataShared() const { return shadowData_; }
+    /// Return data revision. Incremented whenever the buffer contents may have changed.
+    unsigned GetDataRevision() const { return dataRevision_; }
 
     /// Return vertex size corresponding to a vertex element mask.
     static unsigned GetVertexSize(unsigned elementMask);
@@ -125,6 +127,8 @@ private:
     void* lockScratchData_;
     /// Shadowed flag.
     bool shadowed_;
+    /// Data revision.
+    unsigned dataRevision_;
 };
 
 }
@@ -385,7 +385,11 @@ void Drawable::AddToOctree()
     {
         Octree* octree = scene->GetComponent<Octree>();
         if (octree)
+        {
             octree->InsertDrawable(this);
+            if (drawableFlags_ & CHANGE_TRACKED_DRAWABLES)
+                octree->MarkChanged(GetWorldBoundingBox());
+        }
         else
             LOGERROR("No Octree component in scene, drawable will not render");
     }
@@ -403,6 +407,9 @@ void Drawable::RemoveFromOctree()
         Octree* octree = octant_->GetRoot();
         if (updateQueued_)
             octree->CancelUpdate(this);
+        // Can not recalculate the bounding box here, as this may be called from the destructor
+        if ((drawableFlags_ & CHANGE_TRACKED_DRAWABLES) && worldBoundingBox_.defined_)
+            octree->MarkChanged(worldBoundingBox_);
         
         // Perform subclass specific deinitialization if necessary
         OnRemoveFromOctree();
@@ -411,4 +418,9 @@ void Drawable::RemoveFromOctree()
     }
 }
 
+bool Drawable::GetSkipPresentationUpdates() const
+{
+    return octant_ && octant_->GetRoot()->GetSkipPresentationUpdates();
+}
+
 }
@@ -275,6 +275,8 @@ protected:
     void AddToOctree();
     /// Remove from octree.
     void RemoveFromOctree();
+    /// Return whether the octree skips presentation-only updates, as in the engine's dedicated server profile.
+    bool GetSkipPresentationUpdates() const;
     /// Move into another octree octant.
     void SetOctant(Octant* octant) { octant_ = octant; }
     
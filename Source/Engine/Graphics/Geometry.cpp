@@ -33,6 +33,9 @@
 namespace Urho3D
 {
 
+/// Minimum number of triangles for building a BVH for raycasts instead of testing all triangles.
+static const unsigned HIT_BVH_MIN_TRIANGLES = 64;
+
 Geometry::Geometry(Context* context) :
     Object(context),
     primitiveType_(TRIANGLE_LIST),
@@ -44,7 +47,16 @@ Geometry::Geometry(Context* context) :
     rawVertexSize_(0),
     rawElementMask_(0),
     rawIndexSize_(0),
-    lodDistance_(0.0f)
+    rawDataRevision_(0),
+    lodDistance_(0.0f),
+    hitBVHVertexData_(0),
+    hitBVHIndexData_(0),
+    hitBVHVertexSize_(0),
+    hitBVHIndexSize_(0),
+    hitBVHStart_(0),
+    hitBVHCount_(0),
+    hitBVHVertexRevision_(0),
+    hitBVHIndexRevision_(0)
 {
     SetNumVertexBuffers(1);
 }
@@ -175,12 +187,15 @@ void Geometry::SetRawVertexData(SharedArrayPtr<unsigned char> data, unsigned ver
     rawVertexData_ = data;
     rawVertexSize_ = vertexSize;
     rawElementMask_ = elementMask;
+    // The data may have been modified in place, so make the raycast BVH out of date
+    ++rawDataRevision_;
 }
 
 void Geometry::SetRawIndexData(SharedArrayPtr<unsigned char> data, unsigned indexSize)
 {
     rawIndexData_ = data;
     rawIndexSize_ = indexSize;
+    ++rawDataRevision_;
 }
 
 void Geometry::Draw(Graphics* graphics)
@@ -346,7 +361,12 @@ float Geometry::GetHitDistance(const Ray& ray, Vector3* outNormal) const
     
     GetRawData(vertexData, vertexSize, indexData, indexSize, elementMask);
     
-    if (vertexData && indexData)
+    if (vertexData && primitiveType_ == TRIANGLE_LIST && (indexData ? indexCount_ : vertexCount_) >= HIT_BVH_MIN_TRIANGLES * 3)
+    {
+        UpdateHitBVH(vertexData, vertexSize, indexData, indexSize);
+        return hitBVH_.HitDistance(ray, outNormal);
+    }
+    else if (vertexData && indexData)
         return ray.HitDistance(vertexData, vertexSize, indexData, indexSize, indexStart_, indexCount_, outNormal);
     else if (vertexData)
         return ray.HitDistance(vertexData, vertexSize, vertexStart_, vertexCount_, outNormal);
@@ -387,4 +407,35 @@ void Geometry::GetPositionBufferIndex()
     positionBufferIndex_ = M_MAX_UNSIGNED;
 }
 
+void Geometry::UpdateHitBVH(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData, unsigned indexSize) const
+{
+    unsigned start = indexData ? indexStart_ : vertexStart_;
+    unsigned count = indexData ? indexCount_ : vertexCount_;
+    unsigned vertexRevision = rawVertexData_ ? rawDataRevision_ : (positionBufferIndex_ < vertexBuffers_.Size() ?
+        vertexBuffers_[positionBufferIndex_]->GetDataRevision() : 0);
+    unsigned indexRevision = rawIndexData_ ? rawDataRevision_ : (indexBuffer_ ? indexBuffer_->GetDataRevision() : 0);
+    
+    // Raycasts may run in worker threads, so the first one to find the BVH out of date builds it while the others wait
+    MutexLock lock(hitBVHMutex_);
+    
+    if (!hitBVH_.IsEmpty() && vertexData == hitBVHVertexData_ && indexData == hitBVHIndexData_ && vertexSize == hitBVHVertexSize_ &&
+        indexSize == hitBVHIndexSize_ && start == hitBVHStart_ && count == hitBVHCount_ && vertexRevision == hitBVHVertexRevision_ &&
+        indexRevision == hitBVHIndexRevision_)
+        return;
+    
+    if (indexData)
+        hitBVH_.Define(vertexData, vertexSize, indexData, indexSize, start, count);
+    else
+        hitBVH_.Define(vertexData, vertexSize, start, count);
+    
+    hitBVHVertexData_ = vertexData;
+    hitBVHIndexData_ = indexData;
+    hitBVHVertexSize_ = vertexSize;
+    hitBVHIndexSize_ = indexSize;
+    hitBVHStart_ = start;
+    hitBVHCount_ = count;
+    hitBVHVertexRevision_ = vertexRevision;
+    hitBVHIndexRevision_ = indexRevision;
+}
+
 }
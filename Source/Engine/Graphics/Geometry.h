@@ -24,7 +24,9 @@
 
 #include "ArrayPtr.h"
 #include "GraphicsDefs.h"
+#include "Mutex.h"
 #include "Object.h"
+#include "TriangleBVH.h"
 
 namespace Urho3D
 {
@@ -94,7 +96,7 @@ public:
     void GetRawData(const unsigned char*& vertexData, unsigned& vertexSize, const unsigned char*& indexData, unsigned& indexSize, unsigned& elementMask) const;
     /// Return raw vertex and index data for CPU operations, or null pointers if not available.
     void GetRawDataShared(SharedArrayPtr<unsigned char>& vertexData, unsigned& vertexSize, SharedArrayPtr<unsigned char>& indexData, unsigned& indexSize, unsigned& elementMask) const;
-    /// Return ray hit distance or infinity if no hit. Requires raw data to be set. Optionally return hit normal.
+    /// Return ray hit distance or infinity if no hit. Requires raw data to be set. Optionally return hit normal. Large triangle lists are tested using a BVH that is built on first use and rebuilt when the data changes. Raw data overrides must be set again after modifying them, which is enough even with the same data pointer.
     float GetHitDistance(const Ray& ray, Vector3* outNormal = 0) const;
     /// Return whether or not the ray is inside geometry.
     bool IsInside(const Ray& ray) const;
@@ -104,6 +106,8 @@ public:
 private:
     /// Locate vertex buffer with position data.
     void GetPositionBufferIndex();
+    /// Build the raycast BVH if the raw data or draw range has changed since it was last built.
+    void UpdateHitBVH(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData, unsigned indexSize) const;
     
     /// Vertex buffers.
     Vector<SharedPtr<VertexBuffer> > vertexBuffers_;
@@ -133,8 +137,30 @@ private:
     unsigned rawElementMask_;
     /// Raw index data override size.
     unsigned rawIndexSize_;
+    /// Number of times the raw data overrides have been set.
+    unsigned rawDataRevision_;
     /// LOD distance.
     float lodDistance_;
+    /// Triangle BVH for raycasts.
+    mutable TriangleBVH hitBVH_;
+    /// Raycast BVH build mutex.
+    mutable Mutex hitBVHMutex_;
+    /// Vertex data the raycast BVH was built from.
+    mutable const unsigned char* hitBVHVertexData_;
+    /// Index data the raycast BVH was built from.
+    mutable const unsigned char* hitBVHIndexData_;
+    /// Vertex size the raycast BVH was built with.
+    mutable unsigned hitBVHVertexSize_;
+    /// Index size the raycast BVH was built with.
+    mutable unsigned hitBVHIndexSize_;
+    /// Draw range start the raycast BVH was built with.
+    mutable unsigned hitBVHStart_;
+    /// Draw range count the raycast BVH was built with.
+    mutable unsigned hitBVHCount_;
+    /// Vertex buffer data revision the raycast BVH was built from.
+    mutable unsigned hitBVHVertexRevision_;
+    /// Index buffer data revision the raycast BVH was built from.
+    mutable unsigned hitBVHIndexRevision_;
 };
 
 }
@@ -29,63 +29,65 @@
 namespace Urho3D
 {
 
-StringHash VSP_AMBIENTSTARTCOLOR("AmbientStartColor");
-StringHash VSP_AMBIENTENDCOLOR("AmbientEndColor");
-StringHash VSP_BILLBOARDROT("BillboardRot");
-StringHash VSP_CAMERAPOS("CameraPos");
-StringHash VSP_CAMERAROT("CameraRot");
-StringHash VSP_NEARCLIP("NearClip");
-StringHash VSP_FARCLIP("FarClip");
-StringHash VSP_DEPTHMODE("DepthMode");
-StringHash VSP_DELTATIME("DeltaTime");
-StringHash VSP_ELAPSEDTIME("ElapsedTime");
-StringHash VSP_FRUSTUMSIZE("FrustumSize");
-StringHash VSP_GBUFFEROFFSETS("GBufferOffsets");
-StringHash VSP_LIGHTDIR("LightDir");
-StringHash VSP_LIGHTPOS("LightPos");
-StringHash VSP_MODEL("Model");
-StringHash VSP_VIEWPROJ("ViewProj");
-StringHash VSP_UOFFSET("UOffset");
-StringHash VSP_VOFFSET("VOffset");
-StringHash VSP_ZONE("Zone");
-StringHash VSP_LIGHTMATRICES("LightMatrices");
-StringHash VSP_SKINMATRICES("SkinMatrices");
-StringHash VSP_VERTEXLIGHTS("VertexLights");
-StringHash PSP_AMBIENTCOLOR("AmbientColor");
-StringHash PSP_CAMERAPOS("CameraPosPS");
-StringHash PSP_DELTATIME("DeltaTimePS");
-StringHash PSP_ELAPSEDTIME("ElapsedTimePS");
-StringHash PSP_FOGCOLOR("FogColor");
-StringHash PSP_FOGPARAMS("FogParams");
-StringHash PSP_GBUFFERINVSIZE("GBufferInvSize");
-StringHash PSP_LIGHTCOLOR("LightColor");
-StringHash PSP_LIGHTDIR("LightDirPS");
-StringHash PSP_LIGHTPOS("LightPosPS");
-StringHash PSP_MATDIFFCOLOR("MatDiffColor");
-StringHash PSP_MATEMISSIVECOLOR("MatEmissiveColor");
-StringHash PSP_MATENVMAPECOLOR("MatEnvMapColor");
-StringHash PSP_MATSPECCOLOR("MatSpecColor");
-StringHash PSP_NEARCLIP("NearClipPS");
-StringHash PSP_FARCLIP("FarClipPS");
-StringHash PSP_SHADOWCUBEADJUST("ShadowCubeAdjust");
-StringHash PSP_SHADOWDEPTHFADE("ShadowDepthFade");
-StringHash PSP_SHADOWINTENSITY("ShadowIntensity");
-StringHash PSP_SHADOWMAPINVSIZE("ShadowMapInvSize");
-StringHash PSP_SHADOWSPLITS("ShadowSplits");
-StringHash PSP_LIGHTMATRICES("LightMatricesPS");
+#ifndef URHO3D_CXX11
+const StringHash VSP_AMBIENTSTARTCOLOR("AmbientStartColor");
+const StringHash VSP_AMBIENTENDCOLOR("AmbientEndColor");
+const StringHash VSP_BILLBOARDROT("BillboardRot");
+const StringHash VSP_CAMERAPOS("CameraPos");
+const StringHash VSP_CAMERAROT("CameraRot");
+const StringHash VSP_NEARCLIP("NearClip");
+const StringHash VSP_FARCLIP("FarClip");
+const StringHash VSP_DEPTHMODE("DepthMode");
+const StringHash VSP_DELTATIME("DeltaTime");
+const StringHash VSP_ELAPSEDTIME("ElapsedTime");
+const StringHash VSP_FRUSTUMSIZE("FrustumSize");
+const StringHash VSP_GBUFFEROFFSETS("GBufferOffsets");
+const StringHash VSP_LIGHTDIR("LightDir");
+const StringHash VSP_LIGHTPOS("LightPos");
+const StringHash VSP_MODEL("Model");
+const StringHash VSP_VIEWPROJ("ViewProj");
+const StringHash VSP_UOFFSET("UOffset");
+const StringHash VSP_VOFFSET("VOffset");
+const StringHash VSP_ZONE("Zone");
+const StringHash VSP_LIGHTMATRICES("LightMatrices");
+const StringHash VSP_SKINMATRICES("SkinMatrices");
+const StringHash VSP_VERTEXLIGHTS("VertexLights");
+const StringHash PSP_AMBIENTCOLOR("AmbientColor");
+const StringHash PSP_CAMERAPOS("CameraPosPS");
+const StringHash PSP_DELTATIME("DeltaTimePS");
+const StringHash PSP_ELAPSEDTIME("ElapsedTimePS");
+const StringHash PSP_FOGCOLOR("FogColor");
+const StringHash PSP_FOGPARAMS("FogParams");
+const StringHash PSP_GBUFFERINVSIZE("GBufferInvSize");
+const StringHash PSP_LIGHTCOLOR("LightColor");
+const StringHash PSP_LIGHTDIR("LightDirPS");
+const StringHash PSP_LIGHTPOS("LightPosPS");
+const StringHash PSP_MATDIFFCOLOR("MatDiffColor");
+const StringHash PSP_MATEMISSIVECOLOR("MatEmissiveColor");
+const StringHash PSP_MATENVMAPCOLOR("MatEnvMapColor");
+const StringHash PSP_MATSPECCOLOR("MatSpecColor");
+const StringHash PSP_NEARCLIP("NearClipPS");
+const StringHash PSP_FARCLIP("FarClipPS");
+const StringHash PSP_SHADOWCUBEADJUST("ShadowCubeAdjust");
+const StringHash PSP_SHADOWDEPTHFADE("ShadowDepthFade");
+const StringHash PSP_SHADOWINTENSITY("ShadowIntensity");
+const StringHash PSP_SHADOWMAPINVSIZE("ShadowMapInvSize");
+const StringHash PSP_SHADOWSPLITS("ShadowSplits");
+const StringHash PSP_LIGHTMATRICES("LightMatricesPS");
 
-StringHash PASS_BASE("base");
-StringHash PASS_LITBASE("litbase");
-StringHash PASS_LIGHT("light");
-StringHash PASS_ALPHA("alpha");
-StringHash PASS_LITALPHA("litalpha");
-StringHash PASS_SHADOW("shadow");
-StringHash PASS_DEFERRED("deferred");
-StringHash PASS_PREPASS("prepass");
-StringHash PASS_MATERIAL("material");
-StringHash PASS_POSTOPAQUE("postopaque");
-StringHash PASS_REFRACT("refract");
-StringHash PASS_POSTALPHA("postalpha");
+const StringHash PASS_BASE("base");
+const StringHash PASS_LITBASE("litbase");
+const StringHash PASS_LIGHT("light");
+const StringHash PASS_ALPHA("alpha");
+const StringHash PASS_LITALPHA("litalpha");
+const StringHash PASS_SHADOW("shadow");
+const StringHash PASS_DEFERRED("deferred");
+const StringHash PASS_PREPASS("prepass");
+const StringHash PASS_MATERIAL("material");
+const StringHash PASS_POSTOPAQUE("postopaque");
+const StringHash PASS_REFRACT("refract");
+const StringHash PASS_POSTALPHA("postalpha");
+#endif
 
 Vector3 DOT_SCALE(1 / 3.0f, 1 / 3.0f, 1 / 3.0f);
 
@@ -258,65 +258,73 @@ enum FaceCameraMode
     FC_LOOKAT_Y
 };
 
+#ifdef URHO3D_CXX11
+/// Declare an inbuilt shader parameter or pass hash. Evaluated at compile time with C++11.
+#define BUILTIN_HASH(id, name) static STRINGHASH_CONSTANT(id, name)
+#else
+/// Declare an inbuilt shader parameter or pass hash. Defined in GraphicsDefs.cpp.
+#define BUILTIN_HASH(id, name) extern const StringHash id
+#endif
+
 // Inbuilt shader parameters.
-extern StringHash VSP_AMBIENTSTARTCOLOR;
-extern StringHash VSP_AMBIENTENDCOLOR;
-extern StringHash VSP_BILLBOARDROT;
-extern StringHash VSP_CAMERAPOS;
-extern StringHash VSP_CAMERAROT;
-extern StringHash VSP_NEARCLIP;
-extern StringHash VSP_FARCLIP;
-extern StringHash VSP_DEPTHMODE;
-extern StringHash VSP_DELTATIME;
-extern StringHash VSP_ELAPSEDTIME;
-extern StringHash VSP_FRUSTUMSIZE;
-extern StringHash VSP_GBUFFEROFFSETS;
-extern StringHash VSP_LIGHTDIR;
-extern StringHash VSP_LIGHTPOS;
-extern StringHash VSP_MODEL;
-extern StringHash VSP_VIEWPROJ;
-extern StringHash VSP_UOFFSET;
-extern StringHash VSP_VOFFSET;
-extern StringHash VSP_ZONE;
-extern StringHash VSP_LIGHTMATRICES;
-extern StringHash VSP_SKINMATRICES;
-extern StringHash VSP_VERTEXLIGHTS;
-extern StringHash PSP_AMBIENTCOLOR;
-extern StringHash PSP_CAMERAPOS;
-extern StringHash PSP_DELTATIME;
-extern StringHash PSP_ELAPSEDTIME;
-extern StringHash PSP_FOGCOLOR;
-extern StringHash PSP_FOGPARAMS;
-extern StringHash PSP_GBUFFERINVSIZE;
-extern StringHash PSP_LIGHTCOLOR;
-extern StringHash PSP_LIGHTDIR;
-extern StringHash PSP_LIGHTPOS;
-extern StringHash PSP_MATDIFFCOLOR;
-extern StringHash PSP_MATEMISSIVECOLOR;
-extern StringHash PSP_MATENVMAPCOLOR;
-extern StringHash PSP_MATSPECCOLOR;
-extern StringHash PSP_NEARCLIP;
-extern StringHash PSP_FARCLIP;
-extern StringHash PSP_SHADOWCUBEADJUST;
-extern StringHash PSP_SHADOWDEPTHFADE;
-extern StringHash PSP_SHADOWINTENSITY;
-extern StringHash PSP_SHADOWMAPINVSIZE;
-extern StringHash PSP_SHADOWSPLITS;
-extern StringHash PSP_LIGHTMATRICES;
+BUILTIN_HASH(VSP_AMBIENTSTARTCOLOR, "AmbientStartColor");
+BUILTIN_HASH(VSP_AMBIENTENDCOLOR, "AmbientEndColor");
+BUILTIN_HASH(VSP_BILLBOARDROT, "BillboardRot");
+BUILTIN_HASH(VSP_CAMERAPOS, "CameraPos");
+BUILTIN_HASH(VSP_CAMERAROT, "CameraRot");
+BUILTIN_HASH(VSP_NEARCLIP, "NearClip");
+BUILTIN_HASH(VSP_FARCLIP, "FarClip");
+BUILTIN_HASH(VSP_DEPTHMODE, "DepthMode");
+BUILTIN_HASH(VSP_DELTATIME, "DeltaTime");
+BUILTIN_HASH(VSP_ELAPSEDTIME, "ElapsedTime");
+BUILTIN_HASH(VSP_FRUSTUMSIZE, "FrustumSize");
+BUILTIN_HASH(VSP_GBUFFEROFFSETS, "GBufferOffsets");
+BUILTIN_HASH(VSP_LIGHTDIR, "LightDir");
+BUILTIN_HASH(VSP_LIGHTPOS, "LightPos");
+BUILTIN_HASH(VSP_MODEL, "Model");
+BUILTIN_HASH(VSP_VIEWPROJ, "ViewProj");
+BUILTIN_HASH(VSP_UOFFSET, "UOffset");
+BUILTIN_HASH(VSP_VOFFSET, "VOffset");
+BUILTIN_HASH(VSP_ZONE, "Zone");
+BUILTIN_HASH(VSP_LIGHTMATRICES, "LightMatrices");
+BUILTIN_HASH(VSP_SKINMATRICES, "SkinMatrices");
+BUILTIN_HASH(VSP_VERTEXLIGHTS, "VertexLights");
+BUILTIN_HASH(PSP_AMBIENTCOLOR, "AmbientColor");
+BUILTIN_HASH(PSP_CAMERAPOS, "CameraPosPS");
+BUILTIN_HASH(PSP_DELTATIME, "DeltaTimePS");
+BUILTIN_HASH(PSP_ELAPSEDTIME, "ElapsedTimePS");
+BUILTIN_HASH(PSP_FOGCOLOR, "FogColor");
+BUILTIN_HASH(PSP_FOGPARAMS, "FogParams");
+BUILTIN_HASH(PSP_GBUFFERINVSIZE, "GBufferInvSize");
+BUILTIN_HASH(PSP_LIGHTCOLOR, "LightColor");
+BUILTIN_HASH(PSP_LIGHTDIR, "LightDirPS");
+BUILTIN_HASH(PSP_LIGHTPOS, "LightPosPS");
+BUILTIN_HASH(PSP_MATDIFFCOLOR, "MatDiffColor");
+BUILTIN_HASH(PSP_MATEMISSIVECOLOR, "MatEmissiveColor");
+BUILTIN_HASH(PSP_MATENVMAPCOLOR, "MatEnvMapColor");
+BUILTIN_HASH(PSP_MATSPECCOLOR, "MatSpecColor");
+BUILTIN_HASH(PSP_NEARCLIP, "NearClipPS");
+BUILTIN_HASH(PSP_FARCLIP, "FarClipPS");
+BUILTIN_HASH(PSP_SHADOWCUBEADJUST, "ShadowCubeAdjust");
+BUILTIN_HASH(PSP_SHADOWDEPTHFADE, "ShadowDepthFade");
+BUILTIN_HASH(PSP_SHADOWINTENSITY, "ShadowIntensity");
+BUILTIN_HASH(PSP_SHADOWMAPINVSIZE, "ShadowMapInvSize");
+BUILTIN_HASH(PSP_SHADOWSPLITS, "ShadowSplits");
+BUILTIN_HASH(PSP_LIGHTMATRICES, "LightMatricesPS");
 
 // Inbuilt pass types
-extern StringHash PASS_BASE;
-extern StringHash PASS_LITBASE;
-extern StringHash PASS_LIGHT;
-extern StringHash PASS_ALPHA;
-extern StringHash PASS_LITALPHA;
-extern StringHash PASS_SHADOW;
-extern StringHash PASS_DEFERRED;
-extern StringHash PASS_PREPASS;
-extern StringHash PASS_MATERIAL;
-extern StringHash PASS_POSTOPAQUE;
-extern StringHash PASS_REFRACT;
-extern StringHash PASS_POSTALPHA;
+BUILTIN_HASH(PASS_BASE, "base");
+BUILTIN_HASH(PASS_LITBASE, "litbase");
+BUILTIN_HASH(PASS_LIGHT, "light");
+BUILTIN_HASH(PASS_ALPHA, "alpha");
+BUILTIN_HASH(PASS_LITALPHA, "litalpha");
+BUILTIN_HASH(PASS_SHADOW, "shadow");
+BUILTIN_HASH(PASS_DEFERRED, "deferred");
+BUILTIN_HASH(PASS_PREPASS, "prepass");
+BUILTIN_HASH(PASS_MATERIAL, "material");
+BUILTIN_HASH(PASS_POSTOPAQUE, "postopaque");
+BUILTIN_HASH(PASS_REFRACT, "refract");
+BUILTIN_HASH(PASS_POSTALPHA, "postalpha");
 
 // Scale calculation from bounding box diagonal.
 extern Vector3 DOT_SCALE;
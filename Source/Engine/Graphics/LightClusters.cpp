@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "Camera.h"
+#include "Light.h"
+#include "LightClusters.h"
+#include "Log.h"
+#include "Node.h"
+#include "Profiler.h"
+#include "Sphere.h"
+#include "WorkQueue.h"
+
+#include <cstring>
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Return the range of tiles that a view space interval overlaps along one screen axis, or false if none.
+static bool GetTileRange(float min, float max, float minZ, float maxZ, float scale, float offset, bool orthographic, unsigned numTiles,
+    unsigned& first, unsigned& last)
+{
+    float ndcMin;
+    float ndcMax;
+    
+    if (orthographic)
+    {
+        ndcMin = min * scale + offset;
+        ndcMax = max * scale + offset;
+    }
+    else
+    {
+        // With positive depth the projected coordinate is monotonic in both position and depth, so the extremes are at the corners
+        float a = min * scale / minZ;
+        float b = min * scale / maxZ;
+        float c = max * scale / minZ;
+        float d = max * scale / maxZ;
+        ndcMin = Min(Min(a, b), Min(c, d)) + offset;
+        ndcMax = Max(Max(a, b), Max(c, d)) + offset;
+    }
+    
+    if (ndcMax < -1.0f || ndcMin > 1.0f)
+        return false;
+    
+    first = (unsigned)Clamp((int)((ndcMin + 1.0f) * 0.5f * numTiles), 0, (int)numTiles - 1);
+    last = (unsigned)Clamp((int)((ndcMax + 1.0f) * 0.5f * numTiles), 0, (int)numTiles - 1);
+    return true;
+}
+
+void AssignLightClustersWork(const WorkItem* item, unsigned threadIndex)
+{
+    LightClusters* clusters = reinterpret_cast<LightClusters*>(item->aux_);
+    unsigned* base = &clusters->sliceAssignments_[0];
+    unsigned start = reinterpret_cast<unsigned*>(item->start_) - base;
+    unsigned end = reinterpret_cast<unsigned*>(item->end_) - base;
+    
+    clusters->AssignSlices(start, end);
+}
+
+LightClusters::LightClusters(Context* context) :
+    Object(context),
+    nearClip_(0.0f),
+    farClip_(0.0f),
+    sliceScale_(0.0f),
+    numX_(LIGHTCLUSTERS_DEFAULT_X),
+    numY_(LIGHTCLUSTERS_DEFAULT_Y),
+    numZ_(LIGHTCLUSTERS_DEFAULT_Z),
+    maxLightsPerCluster_(LIGHTCLUSTERS_DEFAULT_MAX_LIGHTS),
+    numAssignments_(0),
+    numOverflows_(0),
+    orthographic_(false)
+{
+    AllocateClusters();
+}
+
+LightClusters::~LightClusters()
+{
+}
+
+bool LightClusters::SetSize(unsigned numX, unsigned numY, unsigned numZ)
+{
+    if (!numX || !numY || !numZ || numX * numY * numZ > LIGHTCLUSTERS_MAX_CLUSTERS)
+    {
+        LOGERROR("Illegal light cluster grid size");
+        return false;
+    }
+    
+    numX_ = numX;
+    numY_ = numY;
+    numZ_ = numZ;
+    AllocateClusters();
+    return true;
+}
+
+void LightClusters::SetMaxLightsPerCluster(unsigned num)
+{
+    maxLightsPerCluster_ = (unsigned)Clamp((int)num, 1, 255);
+    AllocateClusters();
+}
+
+void LightClusters::Assign(Camera* camera, const PODVector<Light*>& lights)
+{
+    PROFILE(AssignLightClusters);
+    
+    if (!camera)
+    {
+        Clear();
+        return;
+    }
+    
+    projection_ = camera->GetProjection(false);
+    orthographic_ = camera->IsOrthographic();
+    nearClip_ = camera->GetNearClip();
+    farClip_ = camera->GetFarClip();
+    
+    // Perspective depth slices are spaced exponentially so that clusters stay roughly cubical, orthographic slices linearly
+    for (unsigned i = 0; i <= numZ_; ++i)
+    {
+        float t = (float)i / (float)numZ_;
+        sliceDepths_[i] = orthographic_ ? nearClip_ + (farClip_ - nearClip_) * t : nearClip_ * powf(farClip_ / nearClip_, t);
+    }
+    sliceDepths_[numZ_] = farClip_;
+    sliceScale_ = orthographic_ ? (float)numZ_ / (farClip_ - nearClip_) : (float)numZ_ / logf(farClip_ / nearClip_);
+    
+    // Prepare the lights on the calling thread, as their world transforms may need updating
+    const Matrix3x4& view = camera->GetView();
+    unsigned numLights = Min((int)lights.Size(), (int)LIGHTCLUSTERS_MAX_LIGHTS);
+    unsigned numPrepared = 0;
+    clusterLights_.Resize(numLights);
+    for (unsigned i = 0; i < numLights; ++i)
+    {
+        if (PrepareLight(clusterLights_[numPrepared], lights[i], view))
+        {
+            clusterLights_[numPrepared].index_ = i;
+            ++numPrepared;
+        }
+    }
+    clusterLights_.Resize(numPrepared);
+    
+    // Assign in worker threads, each handling a range of depth slices
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    if (queue)
+    {
+        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+        int slicesPerItem = Max((int)numZ_ / numWorkItems, 1);
+        
+        for (unsigned start = 0; start < numZ_;)
+        {
+            unsigned end = numZ_;
+            if (end - start > (unsigned)slicesPerItem * 2)
+                end = start + slicesPerItem;
+            
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = AssignLightClustersWork;
+            item->aux_ = this;
+            item->start_ = &sliceAssignments_[0] + start;
+            item->end_ = &sliceAssignments_[0] + end;
+            queue->AddWorkItem(item);
+            
+            start = end;
+        }
+        
+        queue->Complete(M_MAX_UNSIGNED);
+    }
+    else
+        AssignSlices(0, numZ_);
+    
+    numAssignments_ = 0;
+    numOverflows_ = 0;
+    for (unsigned i = 0; i < numZ_; ++i)
+    {
+        numAssignments_ += sliceAssignments_[i];
+        numOverflows_ += sliceOverflows_[i];
+    }
+}
+
+void LightClusters::Clear()
+{
+    clusterLights_.Clear();
+    if (lightCounts_.Size())
+        memset(&lightCounts_[0], 0, lightCounts_.Size());
+    numAssignments_ = 0;
+    numOverflows_ = 0;
+}
+
+unsigned LightClusters::GetClusterIndex(const Vector3& viewPosition) const
+{
+    unsigned z = GetSlice(viewPosition.z_);
+    if (z == M_MAX_UNSIGNED)
+        return M_MAX_UNSIGNED;
+    
+    Vector2 ndc = orthographic_ ? Vector2(viewPosition.x_ * projection_.m00_ + projection_.m03_, viewPosition.y_ *
+        projection_.m11_ + projection_.m13_) : Vector2(viewPosition.x_ * projection_.m00_ / viewPosition.z_ + projection_.m02_,
+        viewPosition.y_ * projection_.m11_ / viewPosition.z_ + projection_.m12_);
+    if (ndc.x_ < -1.0f || ndc.x_ > 1.0f || ndc.y_ < -1.0f || ndc.y_ > 1.0f)
+        return M_MAX_UNSIGNED;
+    
+    unsigned x = Min((int)((ndc.x_ + 1.0f) * 0.5f * numX_), (int)numX_ - 1);
+    unsigned y = Min((int)((ndc.y_ + 1.0f) * 0.5f * numY_), (int)numY_ - 1);
+    return GetClusterIndex(x, y, z);
+}
+
+unsigned LightClusters::GetSlice(float depth) const
+{
+    if (sliceDepths_.Empty() || depth < sliceDepths_[0] || depth > sliceDepths_[numZ_] || sliceScale_ == 0.0f)
+        return M_MAX_UNSIGNED;
+    
+    float slice = orthographic_ ? (depth - nearClip_) * sliceScale_ : logf(depth / nearClip_) * sliceScale_;
+    return (unsigned)Clamp((int)slice, 0, (int)numZ_ - 1);
+}
+
+void LightClusters::AllocateClusters()
+{
+    unsigned numClusters = GetNumClusters();
+    clusterBoxes_.Resize(numClusters);
+    lightCounts_.Resize(numClusters);
+    lightIndices_.Resize(numClusters * maxLightsPerCluster_);
+    sliceDepths_.Resize(numZ_ + 1);
+    sliceAssignments_.Resize(numZ_);
+    sliceOverflows_.Resize(numZ_);
+    
+    for (unsigned i = 0; i <= numZ_; ++i)
+        sliceDepths_[i] = 0.0f;
+    sliceScale_ = 0.0f;
+    Clear();
+}
+
+bool LightClusters::PrepareLight(ClusterLight& dest, Light* light, const Matrix3x4& view) const
+{
+    if (!light || !light->GetNode())
+        return false;
+    
+    switch (light->GetLightType())
+    {
+    case LIGHT_POINT:
+        dest.center_ = view * light->GetNode()->GetWorldPosition();
+        dest.radius_ = light->GetRange();
+        dest.box_.Define(dest.center_ - Vector3(dest.radius_, dest.radius_, dest.radius_), dest.center_ + Vector3(dest.radius_,
+            dest.radius_, dest.radius_));
+        dest.spot_ = false;
+        break;
+        
+    case LIGHT_SPOT:
+        dest.frustum_ = light->GetFrustum().Transformed(view);
+        dest.box_.Define(dest.frustum_);
+        dest.spot_ = true;
+        break;
+        
+    default:
+        return false;
+    }
+    
+    // Clip the depth range to the view; the part in front of the near plane does not belong to any cluster
+    float minZ = Max(dest.box_.min_.z_, sliceDepths_[0]);
+    float maxZ = Min(dest.box_.max_.z_, sliceDepths_[numZ_]);
+    if (minZ > maxZ || (!orthographic_ && maxZ <= 0.0f))
+        return false;
+    
+    dest.minZ_ = GetSlice(minZ);
+    dest.maxZ_ = GetSlice(maxZ);
+    if (dest.minZ_ == M_MAX_UNSIGNED || dest.maxZ_ == M_MAX_UNSIGNED)
+        return false;
+    
+    return GetTileRange(dest.box_.min_.x_, dest.box_.max_.x_, minZ, maxZ, projection_.m00_, orthographic_ ? projection_.m03_ :
+        projection_.m02_, orthographic_, numX_, dest.minX_, dest.maxX_) && GetTileRange(dest.box_.min_.y_, dest.box_.max_.y_, minZ,
+        maxZ, projection_.m11_, orthographic_ ? projection_.m13_ : projection_.m12_, orthographic_, numY_, dest.minY_, dest.maxY_);
+}
+
+BoundingBox LightClusters::CalculateClusterBox(unsigned x, unsigned y, unsigned z) const
+{
+    float ndcMinX = -1.0f + 2.0f * x / numX_;
+    float ndcMaxX = -1.0f + 2.0f * (x + 1) / numX_;
+    float ndcMinY = -1.0f + 2.0f * y / numY_;
+    float ndcMaxY = -1.0f + 2.0f * (y + 1) / numY_;
+    float nearZ = sliceDepths_[z];
+    float farZ = sliceDepths_[z + 1];
+    
+    if (orthographic_)
+    {
+        return BoundingBox(Vector3((ndcMinX - projection_.m03_) / projection_.m00_, (ndcMinY - projection_.m13_) / projection_.m11_,
+            nearZ), Vector3((ndcMaxX - projection_.m03_) / projection_.m00_, (ndcMaxY - projection_.m13_) / projection_.m11_, farZ));
+    }
+    else
+    {
+        // The tile widens with depth, so take the extremes over both the near and far depth of the slice
+        float minX = (ndcMinX - projection_.m02_) / projection_.m00_;
+        float maxX = (ndcMaxX - projection_.m02_) / projection_.m00_;
+        float minY = (ndcMinY - projection_.m12_) / projection_.m11_;
+        float maxY = (ndcMaxY - projection_.m12_) / projection_.m11_;
+        return BoundingBox(Vector3(Min(minX * nearZ, minX * farZ), Min(minY * nearZ, minY * farZ), nearZ), Vector3(Max(maxX * nearZ,
+            maxX * farZ), Max(maxY * nearZ, maxY * farZ), farZ));
+    }
+}
+
+void LightClusters::AssignSlices(unsigned start, unsigned end)
+{
+    for (unsigned z = start; z < end; ++z)
+    {
+        unsigned sliceStart = GetClusterIndex(0, 0, z);
+        unsigned sliceSize = numX_ * numY_;
+        unsigned assignments = 0;
+        unsigned overflows = 0;
+        
+        memset(&lightCounts_[sliceStart], 0, sliceSize);
+        for (unsigned y = 0; y < numY_; ++y)
+        {
+            for (unsigned x = 0; x < numX_; ++x)
+                clusterBoxes_[GetClusterIndex(x, y, z)] = CalculateClusterBox(x, y, z);
+        }
+        
+        for (Vector<ClusterLight>::ConstIterator i = clusterLights_.Begin(); i != clusterLights_.End(); ++i)
+        {
+            const ClusterLight& light = *i;
+            if (z < light.minZ_ || z > light.maxZ_)
+                continue;
+            
+            Sphere sphere(light.center_, light.radius_);
+            for (unsigned y = light.minY_; y <= light.maxY_; ++y)
+            {
+                for (unsigned x = light.minX_; x <= light.maxX_; ++x)
+                {
+                    unsigned cluster = GetClusterIndex(x, y, z);
+                    const BoundingBox& box = clusterBoxes_[cluster];
+                    if (light.spot_ ? light.frustum_.IsInsideFast(box) == OUTSIDE : box.IsInsideFast(sphere) == OUTSIDE)
+                        continue;
+                    
+                    unsigned char& count = lightCounts_[cluster];
+                    if (count < maxLightsPerCluster_)
+                    {
+                        lightIndices_[cluster * maxLightsPerCluster_ + count] = (unsigned short)light.index_;
+                        ++count;
+                        ++assignments;
+                    }
+                    else
+                        ++overflows;
+                }
+            }
+        }
+        
+        sliceAssignments_[z] = assignments;
+        sliceOverflows_[z] = overflows;
+    }
+}
+
+}
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "BoundingBox.h"
+#include "Frustum.h"
+#include "Matrix4.h"
+#include "Object.h"
+
+namespace Urho3D
+{
+
+class Camera;
+class Light;
+struct WorkItem;
+
+static const unsigned LIGHTCLUSTERS_DEFAULT_X = 16;
+static const unsigned LIGHTCLUSTERS_DEFAULT_Y = 8;
+static const unsigned LIGHTCLUSTERS_DEFAULT_Z = 24;
+static const unsigned LIGHTCLUSTERS_DEFAULT_MAX_LIGHTS = 32;
+static const unsigned LIGHTCLUSTERS_MAX_CLUSTERS = 65536;
+static const unsigned LIGHTCLUSTERS_MAX_LIGHTS = 65535;
+
+/// Point or spot light prepared for cluster assignment.
+struct ClusterLight
+{
+    /// View space bounding box.
+    BoundingBox box_;
+    /// View space bounding sphere center.
+    Vector3 center_;
+    /// View space frustum for spot lights.
+    Frustum frustum_;
+    /// Bounding sphere radius.
+    float radius_;
+    /// Index in the light list.
+    unsigned index_;
+    /// Spot light flag.
+    bool spot_;
+    /// First overlapped tile column.
+    unsigned minX_;
+    /// Last overlapped tile column.
+    unsigned maxX_;
+    /// First overlapped tile row.
+    unsigned minY_;
+    /// Last overlapped tile row.
+    unsigned maxY_;
+    /// First overlapped depth slice.
+    unsigned minZ_;
+    /// Last overlapped depth slice.
+    unsigned maxZ_;
+};
+
+/// %Light assignment to view frustum clusters for clustered forward rendering. The frustum is divided into a grid of screen tiles and exponentially spaced depth slices (linear for orthographic cameras), and the point and spot lights affecting each cluster are listed. Directional lights affect every cluster and are not stored.
+class URHO3D_API LightClusters : public Object
+{
+    OBJECT(LightClusters);
+    
+    friend void AssignLightClustersWork(const WorkItem* item, unsigned threadIndex);
+    
+public:
+    /// Construct.
+    LightClusters(Context* context);
+    /// Destruct.
+    virtual ~LightClusters();
+    
+    /// Set number of tile columns, tile rows and depth slices. Return true if successful.
+    bool SetSize(unsigned numX, unsigned numY, unsigned numZ);
+    /// Set maximum number of lights stored per cluster. Further lights are dropped and counted as overflows.
+    void SetMaxLightsPerCluster(unsigned num);
+    /// Assign lights to the clusters of a camera's view frustum. Lights are referred to by their index in the list. Uses worker threads.
+    void Assign(Camera* camera, const PODVector<Light*>& lights);
+    /// Remove all light assignments.
+    void Clear();
+    
+    /// Return number of tile columns.
+    unsigned GetNumX() const { return numX_; }
+    /// Return number of tile rows.
+    unsigned GetNumY() const { return numY_; }
+    /// Return number of depth slices.
+    unsigned GetNumZ() const { return numZ_; }
+    /// Return total number of clusters.
+    unsigned GetNumClusters() const { return numX_ * numY_ * numZ_; }
+    /// Return maximum number of lights stored per cluster.
+    unsigned GetMaxLightsPerCluster() const { return maxLightsPerCluster_; }
+    /// Return cluster index from tile column, tile row and depth slice. Tile rows start from the bottom of the view.
+    unsigned GetClusterIndex(unsigned x, unsigned y, unsigned z) const { return (z * numY_ + y) * numX_ + x; }
+    /// Return index of the cluster containing a view space position, or M_MAX_UNSIGNED if outside the view frustum.
+    unsigned GetClusterIndex(const Vector3& viewPosition) const;
+    /// Return depth slice containing a view space depth, or M_MAX_UNSIGNED if outside the depth range.
+    unsigned GetSlice(float depth) const;
+    /// Return view space depth where a depth slice starts. Slice index equal to the number of slices returns the far clip distance.
+    float GetSliceDepth(unsigned z) const { return z < sliceDepths_.Size() ? sliceDepths_[z] : 0.0f; }
+    /// Return number of lights in a cluster.
+    unsigned GetNumClusterLights(unsigned cluster) const { return cluster < lightCounts_.Size() ? lightCounts_[cluster] : 0; }
+    /// Return light indices of a cluster, or null if the cluster index is out of range.
+    const unsigned short* GetClusterLights(unsigned cluster) const { return cluster < lightCounts_.Size() ? &lightIndices_[cluster * maxLightsPerCluster_] : 0; }
+    /// Return light counts of all clusters.
+    const PODVector<unsigned char>& GetLightCounts() const { return lightCounts_; }
+    /// Return light indices of all clusters, in blocks of the maximum lights per cluster.
+    const PODVector<unsigned short>& GetLightIndices() const { return lightIndices_; }
+    /// Return number of point and spot lights assigned on the last update.
+    unsigned GetNumLights() const { return clusterLights_.Size(); }
+    /// Return total number of light to cluster assignments on the last update.
+    unsigned GetNumAssignments() const { return numAssignments_; }
+    /// Return number of assignments dropped on the last update because a cluster was full.
+    unsigned GetNumOverflows() const { return numOverflows_; }
+    
+private:
+    /// Allocate the cluster storage.
+    void AllocateClusters();
+    /// Prepare a point or spot light for assignment. Return false if it lies outside the view frustum.
+    bool PrepareLight(ClusterLight& dest, Light* light, const Matrix3x4& view) const;
+    /// Calculate view space bounding box of a cluster.
+    BoundingBox CalculateClusterBox(unsigned x, unsigned y, unsigned z) const;
+    /// Assign the prepared lights to the clusters of a range of depth slices.
+    void AssignSlices(unsigned start, unsigned end);
+    
+    /// Prepared point and spot lights.
+    Vector<ClusterLight> clusterLights_;
+    /// View space bounding boxes of the clusters.
+    Vector<BoundingBox> clusterBoxes_;
+    /// Depth slice start depths, followed by the far clip distance.
+    PODVector<float> sliceDepths_;
+    /// Light counts per cluster.
+    PODVector<unsigned char> lightCounts_;
+    /// Light indices per cluster.
+    PODVector<unsigned short> lightIndices_;
+    /// Assignments per depth slice on the last update.
+    PODVector<unsigned> sliceAssignments_;
+    /// Overflows per depth slice on the last update.
+    PODVector<unsigned> sliceOverflows_;
+    /// Projection matrix of the camera.
+    Matrix4 projection_;
+    /// Near clip distance of the camera.
+    float nearClip_;
+    /// Far clip distance of the camera.
+    float farClip_;
+    /// Multiplier for converting depth or its logarithm to a depth slice.
+    float sliceScale_;
+    /// Number of tile columns.
+    unsigned numX_;
+    /// Number of tile rows.
+    unsigned numY_;
+    /// Number of depth slices.
+    unsigned numZ_;
+    /// Maximum lights per cluster.
+    unsigned maxLightsPerCluster_;
+    /// Total assignments on the last update.
+    unsigned numAssignments_;
+    /// Dropped assignments on the last update.
+    unsigned numOverflows_;
+    /// Orthographic camera flag.
+    bool orthographic_;
+};
+
+}
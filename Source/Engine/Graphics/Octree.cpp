@@ -24,6 +24,7 @@
 #include "Context.h"
 #include "CoreEvents.h"
 #include "DebugRenderer.h"
+#include "Engine.h"
 #include "Graphics.h"
 #include "Log.h"
 #include "Profiler.h"
@@ -332,7 +333,9 @@ void Octant::GetDrawablesOnlyInternal(RayOctreeQuery& query, PODVector<Drawable*
 Octree::Octree(Context* context) :
     Component(context),
     Octant(BoundingBox(-DEFAULT_OCTREE_SIZE, DEFAULT_OCTREE_SIZE), 0, 0, this),
-    numLevels_(DEFAULT_OCTREE_LEVELS)
+    numLevels_(DEFAULT_OCTREE_LEVELS),
+    updateNumber_(0),
+    skipPresentationUpdates_(false)
 {
     // Resize threaded ray query intermediate result vector according to number of worker threads
     WorkQueue* workQueue = GetSubsystem<WorkQueue>();
@@ -341,7 +344,13 @@ Octree::Octree(Context* context) :
     // If the engine is running headless, subscribe to RenderUpdate events for manually updating the octree
     // to allow raycasts and animation update
     if (!GetSubsystem<Graphics>())
+    {
         SubscribeToEvent(E_RENDERUPDATE, HANDLER(Octree, HandleRenderUpdate));
+        
+        // In the dedicated server profile nothing will ever be viewed, so do not spend time on presentation-only updates
+        Engine* engine = GetSubsystem<Engine>();
+        skipPresentationUpdates_ = engine && engine->IsServerProfile();
+    }
 }
 
 Octree::~Octree()
@@ -462,6 +471,9 @@ void Octree::Update(const FrameInfo& frame)
             // Skip if no octant or does not belong to this octree anymore
             if (!octant || octant->GetRoot() != this)
                 continue;
+            // The region before the change was recorded when the update was queued
+            if (drawable->GetDrawableFlags() & CHANGE_TRACKED_DRAWABLES)
+                AddChangedBox(box);
             // Skip if still fits the current octant
             if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
                 continue;
@@ -481,6 +493,11 @@ void Octree::Update(const FrameInfo& frame)
     }
     
     drawableUpdates_.Clear();
+    
+    // Publish the changed regions for cached queries
+    changedBoxes_.Clear();
+    changedBoxes_.Swap(pendingChangedBoxes_);
+    ++updateNumber_;
 }
 
 void Octree::AddManualDrawable(Drawable* drawable)
@@ -489,6 +506,8 @@ void Octree::AddManualDrawable(Drawable* drawable)
         return;
 
     AddDrawable(drawable);
+    if (drawable->GetDrawableFlags() & CHANGE_TRACKED_DRAWABLES)
+        MarkChanged(drawable->GetWorldBoundingBox());
 }
 
 void Octree::RemoveManualDrawable(Drawable* drawable)
@@ -498,7 +517,11 @@ void Octree::RemoveManualDrawable(Drawable* drawable)
 
     Octant* octant = drawable->GetOctant();
     if (octant && octant->GetRoot() == this)
+    {
+        if (drawable->GetDrawableFlags() & CHANGE_TRACKED_DRAWABLES)
+            MarkChanged(drawable->GetWorldBoundingBox());
         octant->RemoveDrawable(drawable);
+    }
 }
 
 void Octree::GetDrawables(OctreeQuery& query) const
@@ -607,14 +630,23 @@ void Octree::RaycastSingle(RayOctreeQuery& query) const
 
 void Octree::QueueUpdate(Drawable* drawable)
 {
+    // The drawable's world bounding box has not been recalculated yet, so record the region it is about to leave
+    bool trackChange = (drawable->GetDrawableFlags() & CHANGE_TRACKED_DRAWABLES) && drawable->worldBoundingBox_.defined_;
+    
     Scene* scene = GetScene();
     if (scene && scene->IsThreadedUpdate())
     {
         MutexLock lock(octreeMutex_);
         drawableUpdates_.Push(drawable);
+        if (trackChange)
+            AddChangedBox(drawable->worldBoundingBox_);
     }
     else
+    {
         drawableUpdates_.Push(drawable);
+        if (trackChange)
+            AddChangedBox(drawable->worldBoundingBox_);
+    }
     
     drawable->updateQueued_ = true;
 }
@@ -625,12 +657,39 @@ void Octree::CancelUpdate(Drawable* drawable)
     drawable->updateQueued_ = false;
 }
 
+void Octree::MarkChanged(const BoundingBox& box)
+{
+    Scene* scene = GetScene();
+    if (scene && scene->IsThreadedUpdate())
+    {
+        MutexLock lock(octreeMutex_);
+        AddChangedBox(box);
+    }
+    else
+        AddChangedBox(box);
+}
+
 void Octree::DrawDebugGeometry(bool depthTest)
 {
     DebugRenderer* debug = GetComponent<DebugRenderer>();
     DrawDebugGeometry(debug, depthTest);
 }
 
+void Octree::AddChangedBox(const BoundingBox& box)
+{
+    // Merge into one conservative region if there are too many to check individually
+    if (pendingChangedBoxes_.Size() >= MAX_CHANGED_BOXES)
+    {
+        BoundingBox merged;
+        for (unsigned i = 0; i < pendingChangedBoxes_.Size(); ++i)
+            merged.Merge(pendingChangedBoxes_[i]);
+        pendingChangedBoxes_.Clear();
+        pendingChangedBoxes_.Push(merged);
+    }
+    
+    pendingChangedBoxes_.Push(box);
+}
+
 void Octree::HandleRenderUpdate(StringHash eventType, VariantMap& eventData)
 {
     // When running in headless mode, update the Octree manually during the RenderUpdate event
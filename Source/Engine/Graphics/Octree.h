@@ -34,6 +34,10 @@ class Octree;
 
 static const int NUM_OCTANTS = 8;
 static const unsigned ROOT_INDEX = M_MAX_UNSIGNED;
+/// Maximum number of changed regions recorded between octree updates before they are merged.
+static const unsigned MAX_CHANGED_BOXES = 256;
+/// Drawable flags of the drawable objects whose changes are recorded automatically.
+static const unsigned char CHANGE_TRACKED_DRAWABLES = DRAWABLE_GEOMETRY | DRAWABLE_PROXYGEOMETRY;
 
 /// %Octree octant
 class URHO3D_API Octant
@@ -187,17 +191,27 @@ public:
     void RaycastSingle(RayOctreeQuery& query) const;
     /// Return subdivision levels.
     unsigned GetNumLevels() const { return numLevels_; }
+    /// Return whether presentation-only drawable updates (animation of invisible models, particles) are skipped. True in the engine's dedicated server profile.
+    bool GetSkipPresentationUpdates() const { return skipPresentationUpdates_; }
+    /// Return number of updates performed.
+    unsigned GetUpdateNumber() const { return updateNumber_; }
+    /// Return regions changed between the previous and the last update. Cached geometry query results from before the last update remain valid if their volume does not intersect any of these.
+    const PODVector<BoundingBox>& GetChangedBoxes() const { return changedBoxes_; }
     
     /// Mark drawable object as requiring an update and a reinsertion.
     void QueueUpdate(Drawable* drawable);
     /// Cancel drawable object's update.
     void CancelUpdate(Drawable* drawable);
+    /// Record a region where drawable objects have been added, removed, moved or resized. Published on the next update.
+    void MarkChanged(const BoundingBox& box);
     /// Visualize the component as debug geometry.
     void DrawDebugGeometry(bool depthTest);
     
 private:
     /// Handle render update in case of headless execution.
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
+    /// Record a changed region without locking.
+    void AddChangedBox(const BoundingBox& box);
     
     /// Drawable objects that require update.
     PODVector<Drawable*> drawableUpdates_;
@@ -213,6 +227,14 @@ private:
     mutable Vector<PODVector<RayQueryResult> > rayQueryResults_;
     /// Subdivision level.
     unsigned numLevels_;
+    /// Regions changed between the previous and the last update.
+    PODVector<BoundingBox> changedBoxes_;
+    /// Regions changed since the last update.
+    PODVector<BoundingBox> pendingChangedBoxes_;
+    /// Number of updates performed.
+    unsigned updateNumber_;
+    /// Skip presentation-only drawable updates flag.
+    bool skipPresentationUpdates_;
 };
 
 }
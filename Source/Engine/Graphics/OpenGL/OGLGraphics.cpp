@@ -680,6 +680,14 @@ void Graphics::EndFrame()
     CleanupScratchBuffers();
 }
 
+void Graphics::Flush()
+{
+    if (!IsInitialized())
+        return;
+    
+    glFlush();
+}
+
 void Graphics::Clear(unsigned flags, const Color& color, float depth, unsigned stencil)
 {
     if (impl_->fboDirty_)
@@ -114,6 +114,8 @@ public:
     bool BeginFrame();
     /// End frame rendering and swap buffers.
     void EndFrame();
+    /// Submit the queued rendering commands to the GPU without waiting for them to finish.
+    void Flush();
     /// Clear any or all of rendertarget, depth buffer and stencil buffer.
     void Clear(unsigned flags, const Color& color = Color(0.0f, 0.0f, 0.0f, 0.0f), float depth = 1.0f, unsigned stencil = 0);
     /// Resolve multisampled backbuffer to a texture rendertarget. The texture's size should match the viewport size.
@@ -44,7 +44,8 @@ IndexBuffer::IndexBuffer(Context* context) :
     lockCount_(0),
     lockScratchData_(0),
     shadowed_(false),
-    dynamic_(false)
+    dynamic_(false),
+    dataRevision_(0)
 {
     // Force shadowing mode if graphics subsystem does not exist
     if (!graphics_)
@@ -104,6 +105,7 @@ void IndexBuffer::SetShadowed(bool enable)
             shadowData_.Reset();
         
         shadowed_ = enable;
+        ++dataRevision_;
     }
 }
 
@@ -120,6 +122,7 @@ bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
     else
         shadowData_.Reset();
     
+    ++dataRevision_;
     return Create();
 }
 
@@ -137,6 +140,7 @@ bool IndexBuffer::SetData(const void* data)
         return false;
     }
     
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, indexCount_ * indexSize_);
     
@@ -185,6 +189,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     if (!count)
         return true;
     
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * indexSize_ != data)
         memcpy(shadowData_.Get() + start * indexSize_, data, count * indexSize_);
     
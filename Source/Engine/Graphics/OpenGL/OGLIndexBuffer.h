@@ -75,6 +75,8 @@ public:
     unsigned char* GetShadowData() const { return shadowData_.Get(); }
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<unsigned char> GetShadowDataShared() const { return shadowData_; }
+    /// Return data revision. Incremented whenever the buffer contents may have changed.
+    unsigned GetDataRevision() const { return dataRevision_; }
     
 private:
     /// Create buffer.
@@ -100,6 +102,8 @@ private:
     bool shadowed_;
     /// Dynamic flag.
     bool dynamic_;
+    /// Data revision.
+    unsigned dataRevision_;
 };
 
 }
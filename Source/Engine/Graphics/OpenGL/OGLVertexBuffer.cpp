@@ -111,7 +111,8 @@ VertexBuffer::VertexBuffer(Context* context) :
     lockCount_(0),
     lockScratchData_(0),
     shadowed_(false),
-    dynamic_(false)
+    dynamic_(false),
+    dataRevision_(0)
 {
     UpdateOffsets();
     
@@ -176,6 +177,7 @@ void VertexBuffer::SetShadowed(bool enable)
             shadowData_.Reset();
         
         shadowed_ = enable;
+        ++dataRevision_;
     }
 }
 
@@ -194,6 +196,7 @@ bool VertexBuffer::SetSize(unsigned vertexCount, unsigned elementMask, bool dyna
     else
         shadowData_.Reset();
     
+    ++dataRevision_;
     return Create();
 }
 
@@ -211,6 +214,7 @@ bool VertexBuffer::SetData(const void* data)
         return false;
     }
     
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, vertexCount_ * vertexSize_);
     
@@ -258,6 +262,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     if (!count)
         return true;
     
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * vertexSize_ != data)
         memcpy(shadowData_.Get() + start * vertexSize_, data, count * vertexSize_);
     
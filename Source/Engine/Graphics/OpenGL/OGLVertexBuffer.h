@@ -76,6 +76,8 @@ public:
     unsigned char* GetShadowData() const { return shadowData_.Get(); }
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<unsigned char> GetShadowDataShared() const { return shadowData_; }
+    /// Return data revision. Incremented whenever the buffer contents may have changed.
+    unsigned GetDataRevision() const { return dataRevision_; }
     
     /// Return vertex size corresponding to a vertex element mask.
     static unsigned GetVertexSize(unsigned elementMask);
@@ -121,6 +123,8 @@ private:
     bool shadowed_;
     /// Dynamic flag.
     bool dynamic_;
+    /// Data revision.
+    unsigned dataRevision_;
 };
 
 }
@@ -466,6 +466,10 @@ void ParticleEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& ev
 
     lastTimeStep_ = eventData[P_TIMESTEP].GetFloat();
 
+    // Particles are never seen in the dedicated server profile, even if invisible update is enabled
+    if (GetSkipPresentationUpdates())
+        return;
+
     // If no invisible update, check that the billboardset is in view (framenumber has changed)
     if ((effect_ && effect_->GetUpdateInvisible()) || viewFrameNumber_ != lastUpdateFrameNumber_)
     {
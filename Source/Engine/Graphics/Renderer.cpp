@@ -277,6 +277,8 @@ Renderer::Renderer(Context* context) :
     drawShadows_(true),
     reuseShadowMaps_(true),
     dynamicInstancing_(true),
+    lightClustering_(false),
+    shadowCasterCaching_(true),
     shadersDirty_(true),
     initialized_(false)
 {
@@ -474,6 +476,16 @@ void Renderer::SetOccluderSizeThreshold(float screenSize)
     occluderSizeThreshold_ = Max(screenSize, 0.0f);
 }
 
+void Renderer::SetLightClustering(bool enable)
+{
+    lightClustering_ = enable;
+}
+
+void Renderer::SetShadowCasterCaching(bool enable)
+{
+    shadowCasterCaching_ = enable;
+}
+
 void Renderer::ReloadShaders()
 {
     shadersDirty_ = true;
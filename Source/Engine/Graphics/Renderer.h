@@ -205,6 +205,10 @@ public:
     void SetMobileShadowBiasMul(float mul);
     /// Set shadow depth bias addition for mobile platforms (OpenGL ES.)  No effect on desktops. Default 0.0001.
     void SetMobileShadowBiasAdd(float add);
+    /// Set assignment of point and spot lights to view frustum clusters on/off. Default off. The result can be queried from each view for clustered rendering.
+    void SetLightClustering(bool enable);
+    /// Set reuse of shadow caster queries across frames on/off. Default on. When the shadow camera and the view stay the same and no drawable changes inside a shadow split, its shadow casters are not searched again.
+    void SetShadowCasterCaching(bool enable);
     /// Force reload of shaders.
     void ReloadShaders();
     
@@ -254,6 +258,10 @@ public:
     float GetMobileShadowBiasMul() const { return mobileShadowBiasMul_; }
     /// Return shadow depth bias addition for mobile platforms.
     float GetMobileShadowBiasAdd() const { return mobileShadowBiasAdd_; }
+    /// Return whether light clustering is in use.
+    bool GetLightClustering() const { return lightClustering_; }
+    /// Return whether shadow caster queries are reused across frames.
+    bool GetShadowCasterCaching() const { return shadowCasterCaching_; }
     /// Return number of views rendered.
     unsigned GetNumViews() const { return numViews_; }
     /// Return number of primitives rendered.
@@ -479,6 +487,10 @@ private:
     bool reuseShadowMaps_;
     /// Dynamic instancing flag.
     bool dynamicInstancing_;
+    /// Light clustering flag.
+    bool lightClustering_;
+    /// Shadow caster caching flag.
+    bool shadowCasterCaching_;
     /// Shaders need reloading flag.
     bool shadersDirty_;
     /// Initialized flag.
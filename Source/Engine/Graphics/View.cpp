@@ -27,6 +27,7 @@
 #include "Geometry.h"
 #include "Graphics.h"
 #include "GraphicsImpl.h"
+#include "LightClusters.h"
 #include "Log.h"
 #include "Material.h"
 #include "OcclusionBuffer.h"
@@ -51,6 +52,13 @@
 namespace Urho3D
 {
 
+/// Minimum number of visible zones for building a spatial index for zone lookups instead of testing every zone.
+static const unsigned MIN_INDEXED_ZONES = 16;
+/// Target number of shadow caster processing work items per thread.
+static const unsigned SHADOW_CASTER_WORK_ITEMS_PER_THREAD = 4;
+/// Minimum number of potential shadow casters in a processing work item.
+static const int MIN_SHADOW_CASTERS_PER_WORK_ITEM = 64;
+
 static const Vector3* directions[] =
 {
     &Vector3::RIGHT,
@@ -241,7 +249,44 @@ void ProcessLightWork(const WorkItem* item, unsigned threadIndex)
     View* view = reinterpret_cast<View*>(item->aux_);
     LightQueryResult* query = reinterpret_cast<LightQueryResult*>(item->start_);
     
+    #ifdef URHO3D_PROFILING
+    HiresTimer timer;
+    #endif
     view->ProcessLight(*query, threadIndex);
+    #ifdef URHO3D_PROFILING
+    query->time_ = timer.GetUSec(false);
+    #endif
+}
+
+void ProcessShadowSplitWork(const WorkItem* item, unsigned threadIndex)
+{
+    View* view = reinterpret_cast<View*>(item->aux_);
+    ShadowSplitWork* work = reinterpret_cast<ShadowSplitWork*>(item->start_);
+    
+    #ifdef URHO3D_PROFILING
+    HiresTimer timer;
+    #endif
+    view->ProcessShadowSplit(*work->query_, work->splitIndex_);
+    #ifdef URHO3D_PROFILING
+    work->time_ = timer.GetUSec(false);
+    #endif
+}
+
+void ProcessShadowCastersWork(const WorkItem* item, unsigned threadIndex)
+{
+    View* view = reinterpret_cast<View*>(item->aux_);
+    ShadowCasterWork* work = reinterpret_cast<ShadowCasterWork*>(item->start_);
+    
+    #ifdef URHO3D_PROFILING
+    HiresTimer timer;
+    #endif
+    if (work->query_->cachedShadowCasters_[work->splitIndex_])
+        view->ProcessCachedShadowCasters(*work);
+    else
+        view->ProcessShadowCasters(*work);
+    #ifdef URHO3D_PROFILING
+    work->time_ = timer.GetUSec(false);
+    #endif
 }
 
 void UpdateDrawableGeometriesWork(const WorkItem* item, unsigned threadIndex)
@@ -490,6 +535,7 @@ void View::Update(const FrameInfo& frame)
     shadowGeometries_.Clear();
     lights_.Clear();
     zones_.Clear();
+    zoneIndex_.Clear();
     occluders_.Clear();
     vertexLightQueues_.Clear();
     for (HashMap<StringHash, BatchQueue>::Iterator i = batchQueues_.Begin(); i != batchQueues_.End(); ++i)
@@ -503,6 +549,17 @@ void View::Update(const FrameInfo& frame)
         camera_->SetAspectRatioInternal((float)frame_.viewSize_.x_ / (float)frame_.viewSize_.y_);
     
     GetDrawables();
+    
+    // Assign the visible point and spot lights to view frustum clusters for clustered rendering
+    if (renderer_->GetLightClustering())
+    {
+        if (!lightClusters_)
+            lightClusters_ = new LightClusters(context_);
+        lightClusters_->Assign(camera_, lights_);
+    }
+    else
+        lightClusters_.Reset();
+    
     GetBatches();
 }
 
@@ -765,6 +822,10 @@ void View::GetDrawables()
     if (farClipZone_ == renderer_->GetDefaultZone())
         farClipZone_ = cameraZone_;
     
+    // With many zones, index them so that the zone lookups in the worker threads below do not need to test every zone
+    if (zones_.Size() >= MIN_INDEXED_ZONES && !cameraZoneOverride_)
+        zoneIndex_.Define(zones_);
+    
     // If occlusion in use, get & render the occluders
     occlusionBuffer_ = 0;
     if (maxOccluderTriangles_ > 0)
@@ -877,33 +938,11 @@ void View::GetBatches()
     if (!octree_ || !camera_)
         return;
     
-    WorkQueue* queue = GetSubsystem<WorkQueue>();
     PODVector<Light*> vertexLights;
     BatchQueue* alphaQueue = batchQueues_.Contains(alphaPassName_) ? &batchQueues_[alphaPassName_] : (BatchQueue*)0;
     
     // Process lit geometries and shadow casters for each light
-    {
-        PROFILE(ProcessLights);
-        
-        lightQueryResults_.Resize(lights_.Size());
-        
-        for (unsigned i = 0; i < lightQueryResults_.Size(); ++i)
-        {
-            SharedPtr<WorkItem> item = queue->GetFreeItem();
-            item->priority_ = M_MAX_UNSIGNED;
-            item->workFunction_ = ProcessLightWork;
-            item->aux_ = this;
-
-            LightQueryResult& query = lightQueryResults_[i];
-            query.light_ = lights_[i];
-            
-            item->start_ = &query;
-            queue->AddWorkItem(item);
-        }
-        
-        // Ensure all lights have been processed before proceeding
-        queue->Complete(M_MAX_UNSIGNED);
-    }
+    ProcessLights();
     
     // Build light queues and lit batches
     {
@@ -2045,11 +2084,199 @@ void View::DrawOccluders(OcclusionBuffer* buffer, const PODVector<Drawable*>& oc
     buffer->BuildDepthHierarchy();
 }
 
+void View::ProcessLights()
+{
+    PROFILE(ProcessLights);
+    
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    #ifdef URHO3D_PROFILING
+    Profiler* profiler = GetSubsystem<Profiler>();
+    #endif
+    
+    lightQueryResults_.Resize(lights_.Size());
+    
+    // Shadow caster caches are created here, as the light processing work items can not modify the cache map
+    bool shadowCasterCaching = drawShadows_ && renderer_->GetShadowCasterCaching();
+    if (!shadowCasterCaching || shadowCasterCacheOctree_.Get() != octree_)
+    {
+        shadowCasterCaches_.Clear();
+        shadowCasterCacheOctree_ = shadowCasterCaching ? octree_ : (Octree*)0;
+    }
+    
+    // Query the lit geometries and set up the shadow cameras of each light
+    {
+        PROFILE(QueryLitGeometries);
+        
+        for (unsigned i = 0; i < lightQueryResults_.Size(); ++i)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = ProcessLightWork;
+            item->aux_ = this;
+
+            LightQueryResult& query = lightQueryResults_[i];
+            query.light_ = lights_[i];
+            query.shadowCache_ = 0;
+            query.time_ = 0;
+            if (shadowCasterCaching && query.light_->GetCastShadows())
+            {
+                query.shadowCache_ = &shadowCasterCaches_[query.light_];
+                query.shadowCache_->frameNumber_ = frame_.frameNumber_;
+            }
+            
+            item->start_ = &query;
+            queue->AddWorkItem(item);
+        }
+        
+        queue->Complete(M_MAX_UNSIGNED);
+        
+        #ifdef URHO3D_PROFILING
+        if (profiler)
+        {
+            for (unsigned i = 0; i < lightQueryResults_.Size(); ++i)
+                profiler->AddBlockTime("LightWork", lightQueryResults_[i].time_);
+        }
+        #endif
+    }
+    
+    // Forget the caches of lights that are no longer visible
+    for (HashMap<Light*, LightShadowCache>::Iterator i = shadowCasterCaches_.Begin(); i != shadowCasterCaches_.End();)
+    {
+        if (i->second_.frameNumber_ != frame_.frameNumber_)
+            i = shadowCasterCaches_.Erase(i);
+        else
+            ++i;
+    }
+    
+    // Find the potential shadow casters of each split in its own work item, as each directional light split needs an octree
+    // query of its own
+    {
+        PROFILE(QueryShadowSplits);
+        
+        shadowSplitWork_.Clear();
+        for (Vector<LightQueryResult>::Iterator i = lightQueryResults_.Begin(); i != lightQueryResults_.End(); ++i)
+        {
+            for (unsigned j = 0; j < i->numSplits_; ++j)
+            {
+                ShadowSplitWork work;
+                work.query_ = &(*i);
+                work.splitIndex_ = j;
+                work.time_ = 0;
+                shadowSplitWork_.Push(work);
+            }
+        }
+        
+        for (unsigned i = 0; i < shadowSplitWork_.Size(); ++i)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = ProcessShadowSplitWork;
+            item->aux_ = this;
+            item->start_ = &shadowSplitWork_[i];
+            queue->AddWorkItem(item);
+        }
+        
+        queue->Complete(M_MAX_UNSIGNED);
+        
+        #ifdef URHO3D_PROFILING
+        if (profiler)
+        {
+            for (unsigned i = 0; i < shadowSplitWork_.Size(); ++i)
+                profiler->AddBlockTime("ShadowSplitWork", shadowSplitWork_[i].time_);
+        }
+        #endif
+    }
+    
+    // Divide the potential shadow casters of all splits into ranges of roughly equal size, so that the threads stay evenly
+    // loaded regardless of how the casters are distributed between lights and splits
+    unsigned numShadowCasterWork = 0;
+    {
+        PROFILE(ProcessShadowCasters);
+        
+        unsigned numCandidates = 0;
+        for (unsigned i = 0; i < shadowSplitWork_.Size(); ++i)
+            numCandidates += shadowSplitWork_[i].query_->numShadowCasterCandidates_[shadowSplitWork_[i].splitIndex_];
+        
+        unsigned numThreads = queue->GetNumThreads() + 1;
+        unsigned candidatesPerItem = Max((int)(numCandidates / (numThreads * SHADOW_CASTER_WORK_ITEMS_PER_THREAD)),
+            MIN_SHADOW_CASTERS_PER_WORK_ITEM);
+        
+        for (unsigned i = 0; i < shadowSplitWork_.Size(); ++i)
+        {
+            LightQueryResult* query = shadowSplitWork_[i].query_;
+            unsigned splitIndex = shadowSplitWork_[i].splitIndex_;
+            unsigned numSplitCandidates = query->numShadowCasterCandidates_[splitIndex];
+            
+            for (unsigned start = 0; start < numSplitCandidates; start += candidatesPerItem)
+            {
+                if (numShadowCasterWork >= shadowCasterWork_.Size())
+                    shadowCasterWork_.Resize(numShadowCasterWork + 1);
+                
+                ShadowCasterWork& work = shadowCasterWork_[numShadowCasterWork++];
+                work.query_ = query;
+                work.splitIndex_ = splitIndex;
+                work.start_ = start;
+                work.end_ = start + candidatesPerItem < numSplitCandidates ? start + candidatesPerItem : numSplitCandidates;
+                work.time_ = 0;
+            }
+        }
+        
+        for (unsigned i = 0; i < numShadowCasterWork; ++i)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = ProcessShadowCastersWork;
+            item->aux_ = this;
+            item->start_ = &shadowCasterWork_[i];
+            queue->AddWorkItem(item);
+        }
+        
+        queue->Complete(M_MAX_UNSIGNED);
+        
+        #ifdef URHO3D_PROFILING
+        if (profiler)
+        {
+            for (unsigned i = 0; i < numShadowCasterWork; ++i)
+                profiler->AddBlockTime("ShadowCasterWork", shadowCasterWork_[i].time_);
+        }
+        #endif
+    }
+    
+    // Combine the ranges' results in order. The work was created in light and split order, so it can be walked alongside
+    unsigned workIndex = 0;
+    for (Vector<LightQueryResult>::Iterator i = lightQueryResults_.Begin(); i != lightQueryResults_.End(); ++i)
+    {
+        LightQueryResult& query = *i;
+        query.shadowCasters_.Clear();
+        
+        for (unsigned j = 0; j < query.numSplits_; ++j)
+        {
+            query.shadowCasterBegin_[j] = query.shadowCasters_.Size();
+            query.shadowCasterBox_[j].defined_ = false;
+            
+            while (workIndex < numShadowCasterWork && shadowCasterWork_[workIndex].query_ == &query &&
+                shadowCasterWork_[workIndex].splitIndex_ == j)
+            {
+                const ShadowCasterWork& work = shadowCasterWork_[workIndex++];
+                query.shadowCasters_.Push(work.shadowCasters_);
+                if (work.shadowCasterBox_.defined_)
+                    query.shadowCasterBox_[j].Merge(work.shadowCasterBox_);
+            }
+            
+            query.shadowCasterEnd_[j] = query.shadowCasters_.Size();
+        }
+        
+        // If no shadow casters, the light can be rendered unshadowed. At this point we have not allocated a shadow map yet, so
+        // the only cost has been the shadow camera setup & queries
+        if (query.shadowCasters_.Empty())
+            query.numSplits_ = 0;
+    }
+}
+
 void View::ProcessLight(LightQueryResult& query, unsigned threadIndex)
 {
     Light* light = query.light_;
     LightType type = light->GetLightType();
-    const Frustum& frustum = camera_->GetFrustum();
     
     // Check if light should be shadowed
     bool isShadowed = drawShadows_ && light->GetCastShadows() && !light->GetPerVertex() && light->GetShadowIntensity() < 1.0f;
@@ -2061,8 +2288,9 @@ void View::ProcessLight(LightQueryResult& query, unsigned threadIndex)
     if (isShadowed && type == LIGHT_POINT)
         isShadowed = false;
     #endif
-    // Get lit geometries. They must match the light mask and be inside the main camera frustum to be considered
-    PODVector<Drawable*>& tempDrawables = tempDrawables_[threadIndex];
+    // Get lit geometries. They must match the light mask and be inside the main camera frustum to be considered. For point
+    // and spot lights the query result is kept for finding the shadow casters
+    PODVector<Drawable*>& tempDrawables = type != LIGHT_DIRECTIONAL ? query.shadowCasterCandidates_[0] : tempDrawables_[threadIndex];
     query.litGeometries_.Clear();
     
     switch (type)
@@ -2111,45 +2339,61 @@ void View::ProcessLight(LightQueryResult& query, unsigned threadIndex)
     
     // Determine number of shadow cameras and setup their initial positions
     SetupShadowCameras(query);
+}
+
+void View::ProcessShadowSplit(LightQueryResult& query, unsigned splitIndex)
+{
+    Light* light = query.light_;
+    LightType type = light->GetLightType();
+    Camera* shadowCamera = query.shadowCameras_[splitIndex];
+    
+    query.numShadowCasterCandidates_[splitIndex] = 0;
+    query.cachedShadowCasters_[splitIndex] = false;
+    
+    // Calculate the shadow camera's matrices and frustum here, as the split's shadow casters may be processed in several
+    // threads at once
+    const Frustum& shadowCameraFrustum = shadowCamera->GetFrustum();
+    shadowCamera->GetView();
+    shadowCamera->GetProjection();
+    
+    // For point light check that the face is visible: if not, can skip the split
+    if (type == LIGHT_POINT && camera_->GetFrustum().IsInsideFast(BoundingBox(shadowCameraFrustum)) == OUTSIDE)
+        return;
     
-    // Process each split for shadow casters
-    query.shadowCasters_.Clear();
-    for (unsigned i = 0; i < query.numSplits_; ++i)
+    // For directional light check that the split is inside the visible scene: if not, can skip the split
+    if (type == LIGHT_DIRECTIONAL)
     {
-        Camera* shadowCamera = query.shadowCameras_[i];
-        const Frustum& shadowCameraFrustum = shadowCamera->GetFrustum();
-        query.shadowCasterBegin_[i] = query.shadowCasterEnd_[i] = query.shadowCasters_.Size();
-        
-        // For point light check that the face is visible: if not, can skip the split
-        if (type == LIGHT_POINT && frustum.IsInsideFast(BoundingBox(shadowCameraFrustum)) == OUTSIDE)
-            continue;
-        
-        // For directional light check that the split is inside the visible scene: if not, can skip the split
-        if (type == LIGHT_DIRECTIONAL)
-        {
-            if (minZ_ > query.shadowFarSplits_[i])
-                continue;
-            if (maxZ_ < query.shadowNearSplits_[i])
-                continue;
-        
-            // Reuse lit geometry query for all except directional lights
-            ShadowCasterOctreeQuery query(tempDrawables, shadowCameraFrustum, DRAWABLE_GEOMETRY | DRAWABLE_PROXYGEOMETRY,
-                camera_->GetViewMask());
-            octree_->GetDrawables(query);
-        }
-        
-        // Check which shadow casters actually contribute to the shadowing
-        ProcessShadowCasters(query, tempDrawables, i);
+        if (minZ_ > query.shadowFarSplits_[splitIndex])
+            return;
+        if (maxZ_ < query.shadowNearSplits_[splitIndex])
+            return;
     }
     
-    // If no shadow casters, the light can be rendered unshadowed. At this point we have not allocated a shadow map yet, so the
-    // only cost has been the shadow camera setup & queries
-    if (query.shadowCasters_.Empty())
-        query.numSplits_ = 0;
+    // If the split's shadow casters have been searched on an earlier frame and nothing has changed, use them
+    if (query.shadowCache_ && UpdateShadowCasterCache(query, splitIndex))
+    {
+        query.cachedShadowCasters_[splitIndex] = true;
+        query.numShadowCasterCandidates_[splitIndex] = query.shadowCache_->splits_[splitIndex].candidates_.Size();
+        return;
+    }
+    
+    // Reuse lit geometry query for all except directional lights
+    if (type == LIGHT_DIRECTIONAL)
+    {
+        PODVector<Drawable*>& candidates = query.shadowCasterCandidates_[splitIndex];
+        ShadowCasterOctreeQuery octreeQuery(candidates, shadowCameraFrustum, DRAWABLE_GEOMETRY | DRAWABLE_PROXYGEOMETRY,
+            camera_->GetViewMask());
+        octree_->GetDrawables(octreeQuery);
+        query.numShadowCasterCandidates_[splitIndex] = candidates.Size();
+    }
+    else
+        query.numShadowCasterCandidates_[splitIndex] = query.shadowCasterCandidates_[0].Size();
 }
 
-void View::ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawable*>& drawables, unsigned splitIndex)
+void View::ProcessShadowCasters(ShadowCasterWork& work)
 {
+    LightQueryResult& query = *work.query_;
+    unsigned splitIndex = work.splitIndex_;
     Light* light = query.light_;
     
     Camera* shadowCamera = query.shadowCameras_[splitIndex];
@@ -2157,19 +2401,13 @@ void View::ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawabl
     const Matrix3x4& lightView = shadowCamera->GetView();
     const Matrix4& lightProj = shadowCamera->GetProjection();
     LightType type = light->GetLightType();
+    const PODVector<Drawable*>& drawables = query.shadowCasterCandidates_[type == LIGHT_DIRECTIONAL ? splitIndex : 0];
     
-    query.shadowCasterBox_[splitIndex].defined_ = false;
-    
-    // Transform scene frustum into shadow camera's view space for shadow caster visibility check. For point & spot lights,
-    // we can use the whole scene frustum. For directional lights, use the intersection of the scene frustum and the split
-    // frustum, so that shadow casters do not get rendered into unnecessary splits
-    Frustum lightViewFrustum;
-    if (type != LIGHT_DIRECTIONAL)
-        lightViewFrustum = camera_->GetSplitFrustum(minZ_, maxZ_).Transformed(lightView);
-    else
-        lightViewFrustum = camera_->GetSplitFrustum(Max(minZ_, query.shadowNearSplits_[splitIndex]),
-            Min(maxZ_, query.shadowFarSplits_[splitIndex])).Transformed(lightView);
+    work.shadowCasters_.Clear();
+    work.shadowCasterBox_.defined_ = false;
     
+    // Transform scene frustum into shadow camera's view space for shadow caster visibility check
+    Frustum lightViewFrustum = GetShadowSplitFrustum(query, splitIndex).Transformed(lightView);
     BoundingBox lightViewFrustumBox(lightViewFrustum);
      
     // Check for degenerate split frustum: in that case there is no need to get shadow casters
@@ -2179,7 +2417,7 @@ void View::ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawabl
     BoundingBox lightViewBox;
     BoundingBox lightProjBox;
     
-    for (PODVector<Drawable*>::ConstIterator i = drawables.Begin(); i != drawables.End(); ++i)
+    for (PODVector<Drawable*>::ConstIterator i = drawables.Begin() + work.start_; i != drawables.Begin() + work.end_; ++i)
     {
         Drawable* drawable = *i;
         // In case this is a point or spot light query result reused for optimization, we may have non-shadowcasters included.
@@ -2194,27 +2432,9 @@ void View::ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawabl
             continue;
         
         // Check shadow distance
-        float maxShadowDistance = drawable->GetShadowDistance();
-        float drawDistance = drawable->GetDrawDistance();
-        bool batchesUpdated = drawable->IsInView(frame_, true);
-        if (drawDistance > 0.0f && (maxShadowDistance <= 0.0f || drawDistance < maxShadowDistance))
-            maxShadowDistance = drawDistance;
-        if (maxShadowDistance > 0.0f)
-        {
-            if (!batchesUpdated)
-            {
-                drawable->UpdateBatches(frame_);
-                batchesUpdated = true;
-            }
-            if (drawable->GetDistance() > maxShadowDistance)
-                continue;
-        }
+        if (!UpdateShadowCaster(drawable))
+            continue;
         
-        // Note: as lights are processed threaded, it is possible a drawable's UpdateBatches() function is called several
-        // times. However, this should not cause problems as no scene modification happens at this point.
-        if (!batchesUpdated)
-            drawable->UpdateBatches(frame_);
-
         // Project shadow caster bounding box to light view space for visibility check
         lightViewBox = drawable->GetWorldBoundingBox().Transformed(lightView);
         
@@ -2222,17 +2442,182 @@ void View::ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawabl
         {
             // Merge to shadow caster bounding box and add to the list
             if (type == LIGHT_DIRECTIONAL)
-                query.shadowCasterBox_[splitIndex].Merge(lightViewBox);
+                work.shadowCasterBox_.Merge(lightViewBox);
             else
             {
                 lightProjBox = lightViewBox.Projected(lightProj);
-                query.shadowCasterBox_[splitIndex].Merge(lightProjBox);
+                work.shadowCasterBox_.Merge(lightProjBox);
             }
-            query.shadowCasters_.Push(drawable);
+            work.shadowCasters_.Push(drawable);
         }
     }
+}
+
+void View::ProcessCachedShadowCasters(ShadowCasterWork& work)
+{
+    LightQueryResult& query = *work.query_;
+    Light* light = query.light_;
+    const PODVector<ShadowCasterCandidate>& candidates = query.shadowCache_->splits_[work.splitIndex_].candidates_;
+    unsigned viewMask = camera_->GetViewMask();
     
-    query.shadowCasterEnd_[splitIndex] = query.shadowCasters_.Size();
+    work.shadowCasters_.Clear();
+    work.shadowCasterBox_.defined_ = false;
+    
+    // The candidates include all drawables that are geometrically able to cast a shadow into the view, so check the settings
+    // which may change without moving the drawable
+    for (PODVector<ShadowCasterCandidate>::ConstIterator i = candidates.Begin() + work.start_; i != candidates.Begin() +
+        work.end_; ++i)
+    {
+        Drawable* drawable = i->drawable_;
+        if (!drawable->GetCastShadows() || !(drawable->GetViewMask() & viewMask))
+            continue;
+        if (!(GetShadowMask(drawable) & light->GetLightMask()))
+            continue;
+        if (!i->visible_ && !drawable->IsInView(frame_))
+            continue;
+        if (!UpdateShadowCaster(drawable))
+            continue;
+        
+        work.shadowCasterBox_.Merge(i->shadowBox_);
+        work.shadowCasters_.Push(drawable);
+    }
+}
+
+bool View::UpdateShadowCasterCache(LightQueryResult& query, unsigned splitIndex)
+{
+    Light* light = query.light_;
+    ShadowSplitCache& cache = query.shadowCache_->splits_[splitIndex];
+    Camera* shadowCamera = query.shadowCameras_[splitIndex];
+    const Matrix3x4& lightView = shadowCamera->GetView();
+    const Matrix4& lightProj = shadowCamera->GetProjection();
+    Frustum splitFrustum = GetShadowSplitFrustum(query, splitIndex);
+    unsigned octreeUpdate = octree_->GetUpdateNumber();
+    
+    bool changed = !cache.defined_ || cache.shadowView_ != lightView || cache.shadowProjection_ != lightProj;
+    for (unsigned i = 0; i < NUM_FRUSTUM_VERTICES && !changed; ++i)
+        changed = cache.splitVertices_[i] != splitFrustum.vertices_[i];
+    
+    // Check for drawables added, removed or moved inside the split's volume since the last check. If an octree update has
+    // been missed, the changes are unknown
+    if (!changed && cache.octreeUpdate_ != octreeUpdate)
+    {
+        if (cache.octreeUpdate_ + 1 == octreeUpdate)
+        {
+            Frustum volume = light->GetLightType() == LIGHT_SPOT ? light->GetFrustum() : shadowCamera->GetFrustum();
+            const PODVector<BoundingBox>& changedBoxes = octree_->GetChangedBoxes();
+            for (PODVector<BoundingBox>::ConstIterator i = changedBoxes.Begin(); i != changedBoxes.End(); ++i)
+            {
+                if (volume.IsInsideFast(*i) != OUTSIDE)
+                {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        else
+            changed = true;
+    }
+    cache.octreeUpdate_ = octreeUpdate;
+    
+    // When changed, search normally on this frame. The candidates are searched once the split has stayed unchanged for a
+    // frame, so that continuously moving lights and cameras do not pay for building the cache
+    if (changed)
+    {
+        cache.shadowView_ = lightView;
+        cache.shadowProjection_ = lightProj;
+        for (unsigned i = 0; i < NUM_FRUSTUM_VERTICES; ++i)
+            cache.splitVertices_[i] = splitFrustum.vertices_[i];
+        cache.candidates_.Clear();
+        cache.defined_ = true;
+        cache.built_ = false;
+        return false;
+    }
+    
+    if (!cache.built_)
+    {
+        BuildShadowCasterCache(query, splitIndex, splitFrustum);
+        cache.built_ = true;
+    }
+    
+    return true;
+}
+
+void View::BuildShadowCasterCache(LightQueryResult& query, unsigned splitIndex, const Frustum& splitFrustum)
+{
+    Light* light = query.light_;
+    ShadowSplitCache& cache = query.shadowCache_->splits_[splitIndex];
+    Camera* shadowCamera = query.shadowCameras_[splitIndex];
+    const Matrix3x4& lightView = shadowCamera->GetView();
+    const Matrix4& lightProj = shadowCamera->GetProjection();
+    LightType type = light->GetLightType();
+    
+    Frustum lightViewFrustum = splitFrustum.Transformed(lightView);
+    BoundingBox lightViewFrustumBox(lightViewFrustum);
+    
+    // Check for degenerate split frustum: in that case there are no shadow casters
+    if (lightViewFrustum.vertices_[0] == lightViewFrustum.vertices_[4])
+        return;
+    
+    // Query all geometries inside the light or split volume regardless of view mask and shadow casting settings, as these are
+    // checked on each frame
+    PODVector<Drawable*> drawables;
+    FrustumOctreeQuery octreeQuery(drawables, type == LIGHT_SPOT ? light->GetFrustum() : shadowCamera->GetFrustum(),
+        DRAWABLE_GEOMETRY | DRAWABLE_PROXYGEOMETRY);
+    octree_->GetDrawables(octreeQuery);
+    
+    for (PODVector<Drawable*>::ConstIterator i = drawables.Begin(); i != drawables.End(); ++i)
+    {
+        Drawable* drawable = *i;
+        BoundingBox lightViewBox = drawable->GetWorldBoundingBox().Transformed(lightView);
+        
+        // Whether the drawable is in view may change from frame to frame, so check the extruded bounding box only
+        bool visible = IsShadowCasterVisible(0, lightViewBox, shadowCamera, lightView, lightViewFrustum, lightViewFrustumBox);
+        if (!visible && type == LIGHT_DIRECTIONAL)
+            continue;
+        
+        ShadowCasterCandidate candidate;
+        candidate.drawable_ = drawable;
+        candidate.shadowBox_ = type == LIGHT_DIRECTIONAL ? lightViewBox : lightViewBox.Projected(lightProj);
+        candidate.visible_ = visible;
+        cache.candidates_.Push(candidate);
+    }
+}
+
+bool View::UpdateShadowCaster(Drawable* drawable)
+{
+    float maxShadowDistance = drawable->GetShadowDistance();
+    float drawDistance = drawable->GetDrawDistance();
+    bool batchesUpdated = drawable->IsInView(frame_, true);
+    if (drawDistance > 0.0f && (maxShadowDistance <= 0.0f || drawDistance < maxShadowDistance))
+        maxShadowDistance = drawDistance;
+    if (maxShadowDistance > 0.0f)
+    {
+        if (!batchesUpdated)
+        {
+            drawable->UpdateBatches(frame_);
+            batchesUpdated = true;
+        }
+        if (drawable->GetDistance() > maxShadowDistance)
+            return false;
+    }
+    
+    // Note: as lights are processed threaded, it is possible a drawable's UpdateBatches() function is called several
+    // times. However, this should not cause problems as no scene modification happens at this point.
+    if (!batchesUpdated)
+        drawable->UpdateBatches(frame_);
+    
+    return true;
+}
+
+Frustum View::GetShadowSplitFrustum(const LightQueryResult& query, unsigned splitIndex) const
+{
+    // For point & spot lights, we can use the whole scene frustum. For directional lights, use the intersection of the scene
+    // frustum and the split frustum, so that shadow casters do not get rendered into unnecessary splits
+    if (query.light_->GetLightType() != LIGHT_DIRECTIONAL)
+        return camera_->GetSplitFrustum(minZ_, maxZ_);
+    else
+        return camera_->GetSplitFrustum(Max(minZ_, query.shadowNearSplits_[splitIndex]),
+            Min(maxZ_, query.shadowFarSplits_[splitIndex]));
 }
 
 bool View::IsShadowCasterVisible(Drawable* drawable, BoundingBox lightViewBox, Camera* shadowCamera, const Matrix3x4& lightView,
@@ -2247,7 +2632,7 @@ bool View::IsShadowCasterVisible(Drawable* drawable, BoundingBox lightViewBox, C
     else
     {
         // If light is not directional, can do a simple check: if object is visible, its shadow is too
-        if (drawable->IsInView(frame_))
+        if (drawable && drawable->IsInView(frame_))
             return true;
         
         // For perspective lights, extrusion direction depends on the position of the shadow caster
@@ -2571,6 +2956,8 @@ void View::FindZone(Drawable* drawable)
     if (lastZone && (lastZone->GetViewMask() & camera_->GetViewMask()) && lastZone->GetPriority() >= highestZonePriority_ &&
         (drawable->GetZoneMask() & lastZone->GetZoneMask()) && lastZone->IsInside(center))
         newZone = lastZone;
+    else if (!zoneIndex_.IsEmpty())
+        newZone = zoneIndex_.FindZone(center, drawable->GetZoneMask());
     else
     {
         for (PODVector<Zone*>::Iterator i = zones_.Begin(); i != zones_.End(); ++i)
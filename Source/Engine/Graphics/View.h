@@ -28,6 +28,7 @@
 #include "Object.h"
 #include "Polyhedron.h"
 #include "Zone.h"
+#include "ZoneIndex.h"
 
 namespace Urho3D
 {
@@ -36,6 +37,7 @@ class Camera;
 class DebugRenderer;
 class Light;
 class Drawable;
+class LightClusters;
 class OcclusionBuffer;
 class Octree;
 class RenderPath;
@@ -47,11 +49,66 @@ class Zone;
 struct RenderPathCommand;
 struct WorkItem;
 
+/// Shadow caster candidate of a cached shadow split.
+struct ShadowCasterCandidate
+{
+    /// Drawable.
+    Drawable* drawable_;
+    /// Bounding box in light view or projection space.
+    BoundingBox shadowBox_;
+    /// Shadow visible even when the drawable itself is not in view.
+    bool visible_;
+};
+
+/// Cached shadow caster candidates of one shadow split. Valid while the shadow camera and the shadowed part of the view frustum stay the same and no drawable changes inside the split's volume.
+struct ShadowSplitCache
+{
+    /// Construct.
+    ShadowSplitCache() :
+        octreeUpdate_(0),
+        defined_(false),
+        built_(false)
+    {
+    }
+    
+    /// Shadow camera view matrix.
+    Matrix3x4 shadowView_;
+    /// Shadow camera projection matrix.
+    Matrix4 shadowProjection_;
+    /// World space vertices of the shadowed part of the view frustum.
+    Vector3 splitVertices_[NUM_FRUSTUM_VERTICES];
+    /// Shadow caster candidates regardless of shadow casting settings and masks.
+    PODVector<ShadowCasterCandidate> candidates_;
+    /// Octree update number when last checked for changes.
+    unsigned octreeUpdate_;
+    /// Shadow camera and view frustum stored flag.
+    bool defined_;
+    /// Candidates valid flag.
+    bool built_;
+};
+
+/// Cached shadow caster candidates of a light.
+struct LightShadowCache
+{
+    /// Shadow splits.
+    ShadowSplitCache splits_[MAX_LIGHT_SPLITS];
+    /// Frame number on which last used.
+    unsigned frameNumber_;
+};
+
 /// Intermediate light processing result.
 struct LightQueryResult
 {
     /// Light.
     Light* light_;
+    /// Shadow caster cache, or null if not in use.
+    LightShadowCache* shadowCache_;
+    /// Potential shadow casters by split. Point and spot lights use the first one, which is the lit geometry query result, for all splits.
+    PODVector<Drawable*> shadowCasterCandidates_[MAX_LIGHT_SPLITS];
+    /// Number of potential shadow casters to process by split. Zero if the split is skipped.
+    unsigned numShadowCasterCandidates_[MAX_LIGHT_SPLITS];
+    /// Whether the split's potential shadow casters come from the shadow caster cache.
+    bool cachedShadowCasters_[MAX_LIGHT_SPLITS];
     /// Lit geometries.
     PODVector<Drawable*> litGeometries_;
     /// Shadow casters.
@@ -70,6 +127,38 @@ struct LightQueryResult
     float shadowFarSplits_[MAX_LIGHT_SPLITS];
     /// Shadow map split count.
     unsigned numSplits_;
+    /// Processing time in microseconds for profiling.
+    long long time_;
+};
+
+/// Work item data for finding the potential shadow casters of one shadow split.
+struct ShadowSplitWork
+{
+    /// Light query result.
+    LightQueryResult* query_;
+    /// Split index.
+    unsigned splitIndex_;
+    /// Processing time in microseconds for profiling.
+    long long time_;
+};
+
+/// Work item data for processing a range of one shadow split's potential shadow casters.
+struct ShadowCasterWork
+{
+    /// Light query result.
+    LightQueryResult* query_;
+    /// Split index.
+    unsigned splitIndex_;
+    /// Index of the first potential shadow caster.
+    unsigned start_;
+    /// Index after the last potential shadow caster.
+    unsigned end_;
+    /// Shadow casters found.
+    PODVector<Drawable*> shadowCasters_;
+    /// Combined bounding box of the shadow casters found in light view or projection space.
+    BoundingBox shadowCasterBox_;
+    /// Processing time in microseconds for profiling.
+    long long time_;
 };
 
 /// Scene render pass info.
@@ -109,6 +198,8 @@ class URHO3D_API View : public Object
 {
     friend void CheckVisibilityWork(const WorkItem* item, unsigned threadIndex);
     friend void ProcessLightWork(const WorkItem* item, unsigned threadIndex);
+    friend void ProcessShadowSplitWork(const WorkItem* item, unsigned threadIndex);
+    friend void ProcessShadowCastersWork(const WorkItem* item, unsigned threadIndex);
     
     OBJECT(View);
     
@@ -149,6 +240,8 @@ public:
     const PODVector<Light*>& GetLights() const { return lights_; }
     /// Return light batch queues.
     const Vector<LightBatchQueue>& GetLightQueues() const { return lightQueues_; }
+    /// Return point and spot light assignment to view frustum clusters, or null if light clustering is disabled. Lights are referred to by their index in GetLights().
+    LightClusters* GetLightClusters() const { return lightClusters_; }
     /// Set global (per-frame) shader parameters. Called by Batch and internally by View.
     void SetGlobalShaderParameters();
     /// Set camera-specific shader parameters. Called by Batch and internally by View.
@@ -191,10 +284,24 @@ private:
     void UpdateOccluders(PODVector<Drawable*>& occluders, Camera* camera);
     /// Draw occluders to occlusion buffer.
     void DrawOccluders(OcclusionBuffer* buffer, const PODVector<Drawable*>& occluders);
-    /// Query for lit geometries and shadow casters for a light.
+    /// Process lights in worker threads: lit geometries first, then potential shadow casters by split, then ranges of them.
+    void ProcessLights();
+    /// Query for lit geometries for a light and set up its shadow cameras.
     void ProcessLight(LightQueryResult& query, unsigned threadIndex);
-    /// Process shadow casters' visibilities and build their combined view- or projection-space bounding box.
-    void ProcessShadowCasters(LightQueryResult& query, const PODVector<Drawable*>& drawables, unsigned splitIndex);
+    /// Find the potential shadow casters of a shadow split.
+    void ProcessShadowSplit(LightQueryResult& query, unsigned splitIndex);
+    /// Process a range of potential shadow casters' visibilities and build their combined view- or projection-space bounding box.
+    void ProcessShadowCasters(ShadowCasterWork& work);
+    /// Process a range of a split's cached potential shadow casters.
+    void ProcessCachedShadowCasters(ShadowCasterWork& work);
+    /// Validate a split's shadow caster cache and build its candidates if they have stayed valid since the last frame. Return true if the candidates can be used.
+    bool UpdateShadowCasterCache(LightQueryResult& query, unsigned splitIndex);
+    /// Search the shadow caster candidates of a split.
+    void BuildShadowCasterCache(LightQueryResult& query, unsigned splitIndex, const Frustum& splitFrustum);
+    /// Update a potential shadow caster's batches if not yet updated on this frame and check its shadow distance. Return true if it should be rendered to the shadow map.
+    bool UpdateShadowCaster(Drawable* drawable);
+    /// Return the world space part of the view frustum that receives shadows from a shadow split.
+    Frustum GetShadowSplitFrustum(const LightQueryResult& query, unsigned splitIndex) const;
     /// Set up initial shadow camera view(s).
     void SetupShadowCameras(LightQueryResult& query);
     /// Set up a directional light shadow camera
@@ -203,7 +310,7 @@ private:
     void FinalizeShadowCamera(Camera* shadowCamera, Light* light, const IntRect& shadowViewport, const BoundingBox& shadowCasterBox);
     /// Quantize a directional light shadow camera view to eliminate swimming.
     void QuantizeDirLightShadowCamera(Camera* shadowCamera, Light* light, const IntRect& shadowViewport, const BoundingBox& viewBox);
-    /// Check visibility of one shadow caster.
+    /// Check visibility of one shadow caster. If the drawable is null, check only the extruded bounding box regardless of the drawable being in view.
     bool IsShadowCasterVisible(Drawable* drawable, BoundingBox lightViewBox, Camera* shadowCamera, const Matrix3x4& lightView, const Frustum& lightViewFrustum, const BoundingBox& lightViewFrustumBox);
     /// Return the viewport for a shadow map split.
     IntRect GetShadowMapViewport(Light* light, unsigned splitIndex, Texture2D* shadowMap);
@@ -272,6 +379,8 @@ private:
     Zone* farClipZone_;
     /// Occlusion buffer for the main camera.
     OcclusionBuffer* occlusionBuffer_;
+    /// Light assignment to view frustum clusters.
+    SharedPtr<LightClusters> lightClusters_;
     /// Destination color rendertarget.
     RenderSurface* renderTarget_;
     /// Substitute rendertarget for deferred rendering. Allocated if necessary.
@@ -324,6 +433,8 @@ private:
     Vector<PerThreadSceneResult> sceneResults_;
     /// Visible zones.
     PODVector<Zone*> zones_;
+    /// Spatial index of the visible zones. Only built when there are many zones.
+    ZoneIndex zoneIndex_;
     /// Visible geometry objects.
     PODVector<Drawable*> geometries_;
     /// Geometry objects visible in shadow maps.
@@ -342,6 +453,14 @@ private:
     HashMap<StringHash, Texture2D*> renderTargets_;
     /// Intermediate light processing results.
     Vector<LightQueryResult> lightQueryResults_;
+    /// Shadow split processing work.
+    PODVector<ShadowSplitWork> shadowSplitWork_;
+    /// Shadow caster processing work. Not shrunk to keep the allocated caster lists.
+    Vector<ShadowCasterWork> shadowCasterWork_;
+    /// Shadow caster caches by light.
+    HashMap<Light*, LightShadowCache> shadowCasterCaches_;
+    /// Octree the shadow caster caches refer to.
+    WeakPtr<Octree> shadowCasterCacheOctree_;
     /// Info for scene render passes defined by the renderpath.
     Vector<ScenePassInfo> scenePasses_;
     /// Per-pixel light queues.
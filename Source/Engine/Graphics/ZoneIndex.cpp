@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "Zone.h"
+#include "ZoneIndex.h"
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Maximum number of zones in a zone index leaf before it is split.
+static const unsigned ZONE_INDEX_MAX_LEAF_ZONES = 4;
+/// Maximum depth of a zone index.
+static const unsigned ZONE_INDEX_MAX_DEPTH = 32;
+
+ZoneIndex::ZoneIndex()
+{
+}
+
+ZoneIndex::~ZoneIndex()
+{
+}
+
+void ZoneIndex::Define(const PODVector<Zone*>& zones)
+{
+    Clear();
+    
+    if (zones.Empty())
+        return;
+    
+    entries_.Resize(zones.Size());
+    for (unsigned i = 0; i < zones.Size(); ++i)
+    {
+        ZoneIndexEntry& entry = entries_[i];
+        const BoundingBox& box = zones[i]->GetWorldBoundingBox();
+        entry.zone_ = zones[i];
+        entry.min_ = box.min_;
+        entry.max_ = box.max_;
+        entry.center_ = box.Center();
+        entry.priority_ = zones[i]->GetPriority();
+        entry.order_ = i;
+    }
+    
+    nodes_.Reserve(entries_.Size() / ZONE_INDEX_MAX_LEAF_ZONES * 2 + 1);
+    nodes_.Resize(1);
+    BuildNode(0, 0, entries_.Size(), 0);
+}
+
+void ZoneIndex::Clear()
+{
+    nodes_.Clear();
+    entries_.Clear();
+}
+
+Zone* ZoneIndex::FindZone(const Vector3& point, unsigned zoneMask) const
+{
+    if (nodes_.Empty())
+        return 0;
+    
+    const ZoneIndexEntry* best = 0;
+    int bestPriority = M_MIN_INT;
+    
+    // Each level of the hierarchy pushes at most one node
+    unsigned stack[ZONE_INDEX_MAX_DEPTH + 2];
+    unsigned stackSize = 0;
+    stack[stackSize++] = 0;
+    
+    while (stackSize)
+    {
+        const ZoneIndexNode& node = nodes_[stack[--stackSize]];
+        
+        // Skip subtrees that can not contain a higher priority zone or whose bounds do not contain the point
+        if (node.maxPriority_ < bestPriority || point.x_ < node.min_.x_ || point.x_ > node.max_.x_ || point.y_ < node.min_.y_ ||
+            point.y_ > node.max_.y_ || point.z_ < node.min_.z_ || point.z_ > node.max_.z_)
+            continue;
+        
+        if (node.count_)
+        {
+            const ZoneIndexEntry* end = &entries_[node.first_] + node.count_;
+            for (const ZoneIndexEntry* entry = &entries_[node.first_]; entry < end; ++entry)
+            {
+                if ((entry->priority_ > bestPriority || (best && entry->priority_ == bestPriority && entry->order_ < best->order_)) &&
+                    (zoneMask & entry->zone_->GetZoneMask()) && entry->zone_->IsInside(point))
+                {
+                    best = entry;
+                    bestPriority = entry->priority_;
+                }
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.first_ + 1;
+            stack[stackSize++] = node.first_;
+        }
+    }
+    
+    return best ? best->zone_ : 0;
+}
+
+void ZoneIndex::BuildNode(unsigned nodeIndex, unsigned start, unsigned count, unsigned depth)
+{
+    unsigned end = start + count;
+    Vector3 min = entries_[start].min_;
+    Vector3 max = entries_[start].max_;
+    Vector3 centerMin = entries_[start].center_;
+    Vector3 centerMax = entries_[start].center_;
+    int maxPriority = entries_[start].priority_;
+    
+    for (unsigned i = start + 1; i < end; ++i)
+    {
+        const ZoneIndexEntry& entry = entries_[i];
+        min = Vector3(Min(min.x_, entry.min_.x_), Min(min.y_, entry.min_.y_), Min(min.z_, entry.min_.z_));
+        max = Vector3(Max(max.x_, entry.max_.x_), Max(max.y_, entry.max_.y_), Max(max.z_, entry.max_.z_));
+        centerMin = Vector3(Min(centerMin.x_, entry.center_.x_), Min(centerMin.y_, entry.center_.y_), Min(centerMin.z_,
+            entry.center_.z_));
+        centerMax = Vector3(Max(centerMax.x_, entry.center_.x_), Max(centerMax.y_, entry.center_.y_), Max(centerMax.z_,
+            entry.center_.z_));
+        if (entry.priority_ > maxPriority)
+            maxPriority = entry.priority_;
+    }
+    
+    ZoneIndexNode& node = nodes_[nodeIndex];
+    node.min_ = min;
+    node.max_ = max;
+    node.maxPriority_ = maxPriority;
+    
+    if (count <= ZONE_INDEX_MAX_LEAF_ZONES || depth >= ZONE_INDEX_MAX_DEPTH)
+    {
+        node.first_ = start;
+        node.count_ = count;
+        return;
+    }
+    
+    // Split at the middle of the zone centers along the axis where they are spread the most. If all centers fall on one side,
+    // split the range in half instead
+    Vector3 centerSize = centerMax - centerMin;
+    unsigned axis = 0;
+    if (centerSize.y_ > centerSize.Data()[axis])
+        axis = 1;
+    if (centerSize.z_ > centerSize.Data()[axis])
+        axis = 2;
+    float splitPos = (centerMin.Data()[axis] + centerMax.Data()[axis]) * 0.5f;
+    
+    unsigned middle = start;
+    for (unsigned i = start; i < end; ++i)
+    {
+        if (entries_[i].center_.Data()[axis] < splitPos)
+            Swap(entries_[i], entries_[middle++]);
+    }
+    if (middle == start || middle == end)
+        middle = start + count / 2;
+    
+    unsigned first = nodes_.Size();
+    nodes_.Resize(first + 2);
+    nodes_[nodeIndex].first_ = first;
+    nodes_[nodeIndex].count_ = 0;
+    
+    BuildNode(first, start, middle - start, depth + 1);
+    BuildNode(first + 1, middle, end - middle, depth + 1);
+}
+
+}
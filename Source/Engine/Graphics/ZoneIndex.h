@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Vector.h"
+#include "Vector3.h"
+
+namespace Urho3D
+{
+
+class Zone;
+
+/// Zone index node.
+struct ZoneIndexNode
+{
+    /// Bounding box minimum.
+    Vector3 min_;
+    /// Bounding box maximum.
+    Vector3 max_;
+    /// Index of the first child for an inner node, or of the first zone entry for a leaf.
+    unsigned first_;
+    /// Number of zone entries for a leaf, or zero for an inner node.
+    unsigned count_;
+    /// Highest zone priority in the subtree.
+    int maxPriority_;
+};
+
+/// Zone index entry.
+struct ZoneIndexEntry
+{
+    /// Zone.
+    Zone* zone_;
+    /// World bounding box minimum.
+    Vector3 min_;
+    /// World bounding box maximum.
+    Vector3 max_;
+    /// World bounding box center.
+    Vector3 center_;
+    /// Zone priority.
+    int priority_;
+    /// Order in the source zone list, used to resolve equal priorities the same way as a linear search.
+    unsigned order_;
+};
+
+/// Bounding box hierarchy of zones for finding the zone at a point without testing every zone.
+class URHO3D_API ZoneIndex
+{
+public:
+    /// Construct empty.
+    ZoneIndex();
+    /// Destruct.
+    ~ZoneIndex();
+    
+    /// Build from zones. The zones must not move or be destroyed while the index is in use.
+    void Define(const PODVector<Zone*>& zones);
+    /// Remove all zones.
+    void Clear();
+    
+    /// Return the highest priority zone containing the point and matching the zone mask, or null if none. Of zones with equal priority the one defined first is returned.
+    Zone* FindZone(const Vector3& point, unsigned zoneMask) const;
+    /// Return number of zones.
+    unsigned GetNumZones() const { return entries_.Size(); }
+    /// Return whether is empty.
+    bool IsEmpty() const { return nodes_.Empty(); }
+    
+private:
+    /// Build a node from a range of entries.
+    void BuildNode(unsigned nodeIndex, unsigned start, unsigned count, unsigned depth);
+    
+    /// Nodes. The root is first and the children of an inner node are adjacent.
+    PODVector<ZoneIndexNode> nodes_;
+    /// Zone entries in leaf order.
+    PODVector<ZoneIndexEntry> entries_;
+};
+
+}
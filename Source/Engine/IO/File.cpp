@@ -21,6 +21,8 @@
 //
 
 #include "Precompiled.h"
+#include "ArrayPtr.h"
+#include "ContentHash.h"
 #include "File.h"
 #include "FileSystem.h"
 #include "Log.h"
@@ -36,6 +38,9 @@
 namespace Urho3D
 {
 
+/// Read block size for calculating a file checksum.
+static const unsigned CHECKSUM_BLOCK_SIZE = 65536;
+
 #ifdef WIN32
 static const wchar_t* openMode[] =
 {
@@ -459,18 +464,20 @@ unsigned File::GetChecksum()
     PROFILE(CalculateFileChecksum);
 
     unsigned oldPos = position_;
-    checksum_ = 0;
+    ContentHash hash;
+    SharedArrayPtr<unsigned char> block(new unsigned char[CHECKSUM_BLOCK_SIZE]);
 
     Seek(0);
     while (!IsEof())
     {
-        unsigned char block[1024];
-        unsigned readBytes = Read(block, 1024);
-        for (unsigned i = 0; i < readBytes; ++i)
-            checksum_ = SDBMHash(checksum_, block[i]);
+        unsigned readBytes = Read(block.Get(), CHECKSUM_BLOCK_SIZE);
+        if (!readBytes)
+            break;
+        hash.Update(block.Get(), readBytes);
     }
 
     Seek(oldPos);
+    checksum_ = hash.GetChecksum();
     return checksum_;
 }
 
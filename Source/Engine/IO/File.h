@@ -67,7 +67,7 @@ public:
     virtual unsigned Write(const void* data, unsigned size);
     /// Return the file name.
     virtual const String& GetName() const { return fileName_; }
-    /// Return a checksum of the file contents using the SDBM hash algorithm.
+    /// Return a checksum of the file contents: a 64-bit content hash folded to 32 bits. For a file inside a package, return the checksum stored in the package.
     virtual unsigned GetChecksum();
     
     /// Open a filesystem file. Return true if successful.
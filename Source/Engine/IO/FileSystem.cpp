@@ -30,6 +30,7 @@
 #include "IOEvents.h"
 #include "Log.h"
 #include "Thread.h"
+#include "WorkQueue.h"
 
 #include <SDL_filesystem.h>
 
@@ -620,6 +621,28 @@ bool FileSystem::DirExists(const String& pathName) const
     return true;
 }
 
+/// Subdirectory tree scan for a parallel recursive directory scan.
+struct ScanDirTask
+{
+    /// Subdirectory path.
+    String path_;
+    /// Path that the results are relative to.
+    const String* startPath_;
+    /// Filter.
+    const String* filter_;
+    /// Scan flags.
+    unsigned flags_;
+    /// Found files and directories.
+    Vector<String> result_;
+};
+
+void ScanDirWork(const WorkItem* item, unsigned threadIndex)
+{
+    const FileSystem* fileSystem = reinterpret_cast<const FileSystem*>(item->aux_);
+    ScanDirTask* task = reinterpret_cast<ScanDirTask*>(item->start_);
+    fileSystem->ScanDirInternal(task->result_, task->path_, *task->startPath_, *task->filter_, task->flags_, true);
+}
+
 void FileSystem::ScanDir(Vector<String>& result, const String& pathName, const String& filter, unsigned flags, bool recursive) const
 {
     result.Clear();
@@ -627,7 +650,12 @@ void FileSystem::ScanDir(Vector<String>& result, const String& pathName, const S
     if (CheckAccess(pathName))
     {
         String initialPath = AddTrailingSlash(pathName);
-        ScanDirInternal(result, initialPath, initialPath, filter, flags, recursive);
+        // Work can only be queued from the main thread
+        WorkQueue* queue = GetSubsystem<WorkQueue>();
+        if (recursive && queue && queue->GetNumThreads() && Thread::IsMainThread())
+            ScanDirParallel(result, initialPath, filter, flags);
+        else
+            ScanDirInternal(result, initialPath, initialPath, filter, flags, recursive);
     }
 }
 
@@ -721,6 +749,51 @@ void FileSystem::RegisterPath(const String& pathName)
     allowedPaths_.Insert(AddTrailingSlash(pathName));
 }
 
+void FileSystem::ScanDirParallel(Vector<String>& result, const String& path, const String& filter, unsigned flags) const
+{
+    // Scan the top level directly, then each subdirectory tree as its own work item
+    ScanDirInternal(result, path, path, filter, flags, false);
+    
+    Vector<String> subDirs;
+    ScanDirInternal(subDirs, path, path, String::EMPTY, SCAN_DIRS | (flags & SCAN_HIDDEN), false);
+    for (unsigned i = 0; i < subDirs.Size();)
+    {
+        if (subDirs[i] == "." || subDirs[i] == "..")
+            subDirs.Erase(i);
+        else
+            ++i;
+    }
+    
+    if (subDirs.Size() < 2)
+    {
+        for (unsigned i = 0; i < subDirs.Size(); ++i)
+            ScanDirInternal(result, path + subDirs[i], path, filter, flags, true);
+        return;
+    }
+    
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    Vector<ScanDirTask> tasks(subDirs.Size());
+    for (unsigned i = 0; i < subDirs.Size(); ++i)
+    {
+        ScanDirTask& task = tasks[i];
+        task.path_ = path + subDirs[i];
+        task.startPath_ = &path;
+        task.filter_ = &filter;
+        task.flags_ = flags;
+        
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = ScanDirWork;
+        item->start_ = &task;
+        item->aux_ = const_cast<FileSystem*>(this);
+        queue->AddWorkItem(item);
+    }
+    queue->Complete(M_MAX_UNSIGNED);
+    
+    for (unsigned i = 0; i < tasks.Size(); ++i)
+        result.Push(tasks[i].result_);
+}
+
 void FileSystem::ScanDirInternal(Vector<String>& result, String path, const String& startPath,
     const String& filter, unsigned flags, bool recursive) const
 {
@@ -777,21 +850,35 @@ void FileSystem::ScanDirInternal(Vector<String>& result, String path, const Stri
             bool normalEntry = fileName != "." && fileName != "..";
             if (normalEntry && !(flags & SCAN_HIDDEN) && fileName.StartsWith("."))
                 continue;
-            String pathAndName = path + fileName;
-            if (!stat(pathAndName.CString(), &st))
+            bool isDirectory = false;
+            bool typeKnown = false;
+            #ifdef DT_UNKNOWN
+            // Use the file type from the directory entry when available to avoid a stat call per entry
+            if (de->d_type == DT_DIR || de->d_type == DT_REG)
             {
-                if (st.st_mode & S_IFDIR)
-                {
-                    if (flags & SCAN_DIRS)
-                        result.Push(deltaPath + fileName);
-                    if (recursive && normalEntry)
-                        ScanDirInternal(result, path + fileName, startPath, filter, flags, recursive);
-                }
-                else if (flags & SCAN_FILES)
-                {
-                    if (filterExtension.Empty() || fileName.EndsWith(filterExtension))
-                        result.Push(deltaPath + fileName);
-                }
+                isDirectory = de->d_type == DT_DIR;
+                typeKnown = true;
+            }
+            #endif
+            if (!typeKnown)
+            {
+                String pathAndName = path + fileName;
+                if (stat(pathAndName.CString(), &st))
+                    continue;
+                isDirectory = (st.st_mode & S_IFDIR) != 0;
+            }
+            
+            if (isDirectory)
+            {
+                if (flags & SCAN_DIRS)
+                    result.Push(deltaPath + fileName);
+                if (recursive && normalEntry)
+                    ScanDirInternal(result, path + fileName, startPath, filter, flags, recursive);
+            }
+            else if (flags & SCAN_FILES)
+            {
+                if (filterExtension.Empty() || fileName.EndsWith(filterExtension))
+                    result.Push(deltaPath + fileName);
             }
         }
         closedir(dir);
@@ -30,6 +30,7 @@ namespace Urho3D
 {
 
 class AsyncExecRequest;
+struct WorkItem;
 
 /// Return files.
 static const unsigned SCAN_FILES = 0x1;
@@ -43,6 +44,8 @@ class URHO3D_API FileSystem : public Object
 {
     OBJECT(FileSystem);
     
+    friend void ScanDirWork(const WorkItem* item, unsigned threadIndex);
+    
 public:
     /// Construct.
     FileSystem(Context* context);
@@ -88,7 +91,7 @@ public:
     bool FileExists(const String& fileName) const;
     /// Check if a directory exists.
     bool DirExists(const String& pathName) const;
-    /// Scan a directory for specified files.
+    /// Scan a directory for specified files. A recursive scan from the main thread scans the subdirectories in worker threads.
     void ScanDir(Vector<String>& result, const String& pathName, const String& filter, unsigned flags, bool recursive) const;
     /// Return the program's directory. If it does not contain the Urho3D default CoreData and Data directories, and the current working directory does, return the working directory instead.
     String GetProgramDir() const;
@@ -100,6 +103,8 @@ public:
 private:
     /// Scan directory, called internally.
     void ScanDirInternal(Vector<String>& result, String path, const String& startPath, const String& filter, unsigned flags, bool recursive) const;
+    /// Scan directory recursively using the work queue for the subdirectories.
+    void ScanDirParallel(Vector<String>& result, const String& path, const String& filter, unsigned flags) const;
     /// Handle begin frame event to check for completed async executions.
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
     /// Handle a console command event.
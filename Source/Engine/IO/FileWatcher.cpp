@@ -53,6 +53,7 @@ FileWatcher::FileWatcher(Context* context) :
     delay_(1.0f),
     watchSubDirs_(false)
 {
+    SetName("FileWatcher");
 #if defined(URHO3D_FILEWATCHER)
 #if defined(__linux__)
     watchHandle_ = inotify_init();
@@ -282,7 +283,8 @@ void FileWatcher::ThreadFunction()
 
             if (event->len > 0)
             {
-                if (event->mask & IN_MODIFY || event->mask & IN_MOVE)
+                // Creations and deletions are reported too, as on Windows, so that directory listings can be kept up to date
+                if (event->mask & (IN_MODIFY | IN_MOVE | IN_CREATE | IN_DELETE))
                 {
                     String fileName;
                     fileName = dirHandle_[event->wd] + event->name;
@@ -24,6 +24,7 @@
 #include "Context.h"
 #include "CoreEvents.h"
 #include "FileSystem.h"
+#include "FrameRecorder.h"
 #include "Graphics.h"
 #include "GraphicsEvents.h"
 #include "GraphicsImpl.h"
@@ -130,25 +131,7 @@ void Input::Update()
 
     PROFILE(UpdateInput);
 
-    // Reset input accumulation for this frame
-    keyPress_.Clear();
-    scancodePress_.Clear();
-    mouseButtonPress_ = 0;
-    mouseMove_ = IntVector2::ZERO;
-    mouseMoveWheel_ = 0;
-    for (HashMap<SDL_JoystickID, JoystickState>::Iterator i = joysticks_.Begin(); i != joysticks_.End(); ++i)
-    {
-        for (unsigned j = 0; j < i->second_.buttonPress_.Size(); ++j)
-            i->second_.buttonPress_[j] = false;
-    }
-
-    // Reset touch delta movement
-    for (HashMap<int, TouchState>::Iterator i = touches_.Begin(); i != touches_.End(); ++i)
-    {
-        TouchState& state = i->second_;
-        state.lastPosition_ = state.position_;
-        state.delta_ = IntVector2::ZERO;
-    }
+    ResetFrameState();
 
     // Check and handle SDL events
     SDL_PumpEvents();
@@ -226,6 +209,74 @@ void Input::Update()
     }
 }
 
+void Input::BeginReplayFrame()
+{
+    PROFILE(UpdateInput);
+
+    ResetFrameState();
+}
+
+void Input::ReplayEvent(StringHash eventType, VariantMap& eventData)
+{
+    // Only the state tracked from key, mouse and text events is restored. Joystick and touch events are resent as is
+    if (eventType == E_KEYDOWN)
+    {
+        using namespace KeyDown;
+
+        int key = eventData[P_KEY].GetInt();
+        int scancode = eventData[P_SCANCODE].GetInt();
+        scancodeDown_.Insert(scancode);
+        scancodePress_.Insert(scancode);
+        if (!keyDown_.Contains(key))
+        {
+            keyDown_.Insert(key);
+            keyPress_.Insert(key);
+        }
+    }
+    else if (eventType == E_KEYUP)
+    {
+        using namespace KeyUp;
+
+        keyDown_.Erase(eventData[P_KEY].GetInt());
+        scancodeDown_.Erase(eventData[P_SCANCODE].GetInt());
+    }
+    else if (eventType == E_MOUSEBUTTONDOWN)
+    {
+        using namespace MouseButtonDown;
+
+        int button = eventData[P_BUTTON].GetInt();
+        mouseButtonDown_ |= button;
+        mouseButtonPress_ |= button;
+    }
+    else if (eventType == E_MOUSEBUTTONUP)
+    {
+        using namespace MouseButtonUp;
+
+        mouseButtonDown_ &= ~eventData[P_BUTTON].GetInt();
+    }
+    else if (eventType == E_MOUSEMOVE)
+    {
+        using namespace MouseMove;
+
+        mouseMove_.x_ += eventData[P_DX].GetInt();
+        mouseMove_.y_ += eventData[P_DY].GetInt();
+    }
+    else if (eventType == E_MOUSEWHEEL)
+    {
+        using namespace MouseWheel;
+
+        mouseMoveWheel_ += eventData[P_WHEEL].GetInt();
+    }
+    else if (eventType == E_TEXTINPUT)
+    {
+        using namespace TextInput;
+
+        textInput_ = eventData[P_TEXT].GetString();
+    }
+
+    SendEvent(eventType, eventData);
+}
+
 void Input::SetMouseVisible(bool enable)
 {
     // In touch emulation mode only enabled mouse is allowed
@@ -910,6 +961,28 @@ void Input::ResetState()
     mouseButtonPress_ = 0;
 }
 
+void Input::ResetFrameState()
+{
+    keyPress_.Clear();
+    scancodePress_.Clear();
+    mouseButtonPress_ = 0;
+    mouseMove_ = IntVector2::ZERO;
+    mouseMoveWheel_ = 0;
+    for (HashMap<SDL_JoystickID, JoystickState>::Iterator i = joysticks_.Begin(); i != joysticks_.End(); ++i)
+    {
+        for (unsigned j = 0; j < i->second_.buttonPress_.Size(); ++j)
+            i->second_.buttonPress_[j] = false;
+    }
+
+    // Reset touch delta movement
+    for (HashMap<int, TouchState>::Iterator i = touches_.Begin(); i != touches_.End(); ++i)
+    {
+        TouchState& state = i->second_;
+        state.lastPosition_ = state.position_;
+        state.delta_ = IntVector2::ZERO;
+    }
+}
+
 void Input::ResetTouches()
 {
     for (HashMap<int, TouchState>::Iterator i = touches_.Begin(); i != touches_.End(); ++i)
@@ -1536,8 +1609,10 @@ void Input::HandleScreenMode(StringHash eventType, VariantMap& eventData)
 
 void Input::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
 {
-    // Update input right at the beginning of the frame
-    Update();
+    // Update input right at the beginning of the frame. While a recording is being replayed, the frame recorder feeds the input
+    FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+    if (!recorder || !recorder->IsReplaying())
+        Update();
 }
 
 void Input::HandleScreenJoystickTouch(StringHash eventType, VariantMap& eventData)
@@ -120,6 +120,10 @@ public:
 
     /// Poll for window messages. Called by HandleBeginFrame().
     void Update();
+    /// Reset the per-frame key, mouse button and movement state without reading operating system input. Called by FrameRecorder when replaying recorded input.
+    void BeginReplayFrame();
+    /// Apply a recorded input event to the key, mouse button, movement and wheel state, then send the event. Called by FrameRecorder when replaying recorded input.
+    void ReplayEvent(StringHash eventType, VariantMap& eventData);
     /// Set whether ALT-ENTER fullscreen toggle is enabled.
     void SetToggleFullscreen(bool enable);
     /// Set whether the operating system mouse cursor is visible. When not visible (default), is kept centered to prevent leaving the window.
@@ -241,6 +245,8 @@ private:
     void LoseFocus();
     /// Clear input state.
     void ResetState();
+    /// Clear the key, mouse button and movement state accumulated during the previous frame.
+    void ResetFrameState();
     /// Clear touch states and send touch end events.
     void ResetTouches();
     /// Send an input focus or window minimization change event.
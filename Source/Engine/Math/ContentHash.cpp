@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "ContentHash.h"
+
+#include <cstring>
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+static const unsigned long long PRIME1 = 11400714785074694791ULL;
+static const unsigned long long PRIME2 = 14029467366897019727ULL;
+static const unsigned long long PRIME3 = 1609587929392839161ULL;
+static const unsigned long long PRIME4 = 9650029242287828579ULL;
+static const unsigned long long PRIME5 = 2870177450012600261ULL;
+
+static inline unsigned long long RotateLeft(unsigned long long value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline unsigned long long Read64(const unsigned char* data)
+{
+    // Assumes little-endian byte order like the rest of the serialization code. Copy to allow unaligned data
+    unsigned long long value;
+    memcpy(&value, data, sizeof value);
+    return value;
+}
+
+static inline unsigned Read32(const unsigned char* data)
+{
+    unsigned value;
+    memcpy(&value, data, sizeof value);
+    return value;
+}
+
+static inline unsigned long long Round(unsigned long long acc, unsigned long long input)
+{
+    acc += input * PRIME2;
+    acc = RotateLeft(acc, 31);
+    return acc * PRIME1;
+}
+
+static inline unsigned long long MergeRound(unsigned long long acc, unsigned long long value)
+{
+    acc ^= Round(0, value);
+    return acc * PRIME1 + PRIME4;
+}
+
+ContentHash::ContentHash(unsigned long long seed)
+{
+    Reset(seed);
+}
+
+void ContentHash::Reset(unsigned long long seed)
+{
+    seed_ = seed;
+    lanes_[0] = seed + PRIME1 + PRIME2;
+    lanes_[1] = seed + PRIME2;
+    lanes_[2] = seed;
+    lanes_[3] = seed - PRIME1;
+    bufferSize_ = 0;
+    totalSize_ = 0;
+}
+
+void ContentHash::Update(const void* data, unsigned size)
+{
+    const unsigned char* src = (const unsigned char*)data;
+    totalSize_ += size;
+    
+    // Complete a partial stripe first
+    if (bufferSize_)
+    {
+        unsigned copySize = 32 - bufferSize_;
+        if (copySize > size)
+            copySize = size;
+        memcpy(buffer_ + bufferSize_, src, copySize);
+        bufferSize_ += copySize;
+        src += copySize;
+        size -= copySize;
+        if (bufferSize_ < 32)
+            return;
+        
+        lanes_[0] = Round(lanes_[0], Read64(buffer_));
+        lanes_[1] = Round(lanes_[1], Read64(buffer_ + 8));
+        lanes_[2] = Round(lanes_[2], Read64(buffer_ + 16));
+        lanes_[3] = Round(lanes_[3], Read64(buffer_ + 24));
+        bufferSize_ = 0;
+    }
+    
+    // Process whole stripes. The lanes are independent, so their rounds can execute in parallel
+    unsigned long long v1 = lanes_[0];
+    unsigned long long v2 = lanes_[1];
+    unsigned long long v3 = lanes_[2];
+    unsigned long long v4 = lanes_[3];
+    while (size >= 32)
+    {
+        v1 = Round(v1, Read64(src));
+        v2 = Round(v2, Read64(src + 8));
+        v3 = Round(v3, Read64(src + 16));
+        v4 = Round(v4, Read64(src + 24));
+        src += 32;
+        size -= 32;
+    }
+    lanes_[0] = v1;
+    lanes_[1] = v2;
+    lanes_[2] = v3;
+    lanes_[3] = v4;
+    
+    if (size)
+    {
+        memcpy(buffer_, src, size);
+        bufferSize_ = size;
+    }
+}
+
+unsigned long long ContentHash::GetHash() const
+{
+    unsigned long long hash;
+    if (totalSize_ >= 32)
+    {
+        hash = RotateLeft(lanes_[0], 1) + RotateLeft(lanes_[1], 7) + RotateLeft(lanes_[2], 12) + RotateLeft(lanes_[3], 18);
+        hash = MergeRound(hash, lanes_[0]);
+        hash = MergeRound(hash, lanes_[1]);
+        hash = MergeRound(hash, lanes_[2]);
+        hash = MergeRound(hash, lanes_[3]);
+    }
+    else
+        hash = seed_ + PRIME5;
+    
+    hash += totalSize_;
+    
+    // Mix in the remaining bytes
+    const unsigned char* src = buffer_;
+    const unsigned char* end = buffer_ + bufferSize_;
+    while (src + 8 <= end)
+    {
+        hash ^= Round(0, Read64(src));
+        hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+        src += 8;
+    }
+    if (src + 4 <= end)
+    {
+        hash ^= (unsigned long long)Read32(src) * PRIME1;
+        hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+        src += 4;
+    }
+    while (src < end)
+    {
+        hash ^= *src * PRIME5;
+        hash = RotateLeft(hash, 11) * PRIME1;
+        ++src;
+    }
+    
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+unsigned ContentHash::GetChecksum() const
+{
+    unsigned long long hash = GetHash();
+    return (unsigned)(hash ^ (hash >> 32));
+}
+
+unsigned long long ContentHash::Calculate(const void* data, unsigned size, unsigned long long seed)
+{
+    ContentHash hash(seed);
+    hash.Update(data, size);
+    return hash.GetHash();
+}
+
+}
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D.h"
+
+namespace Urho3D
+{
+
+/// Fast 64-bit non-cryptographic hash of data content, using the xxHash64 algorithm. Processes 32-byte stripes in four independent lanes, and data can be added incrementally.
+class URHO3D_API ContentHash
+{
+public:
+    /// Construct with seed.
+    ContentHash(unsigned long long seed = 0);
+    
+    /// Begin a new hash with seed.
+    void Reset(unsigned long long seed = 0);
+    /// Add data to the hash.
+    void Update(const void* data, unsigned size);
+    
+    /// Return the hash of the data added so far.
+    unsigned long long GetHash() const;
+    /// Return the hash folded to 32 bits, as used for file, package and scene checksums.
+    unsigned GetChecksum() const;
+    
+    /// Calculate the hash of a data block.
+    static unsigned long long Calculate(const void* data, unsigned size, unsigned long long seed = 0);
+    
+private:
+    /// Lane accumulators.
+    unsigned long long lanes_[4];
+    /// Data not yet forming a complete stripe.
+    unsigned char buffer_[32];
+    /// Number of bytes in the buffer.
+    unsigned bufferSize_;
+    /// Total number of bytes added.
+    unsigned long long totalSize_;
+    /// Seed.
+    unsigned long long seed_;
+};
+
+}
@@ -23,6 +23,9 @@
 #include "Precompiled.h"
 #include "MathDefs.h"
 #include "StringHash.h"
+#ifdef URHO3D_HASH_DEBUG
+#include "StringHashRegister.h"
+#endif
 
 #include <cstdio>
 
@@ -36,11 +39,17 @@ const StringHash StringHash::ZERO;
 StringHash::StringHash(const char* str) :
     value_(Calculate(str))
 {
+    #ifdef URHO3D_HASH_DEBUG
+    RegisterString(*this, str);
+    #endif
 }
 
 StringHash::StringHash(const String& str) :
     value_(Calculate(str.CString()))
 {
+    #ifdef URHO3D_HASH_DEBUG
+    RegisterString(*this, str.CString());
+    #endif
 }
 
 unsigned StringHash::Calculate(const char* str)
@@ -52,9 +61,9 @@ unsigned StringHash::Calculate(const char* str)
     
     while (*str)
     {
-        // Perform the actual hashing as case-insensitive
-        char c = *str;
-        hash = SDBMHash(hash, tolower(c));
+        // Perform the actual hashing as case-insensitive. Use ASCII lowercase conversion instead of the locale-dependent
+        // tolower() so that the result matches CalculateConstant()
+        hash = SDBMHash(hash, ToLowerASCII(*str));
         ++str;
     }
     
@@ -68,4 +77,23 @@ String StringHash::ToString() const
     return String(tempBuffer);
 }
 
+#ifdef URHO3D_HASH_DEBUG
+String StringHash::Reverse() const
+{
+    return GetGlobalStringHashRegister()->GetString(*this);
+}
+
+void StringHash::RegisterString(const StringHash& hash, const char* str)
+{
+    GetGlobalStringHashRegister()->RegisterString(hash, str);
+}
+
+StringHashRegister* StringHash::GetGlobalStringHashRegister()
+{
+    // Function-local static so that the register exists before any static hash constant registers itself
+    static StringHashRegister globalRegister;
+    return &globalRegister;
+}
+#endif
+
 }
@@ -22,29 +22,32 @@
 
 #pragma once
 
+#include "MathDefs.h"
 #include "Str.h"
 
 namespace Urho3D
 {
 
+class StringHashRegister;
+
 /// 32-bit hash value for a string.
 class URHO3D_API StringHash
 {
 public:
     /// Construct with zero value.
-    StringHash() :
+    URHO3D_CONSTEXPR StringHash() :
         value_(0)
     {
     }
     
     /// Copy-construct from another hash.
-    StringHash(const StringHash& rhs) :
+    URHO3D_CONSTEXPR StringHash(const StringHash& rhs) :
         value_(rhs.value_)
     {
     }
     
     /// Construct with an initial value.
-    explicit StringHash(unsigned value) :
+    explicit URHO3D_CONSTEXPR StringHash(unsigned value) :
         value_(value)
     {
     }
@@ -77,24 +80,45 @@ public:
     }
     
     // Test for equality with another hash.
-    bool operator == (const StringHash& rhs) const { return value_ == rhs.value_; }
+    URHO3D_CONSTEXPR bool operator == (const StringHash& rhs) const { return value_ == rhs.value_; }
     /// Test for inequality with another hash.
-    bool operator != (const StringHash& rhs) const { return value_ != rhs.value_; }
+    URHO3D_CONSTEXPR bool operator != (const StringHash& rhs) const { return value_ != rhs.value_; }
     /// Test if less than another hash.
-    bool operator < (const StringHash& rhs) const { return value_ < rhs.value_; }
+    URHO3D_CONSTEXPR bool operator < (const StringHash& rhs) const { return value_ < rhs.value_; }
     /// Test if greater than another hash.
-    bool operator > (const StringHash& rhs) const { return value_ > rhs.value_; }
+    URHO3D_CONSTEXPR bool operator > (const StringHash& rhs) const { return value_ > rhs.value_; }
     /// Return true if nonzero hash value.
-    operator bool () const { return value_ != 0; }
-    /// Return hash value.
-    unsigned Value() const { return value_; }
+    URHO3D_CONSTEXPR operator bool () const { return value_ != 0; }
+    /// Return hash value. For hash constants with C++11 enabled this is a compile-time constant usable as a switch case label.
+    URHO3D_CONSTEXPR unsigned Value() const { return value_; }
     /// Return as string.
     String ToString() const;
     /// Return hash value for HashSet & HashMap.
-    unsigned ToHash() const { return value_; }
+    URHO3D_CONSTEXPR unsigned ToHash() const { return value_; }
     
     /// Calculate hash value case-insensitively from a C string.
     static unsigned Calculate(const char* str);
+    #ifdef URHO3D_CXX11
+    /// Calculate hash value case-insensitively from a C string at compile time. Gives the same result as Calculate().
+    static constexpr unsigned CalculateConstant(const char* str, unsigned hash = 0)
+    {
+        return (str && *str) ? CalculateConstant(str + 1, SDBMHash(hash, ToLowerASCII(*str))) : hash;
+    }
+    #endif
+    /// Convert an ASCII character to lowercase for hashing. Other characters, including UTF-8 sequence bytes, are returned unchanged.
+    static URHO3D_CONSTEXPR unsigned char ToLowerASCII(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : (unsigned char)c;
+    }
+    
+    #ifdef URHO3D_HASH_DEBUG
+    /// Return the string this hash was calculated from, or empty if it has not been registered.
+    String Reverse() const;
+    /// Register a string and its hash for collision detection and reverse lookup.
+    static void RegisterString(const StringHash& hash, const char* str);
+    /// Return the global string hash register.
+    static StringHashRegister* GetGlobalStringHashRegister();
+    #endif
     
     /// Zero hash.
     static const StringHash ZERO;
@@ -104,4 +128,22 @@ private:
     unsigned value_;
 };
 
+#ifdef URHO3D_HASH_DEBUG
+/// Registers a compile-time string hash constant to the global string hash register during static initialization.
+struct URHO3D_API StringHashRegistration
+{
+    /// Construct and register.
+    StringHashRegistration(const StringHash& hash, const char* str) { StringHash::RegisterString(hash, str); }
+};
+#endif
+
 }
+
+/// Define a string hash constant. With C++11 the hash is evaluated at compile time.
+#if defined(URHO3D_CXX11) && defined(URHO3D_HASH_DEBUG)
+#define STRINGHASH_CONSTANT(id, str) constexpr Urho3D::StringHash id(Urho3D::StringHash::CalculateConstant(str)); static const Urho3D::StringHashRegistration id##Registration_(id, str)
+#elif defined(URHO3D_CXX11)
+#define STRINGHASH_CONSTANT(id, str) constexpr Urho3D::StringHash id(Urho3D::StringHash::CalculateConstant(str))
+#else
+#define STRINGHASH_CONSTANT(id, str) const Urho3D::StringHash id(str)
+#endif
@@ -0,0 +1,458 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "Ray.h"
+#include "TriangleBVH.h"
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Number of bins along the split axis when evaluating split candidates.
+static const unsigned NUM_SPLIT_BINS = 16;
+
+/// Return half of the surface area of a bounding box.
+static inline float HalfSurfaceArea(const BoundingBox& box)
+{
+    Vector3 size = box.max_ - box.min_;
+    return size.x_ * size.y_ + size.y_ * size.z_ + size.z_ * size.x_;
+}
+
+/// Return number of triangle packets needed for a number of triangles.
+static inline unsigned GetNumPackets(unsigned numTriangles)
+{
+    return (numTriangles + TRIANGLE_PACKET_SIZE - 1) / TRIANGLE_PACKET_SIZE;
+}
+
+/// Narrow the ray distance range to the slab of a box along one axis. Return false if the range becomes empty.
+static inline bool ClipSlab(float min, float max, float origin, float direction, float invDirection, float& tMin, float& tMax)
+{
+    // A ray parallel to the slab never crosses its planes, so only check that the origin is between them. Computing the
+    // distances would multiply zero with infinity if the origin is on a plane
+    if (direction == 0.0f)
+        return origin >= min && origin <= max;
+    
+    float t1 = (min - origin) * invDirection;
+    float t2 = (max - origin) * invDirection;
+    tMin = Max(tMin, Min(t1, t2));
+    tMax = Min(tMax, Max(t1, t2));
+    return tMin <= tMax;
+}
+
+/// Return ray hit distance to a box given the ray direction and its inverse, or infinity if no hit.
+static inline float HitDistanceBox(const Vector3& min, const Vector3& max, const Vector3& origin, const Vector3& direction,
+    const Vector3& invDirection)
+{
+    float tMin = 0.0f;
+    float tMax = M_INFINITY;
+    
+    if (!ClipSlab(min.x_, max.x_, origin.x_, direction.x_, invDirection.x_, tMin, tMax) ||
+        !ClipSlab(min.y_, max.y_, origin.y_, direction.y_, invDirection.y_, tMin, tMax) ||
+        !ClipSlab(min.z_, max.z_, origin.z_, direction.z_, invDirection.z_, tMin, tMax))
+        return M_INFINITY;
+    
+    return tMin;
+}
+
+/// Test a ray against all triangles of a packet. Update the nearest distance and return the lane of the nearer hit, or M_MAX_UNSIGNED if none.
+static inline unsigned HitDistancePacket(const TrianglePacket& packet, const Vector3& origin, const Vector3& direction, float& nearest)
+{
+    float distances[TRIANGLE_PACKET_SIZE];
+    
+    // Same test as Ray::HitDistance() for a single triangle, written without branches so that the lanes can be vectorized
+    for (unsigned i = 0; i < TRIANGLE_PACKET_SIZE; ++i)
+    {
+        float e1x = packet.edge1_[0][i];
+        float e1y = packet.edge1_[1][i];
+        float e1z = packet.edge1_[2][i];
+        float e2x = packet.edge2_[0][i];
+        float e2y = packet.edge2_[1][i];
+        float e2z = packet.edge2_[2][i];
+        
+        float px = direction.y_ * e2z - direction.z_ * e2y;
+        float py = direction.z_ * e2x - direction.x_ * e2z;
+        float pz = direction.x_ * e2y - direction.y_ * e2x;
+        float det = e1x * px + e1y * py + e1z * pz;
+        
+        float tx = origin.x_ - packet.v0_[0][i];
+        float ty = origin.y_ - packet.v0_[1][i];
+        float tz = origin.z_ - packet.v0_[2][i];
+        float u = tx * px + ty * py + tz * pz;
+        
+        float qx = ty * e1z - tz * e1y;
+        float qy = tz * e1x - tx * e1z;
+        float qz = tx * e1y - ty * e1x;
+        float v = direction.x_ * qx + direction.y_ * qy + direction.z_ * qz;
+        float distance = (e2x * qx + e2y * qy + e2z * qz) / det;
+        
+        bool hit = (det >= M_EPSILON) & (u >= 0.0f) & (u <= det) & (v >= 0.0f) & (u + v <= det) & (distance >= 0.0f);
+        distances[i] = hit ? distance : M_INFINITY;
+    }
+    
+    unsigned hitLane = M_MAX_UNSIGNED;
+    for (unsigned i = 0; i < TRIANGLE_PACKET_SIZE; ++i)
+    {
+        if (distances[i] < nearest)
+        {
+            nearest = distances[i];
+            hitLane = i;
+        }
+    }
+    
+    return hitLane;
+}
+
+TriangleBVH::TriangleBVH() :
+    numTriangles_(0)
+{
+}
+
+TriangleBVH::~TriangleBVH()
+{
+}
+
+void TriangleBVH::Define(const void* vertexData, unsigned vertexSize, const void* indexData, unsigned indexSize, unsigned indexStart, unsigned indexCount)
+{
+    Clear();
+    
+    const unsigned char* vertices = (const unsigned char*)vertexData;
+    unsigned numVertices = indexCount / 3 * 3;
+    buildPositions_.Resize(numVertices);
+    
+    // 16-bit indices
+    if (indexSize == sizeof(unsigned short))
+    {
+        const unsigned short* indices = ((const unsigned short*)indexData) + indexStart;
+        for (unsigned i = 0; i < numVertices; ++i)
+            buildPositions_[i] = *((const Vector3*)(&vertices[indices[i] * vertexSize]));
+    }
+    // 32-bit indices
+    else
+    {
+        const unsigned* indices = ((const unsigned*)indexData) + indexStart;
+        for (unsigned i = 0; i < numVertices; ++i)
+            buildPositions_[i] = *((const Vector3*)(&vertices[indices[i] * vertexSize]));
+    }
+    
+    Build();
+}
+
+void TriangleBVH::Define(const void* vertexData, unsigned vertexSize, unsigned vertexStart, unsigned vertexCount)
+{
+    Clear();
+    
+    const unsigned char* vertices = ((const unsigned char*)vertexData) + vertexStart * vertexSize;
+    unsigned numVertices = vertexCount / 3 * 3;
+    buildPositions_.Resize(numVertices);
+    
+    for (unsigned i = 0; i < numVertices; ++i)
+        buildPositions_[i] = *((const Vector3*)(&vertices[i * vertexSize]));
+    
+    Build();
+}
+
+void TriangleBVH::Clear()
+{
+    nodes_.Clear();
+    packets_.Clear();
+    numTriangles_ = 0;
+}
+
+float TriangleBVH::HitDistance(const Ray& ray, Vector3* outNormal) const
+{
+    if (nodes_.Empty())
+        return M_INFINITY;
+    
+    const Vector3& origin = ray.origin_;
+    const Vector3& direction = ray.direction_;
+    // Division by zero gives infinity. The slab test skips the axes where the direction is zero
+    Vector3 invDirection(1.0f / direction.x_, 1.0f / direction.y_, 1.0f / direction.z_);
+    
+    if (HitDistanceBox(nodes_[0].min_, nodes_[0].max_, origin, direction, invDirection) == M_INFINITY)
+        return M_INFINITY;
+    
+    float nearest = M_INFINITY;
+    const TrianglePacket* hitPacket = 0;
+    unsigned hitLane = 0;
+    
+    // Each level of the hierarchy pushes at most one node
+    unsigned stack[BVH_MAX_DEPTH + 1];
+    float stackDistances[BVH_MAX_DEPTH + 1];
+    unsigned stackSize = 0;
+    unsigned nodeIndex = 0;
+    
+    for (;;)
+    {
+        const TriangleBVHNode& node = nodes_[nodeIndex];
+        
+        if (node.count_)
+        {
+            const TrianglePacket* packet = &packets_[node.first_];
+            const TrianglePacket* packetEnd = packet + GetNumPackets(node.count_);
+            for (; packet < packetEnd; ++packet)
+            {
+                unsigned lane = HitDistancePacket(*packet, origin, direction, nearest);
+                if (lane != M_MAX_UNSIGNED)
+                {
+                    hitPacket = packet;
+                    hitLane = lane;
+                }
+            }
+        }
+        else
+        {
+            // Descend into the nearer child first and defer the other one
+            unsigned first = node.first_;
+            unsigned second = node.first_ + 1;
+            float firstDistance = HitDistanceBox(nodes_[first].min_, nodes_[first].max_, origin, direction, invDirection);
+            float secondDistance = HitDistanceBox(nodes_[second].min_, nodes_[second].max_, origin, direction, invDirection);
+            if (secondDistance < firstDistance)
+            {
+                Swap(first, second);
+                Swap(firstDistance, secondDistance);
+            }
+            
+            if (firstDistance < nearest)
+            {
+                if (secondDistance < nearest)
+                {
+                    stack[stackSize] = second;
+                    stackDistances[stackSize] = secondDistance;
+                    ++stackSize;
+                }
+                nodeIndex = first;
+                continue;
+            }
+        }
+        
+        // Continue from the most recently deferred node that may still contain a nearer hit
+        bool found = false;
+        while (stackSize)
+        {
+            --stackSize;
+            if (stackDistances[stackSize] < nearest)
+            {
+                nodeIndex = stack[stackSize];
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            break;
+    }
+    
+    if (hitPacket && outNormal)
+    {
+        Vector3 edge1(hitPacket->edge1_[0][hitLane], hitPacket->edge1_[1][hitLane], hitPacket->edge1_[2][hitLane]);
+        Vector3 edge2(hitPacket->edge2_[0][hitLane], hitPacket->edge2_[1][hitLane], hitPacket->edge2_[2][hitLane]);
+        *outNormal = edge1.CrossProduct(edge2);
+    }
+    
+    return nearest;
+}
+
+BoundingBox TriangleBVH::GetBoundingBox() const
+{
+    return nodes_.Size() ? BoundingBox(nodes_[0].min_, nodes_[0].max_) : BoundingBox();
+}
+
+void TriangleBVH::Build()
+{
+    numTriangles_ = buildPositions_.Size() / 3;
+    
+    if (numTriangles_)
+    {
+        buildCentroids_.Resize(numTriangles_);
+        buildIndices_.Resize(numTriangles_);
+        for (unsigned i = 0; i < numTriangles_; ++i)
+        {
+            buildCentroids_[i] = (buildPositions_[i * 3] + buildPositions_[i * 3 + 1] + buildPositions_[i * 3 + 2]) * (1.0f / 3.0f);
+            buildIndices_[i] = i;
+        }
+        
+        nodes_.Reserve(numTriangles_ / BVH_MAX_LEAF_TRIANGLES * 2 + 1);
+        packets_.Reserve(numTriangles_ / TRIANGLE_PACKET_SIZE + 1);
+        nodes_.Resize(1);
+        BuildNode(0, 0, numTriangles_, 0);
+        nodes_.Compact();
+        packets_.Compact();
+    }
+    
+    // Release the build data
+    buildPositions_.Clear();
+    buildPositions_.Compact();
+    buildCentroids_.Clear();
+    buildCentroids_.Compact();
+    buildIndices_.Clear();
+    buildIndices_.Compact();
+}
+
+void TriangleBVH::BuildNode(unsigned nodeIndex, unsigned start, unsigned count, unsigned depth)
+{
+    unsigned end = start + count;
+    BoundingBox bounds;
+    BoundingBox centroidBounds;
+    for (unsigned i = start; i < end; ++i)
+    {
+        const Vector3* vertices = &buildPositions_[buildIndices_[i] * 3];
+        bounds.Merge(vertices, 3);
+        centroidBounds.Merge(buildCentroids_[buildIndices_[i]]);
+    }
+    
+    nodes_[nodeIndex].min_ = bounds.min_;
+    nodes_[nodeIndex].max_ = bounds.max_;
+    
+    // Split along the axis where the triangle centroids are spread the most
+    Vector3 centroidSize = centroidBounds.max_ - centroidBounds.min_;
+    unsigned axis = 0;
+    if (centroidSize.y_ > centroidSize.Data()[axis])
+        axis = 1;
+    if (centroidSize.z_ > centroidSize.Data()[axis])
+        axis = 2;
+    float axisMin = centroidBounds.min_.Data()[axis];
+    float axisSize = centroidSize.Data()[axis];
+    
+    if (count <= 1 || depth >= BVH_MAX_DEPTH || axisSize <= 0.0f)
+    {
+        MakeLeaf(nodeIndex, start, count);
+        return;
+    }
+    
+    // Bin the triangles by centroid and choose the bin boundary with the lowest surface area heuristic cost
+    BoundingBox binBounds[NUM_SPLIT_BINS];
+    unsigned binCounts[NUM_SPLIT_BINS];
+    for (unsigned i = 0; i < NUM_SPLIT_BINS; ++i)
+        binCounts[i] = 0;
+    
+    float binScale = (float)NUM_SPLIT_BINS / axisSize;
+    for (unsigned i = start; i < end; ++i)
+    {
+        unsigned triangle = buildIndices_[i];
+        unsigned bin = (unsigned)((buildCentroids_[triangle].Data()[axis] - axisMin) * binScale);
+        if (bin >= NUM_SPLIT_BINS)
+            bin = NUM_SPLIT_BINS - 1;
+        binBounds[bin].Merge(&buildPositions_[triangle * 3], 3);
+        ++binCounts[bin];
+    }
+    
+    float rightAreas[NUM_SPLIT_BINS];
+    unsigned rightCounts[NUM_SPLIT_BINS];
+    BoundingBox accumBounds;
+    unsigned accumCount = 0;
+    for (unsigned i = NUM_SPLIT_BINS - 1; i > 0; --i)
+    {
+        if (binCounts[i])
+        {
+            accumBounds.Merge(binBounds[i]);
+            accumCount += binCounts[i];
+        }
+        rightAreas[i] = accumCount ? HalfSurfaceArea(accumBounds) : 0.0f;
+        rightCounts[i] = accumCount;
+    }
+    
+    float bestCost = M_INFINITY;
+    unsigned bestSplit = M_MAX_UNSIGNED;
+    accumBounds = BoundingBox();
+    accumCount = 0;
+    for (unsigned i = 0; i < NUM_SPLIT_BINS - 1; ++i)
+    {
+        if (binCounts[i])
+        {
+            accumBounds.Merge(binBounds[i]);
+            accumCount += binCounts[i];
+        }
+        if (!accumCount || !rightCounts[i + 1])
+            continue;
+        
+        float cost = GetNumPackets(accumCount) * HalfSurfaceArea(accumBounds) + GetNumPackets(rightCounts[i + 1]) *
+            rightAreas[i + 1];
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+    
+    // Keep small ranges as a leaf when splitting would not reduce the expected number of packet tests
+    if (bestSplit == M_MAX_UNSIGNED || (count <= BVH_MAX_LEAF_TRIANGLES && bestCost >= GetNumPackets(count) *
+        HalfSurfaceArea(bounds)))
+    {
+        MakeLeaf(nodeIndex, start, count);
+        return;
+    }
+    
+    unsigned middle = start;
+    for (unsigned i = start; i < end; ++i)
+    {
+        unsigned triangle = buildIndices_[i];
+        unsigned bin = (unsigned)((buildCentroids_[triangle].Data()[axis] - axisMin) * binScale);
+        if (bin <= bestSplit)
+            Swap(buildIndices_[i], buildIndices_[middle++]);
+    }
+    
+    unsigned first = nodes_.Size();
+    nodes_.Resize(first + 2);
+    nodes_[nodeIndex].first_ = first;
+    nodes_[nodeIndex].count_ = 0;
+    
+    BuildNode(first, start, middle - start, depth + 1);
+    BuildNode(first + 1, middle, end - middle, depth + 1);
+}
+
+void TriangleBVH::MakeLeaf(unsigned nodeIndex, unsigned start, unsigned count)
+{
+    TriangleBVHNode& node = nodes_[nodeIndex];
+    node.first_ = packets_.Size();
+    node.count_ = count;
+    
+    unsigned numPackets = GetNumPackets(count);
+    packets_.Resize(node.first_ + numPackets);
+    
+    for (unsigned i = 0; i < numPackets * TRIANGLE_PACKET_SIZE; ++i)
+    {
+        TrianglePacket& packet = packets_[node.first_ + i / TRIANGLE_PACKET_SIZE];
+        unsigned lane = i % TRIANGLE_PACKET_SIZE;
+        
+        // Fill unused lanes with degenerate triangles, which never pass the determinant test
+        Vector3 v0(Vector3::ZERO);
+        Vector3 edge1(Vector3::ZERO);
+        Vector3 edge2(Vector3::ZERO);
+        if (i < count)
+        {
+            const Vector3* vertices = &buildPositions_[buildIndices_[start + i] * 3];
+            v0 = vertices[0];
+            edge1 = vertices[1] - vertices[0];
+            edge2 = vertices[2] - vertices[0];
+        }
+        
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            packet.v0_[j][lane] = v0.Data()[j];
+            packet.edge1_[j][lane] = edge1.Data()[j];
+            packet.edge2_[j][lane] = edge2.Data()[j];
+        }
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "BoundingBox.h"
+#include "Vector.h"
+
+namespace Urho3D
+{
+
+class Ray;
+
+/// Number of triangles tested at once in a triangle packet.
+static const unsigned TRIANGLE_PACKET_SIZE = 4;
+/// Maximum number of triangles in a triangle BVH leaf before it is split.
+static const unsigned BVH_MAX_LEAF_TRIANGLES = 4;
+/// Maximum depth of a triangle BVH.
+static const unsigned BVH_MAX_DEPTH = 48;
+
+/// Triangle BVH node.
+struct TriangleBVHNode
+{
+    /// Bounding box minimum.
+    Vector3 min_;
+    /// Bounding box maximum.
+    Vector3 max_;
+    /// Index of the first child for an inner node, or of the first triangle packet for a leaf.
+    unsigned first_;
+    /// Number of triangles for a leaf, or zero for an inner node.
+    unsigned count_;
+};
+
+/// Triangles in structure-of-arrays layout for testing against a ray at once. Unused triangles are degenerate.
+struct TrianglePacket
+{
+    /// First vertex positions, component-major.
+    float v0_[3][TRIANGLE_PACKET_SIZE];
+    /// First edge vectors, component-major.
+    float edge1_[3][TRIANGLE_PACKET_SIZE];
+    /// Second edge vectors, component-major.
+    float edge2_[3][TRIANGLE_PACKET_SIZE];
+};
+
+/// Bounding volume hierarchy of triangles for fast ray hit distance queries against large meshes.
+class URHO3D_API TriangleBVH
+{
+public:
+    /// Construct empty.
+    TriangleBVH();
+    /// Destruct.
+    ~TriangleBVH();
+    
+    /// Define from indexed triangle list data. Positions must be at the start of each vertex.
+    void Define(const void* vertexData, unsigned vertexSize, const void* indexData, unsigned indexSize, unsigned indexStart, unsigned indexCount);
+    /// Define from non-indexed triangle list data. Positions must be at the start of each vertex.
+    void Define(const void* vertexData, unsigned vertexSize, unsigned vertexStart, unsigned vertexCount);
+    /// Remove all triangles.
+    void Clear();
+    
+    /// Return ray hit distance or infinity if no hit. Optionally return the hit triangle's unnormalized normal.
+    float HitDistance(const Ray& ray, Vector3* outNormal = 0) const;
+    /// Return bounding box of all triangles.
+    BoundingBox GetBoundingBox() const;
+    /// Return number of triangles.
+    unsigned GetNumTriangles() const { return numTriangles_; }
+    /// Return number of nodes.
+    unsigned GetNumNodes() const { return nodes_.Size(); }
+    /// Return memory use in bytes.
+    unsigned GetMemoryUse() const { return nodes_.Size() * sizeof(TriangleBVHNode) + packets_.Size() * sizeof(TrianglePacket); }
+    /// Return whether is empty.
+    bool IsEmpty() const { return nodes_.Empty(); }
+    
+private:
+    /// Build from the triangle positions gathered into the build buffers.
+    void Build();
+    /// Build a node from a range of triangles.
+    void BuildNode(unsigned nodeIndex, unsigned start, unsigned count, unsigned depth);
+    /// Make a node a leaf and store its triangles into packets.
+    void MakeLeaf(unsigned nodeIndex, unsigned start, unsigned count);
+    
+    /// Nodes. The root is first and the children of an inner node are adjacent.
+    PODVector<TriangleBVHNode> nodes_;
+    /// Triangle packets in leaf order.
+    PODVector<TrianglePacket> packets_;
+    /// Triangle vertex positions during build.
+    PODVector<Vector3> buildPositions_;
+    /// Triangle centroids during build.
+    PODVector<Vector3> buildCentroids_;
+    /// Triangle order during build.
+    PODVector<unsigned> buildIndices_;
+    /// Number of triangles.
+    unsigned numTriangles_;
+};
+
+}
@@ -73,10 +73,18 @@ Connection::Connection(Context* context, bool isClient, kNet::SharedPtr<kNet::Me
     
     // Store address and port now for accurate logging (kNet may already have destroyed the socket on disconnection,
     // in which case we would log a zero address:port on disconnect)
-    kNet::EndPoint endPoint = connection_->RemoteEndPoint();
-    ///\todo Not IPv6-capable.
-    address_ = Urho3D::ToString("%d.%d.%d.%d", endPoint.ip[0], endPoint.ip[1], endPoint.ip[2], endPoint.ip[3]);
-    port_ = endPoint.port;
+    if (connection_)
+    {
+        kNet::EndPoint endPoint = connection_->RemoteEndPoint();
+        ///\todo Not IPv6-capable.
+        address_ = Urho3D::ToString("%d.%d.%d.%d", endPoint.ip[0], endPoint.ip[1], endPoint.ip[2], endPoint.ip[3]);
+        port_ = endPoint.port;
+    }
+    else
+    {
+        address_ = "0.0.0.0";
+        port_ = 0;
+    }
 }
 
 Connection::~Connection()
@@ -106,6 +114,10 @@ void Connection::SendMessage(int msgID, bool reliable, bool inOrder, const unsig
         return;
     }
     
+    // A replayed connection has nowhere to send to
+    if (!connection_)
+        return;
+    
     kNet::NetworkMessage *msg = connection_->StartNewMessage(msgID, numBytes);
     if (!msg)
     {
@@ -237,7 +249,8 @@ void Connection::SetLogStatistics(bool enable)
 
 void Connection::Disconnect(int waitMSec)
 {
-    connection_->Disconnect(waitMSec);
+    if (connection_)
+        connection_->Disconnect(waitMSec);
 }
 
 void Connection::SendServerUpdate()
@@ -282,7 +295,7 @@ void Connection::SendClientUpdate()
 void Connection::SendRemoteEvents()
 {
     #ifdef URHO3D_LOGGING
-    if (logStatistics_ && statsTimer_.GetMSec(false) > STATS_INTERVAL_MSEC)
+    if (logStatistics_ && connection_ && statsTimer_.GetMSec(false) > STATS_INTERVAL_MSEC)
     {
         statsTimer_.Reset();
         char statsBuffer[256];
@@ -320,7 +333,7 @@ void Connection::SendRemoteEvents()
 
 void Connection::SendPackages()
 {
-    while (!uploads_.Empty() && connection_->NumOutboundMessagesPending() < 1000)
+    while (!uploads_.Empty() && connection_ && connection_->NumOutboundMessagesPending() < 1000)
     {
         unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
         
@@ -980,7 +993,7 @@ Scene* Connection::GetScene() const
 
 bool Connection::IsConnected() const
 {
-    return connection_->GetConnectionState() == kNet::ConnectionOK;
+    return connection_ ? connection_->GetConnectionState() == kNet::ConnectionOK : true;
 }
 
 String Connection::ToString() const
@@ -988,6 +1001,31 @@ String Connection::ToString() const
     return GetAddress() + ":" + String(GetPort());
 }
 
+float Connection::GetRoundTripTime() const
+{
+    return connection_ ? connection_->RoundTripTime() : 0.0f;
+}
+
+float Connection::GetPacketsInPerSec() const
+{
+    return connection_ ? connection_->PacketsInPerSec() : 0.0f;
+}
+
+float Connection::GetPacketsOutPerSec() const
+{
+    return connection_ ? connection_->PacketsOutPerSec() : 0.0f;
+}
+
+float Connection::GetBytesInPerSec() const
+{
+    return connection_ ? connection_->BytesInPerSec() : 0.0f;
+}
+
+float Connection::GetBytesOutPerSec() const
+{
+    return connection_ ? connection_->BytesOutPerSec() : 0.0f;
+}
+
 unsigned Connection::GetNumDownloads() const
 {
     return downloads_.Size();
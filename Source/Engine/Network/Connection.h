@@ -107,7 +107,7 @@ class URHO3D_API Connection : public Object
     OBJECT(Connection);
     
 public:
-    /// Construct with context and kNet message connection pointers.
+    /// Construct with context and kNet message connection pointers. A connection without a kNet message connection is used for replaying recorded client traffic; it discards outgoing messages and stays connected until removed.
     Connection(Context* context, bool isClient, kNet::SharedPtr<kNet::MessageConnection> connection);
     /// Destruct.
     ~Connection();
@@ -177,6 +177,16 @@ public:
     unsigned short GetPort() const { return port_; }
     /// Return an address:port string.
     String ToString() const;
+    /// Return round trip time in milliseconds.
+    float GetRoundTripTime() const;
+    /// Return incoming packets per second.
+    float GetPacketsInPerSec() const;
+    /// Return outgoing packets per second.
+    float GetPacketsOutPerSec() const;
+    /// Return incoming bytes per second.
+    float GetBytesInPerSec() const;
+    /// Return outgoing bytes per second.
+    float GetBytesOutPerSec() const;
     /// Return number of package downloads remaining.
     unsigned GetNumDownloads() const;
     /// Return name of current package download, or empty if no downloads.
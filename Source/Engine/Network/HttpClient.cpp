@@ -0,0 +1,411 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "CoreEvents.h"
+#include "HttpClient.h"
+#include "Log.h"
+#include "NetworkEvents.h"
+#include "Profiler.h"
+#include "Thread.h"
+#include "Timer.h"
+#include "WorkQueue.h"
+
+#include <civetweb.h>
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+static const unsigned DEFAULT_MAX_WORKERS = 4;
+static const unsigned DEFAULT_MAX_IDLE_CONNECTIONS = 4;
+static const unsigned DEFAULT_KEEP_ALIVE_TIMEOUT = 15000;
+static const unsigned ERROR_BUFFER_SIZE = 256;
+static const unsigned READ_BUFFER_SIZE = 16384;
+
+/// HTTP client worker thread.
+class HttpWorkerThread : public Thread, public RefCounted
+{
+public:
+    /// Construct.
+    HttpWorkerThread(HttpClient* owner) :
+        owner_(owner)
+    {
+        SetName("HttpWorker");
+    }
+    
+    /// Execute queued requests until the client shuts down.
+    virtual void ThreadFunction()
+    {
+        for (;;)
+        {
+            HttpRequest* request = owner_->TakeRequest();
+            if (!request)
+                break;
+            owner_->ProcessRequest(request);
+        }
+    }
+    
+private:
+    /// HTTP client.
+    HttpClient* owner_;
+};
+
+HttpClient::HttpClient(Context* context) :
+    Object(context),
+    numBusyWorkers_(0),
+    maxWorkers_(DEFAULT_MAX_WORKERS),
+    maxIdleConnections_(DEFAULT_MAX_IDLE_CONNECTIONS),
+    keepAliveTimeout_(DEFAULT_KEEP_ALIVE_TIMEOUT),
+    shutDown_(false)
+{
+}
+
+HttpClient::~HttpClient()
+{
+    {
+        LockGuard<FastMutex> lock(mutex_);
+        queue_.Clear();
+        for (unsigned i = 0; i < requests_.Size(); ++i)
+            requests_[i]->aborted_ = true;
+        shutDown_ = true;
+        // Wake an idle worker, which passes the wakeup on to the rest
+        requestCondition_.Set();
+    }
+    
+    for (unsigned i = 0; i < threads_.Size(); ++i)
+        threads_[i]->Stop();
+    threads_.Clear();
+    
+    for (HashMap<String, PODVector<HttpIdleConnection> >::Iterator i = idleConnections_.Begin(); i != idleConnections_.End(); ++i)
+    {
+        for (unsigned j = 0; j < i->second_.Size(); ++j)
+            mg_close_connection(i->second_[j].connection_);
+    }
+}
+
+SharedPtr<HttpRequest> HttpClient::MakeRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData)
+{
+    PROFILE(MakeHttpRequest);
+    
+    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData));
+    requests_.Push(request);
+    // Track the requests and idle connections only while there are any
+    if (!HasSubscribedToEvent(E_BEGINFRAME))
+        SubscribeToEvent(E_BEGINFRAME, HANDLER(HttpClient, HandleBeginFrame));
+    
+    bool startWorker;
+    {
+        LockGuard<FastMutex> lock(mutex_);
+        queue_.Push(request);
+        startWorker = threads_.Size() < maxWorkers_ && queue_.Size() > threads_.Size() - numBusyWorkers_;
+        requestCondition_.Set();
+    }
+    
+    // Start a worker on demand if the queued requests outnumber the idle workers
+    if (startWorker)
+    {
+        SharedPtr<HttpWorkerThread> thread(new HttpWorkerThread(this));
+        WorkQueue* queue = GetSubsystem<WorkQueue>();
+        if (queue)
+            thread->SetAffinity(queue->GetReservedCPUs());
+        if (thread->Run())
+            threads_.Push(thread);
+        else
+            LOGERROR("Failed to start HTTP worker thread");
+    }
+    
+    return request;
+}
+
+void HttpClient::SetMaxWorkers(unsigned num)
+{
+    maxWorkers_ = Max((int)num, 1);
+}
+
+void HttpClient::SetMaxIdleConnections(unsigned num)
+{
+    maxIdleConnections_ = num;
+}
+
+void HttpClient::SetKeepAliveTimeout(unsigned ms)
+{
+    keepAliveTimeout_ = ms;
+}
+
+HttpRequest* HttpClient::TakeRequest()
+{
+    LockGuard<FastMutex> lock(mutex_);
+    
+    for (;;)
+    {
+        // Pass the shutdown wakeup on to the next idle worker
+        if (shutDown_)
+        {
+            requestCondition_.Set();
+            return 0;
+        }
+        
+        while (!queue_.Empty())
+        {
+            HttpRequest* request = queue_.Front();
+            queue_.PopFront();
+            // Skip requests which expired while queued
+            if (request->aborted_)
+            {
+                request->SetClosed();
+                continue;
+            }
+            
+            // Several wakeups may have collapsed into one, so wake another worker for the remaining requests
+            if (!queue_.Empty())
+                requestCondition_.Set();
+            ++numBusyWorkers_;
+            return request;
+        }
+        
+        requestCondition_.Wait(mutex_);
+    }
+}
+
+void HttpClient::ProcessRequest(HttpRequest* request)
+{
+    String protocol = "http";
+    String host;
+    String path = "/";
+    int port = 80;
+    
+    const String& url = request->url_;
+    unsigned protocolEnd = url.Find("://");
+    if (protocolEnd != String::NPOS)
+    {
+        protocol = url.Substring(0, protocolEnd);
+        host = url.Substring(protocolEnd + 3);
+    }
+    else
+        host = url;
+    
+    unsigned pathStart = host.Find('/');
+    if (pathStart != String::NPOS)
+    {
+        path = host.Substring(pathStart);
+        host = host.Substring(0, pathStart);
+    }
+    
+    unsigned portStart = host.Find(':');
+    if (portStart != String::NPOS)
+    {
+        port = ToInt(host.Substring(portStart + 1));
+        host = host.Substring(0, portStart);
+    }
+    
+    int useSSL = protocol.Compare("https", false) ? 0 : 1;
+    String hostKey = protocol.ToLower() + "://" + host.ToLower() + ":" + String(port);
+    // HEAD responses may announce a content length without sending a body, so do not try to reuse their connections
+    bool isHead = !request->verb_.Compare("HEAD", false);
+    
+    // Use HTTP/1.0 to rule out chunked responses, and ask for keep-alive explicitly
+    String requestStr = request->verb_ + " " + path + " HTTP/1.0\r\nHost: " + host + "\r\n";
+    if (!isHead)
+        requestStr += "Connection: keep-alive\r\n";
+    for (unsigned i = 0; i < request->headers_.Size(); ++i)
+    {
+        // Trim and only add non-empty header strings
+        String header = request->headers_[i].Trimmed();
+        if (header.Length())
+            requestStr += header + "\r\n";
+    }
+    if (!request->postData_.Empty())
+        requestStr += "Content-Length: " + String(request->postData_.Length()) + "\r\n";
+    requestStr += "\r\n";
+    requestStr += request->postData_;
+    
+    char errorBuffer[ERROR_BUFFER_SIZE];
+    memset(errorBuffer, 0, sizeof(errorBuffer));
+    
+    // Try an idle connection to the same host first. If the server has closed it in the meanwhile, fall back to a new connection
+    mg_connection* connection = GetIdleConnection(hostKey);
+    if (connection && !mg_download_next(connection, errorBuffer, sizeof(errorBuffer), "%s", requestStr.CString()))
+    {
+        mg_close_connection(connection);
+        connection = 0;
+    }
+    
+    // Initiate a new connection. This may block due to DNS query
+    /// \todo SSL mode will not actually work unless Civetweb's SSL mode is initialized with an external SSL DLL
+    if (!connection)
+        connection = mg_download(host.CString(), port, useSSL, errorBuffer, sizeof(errorBuffer), "%s", requestStr.CString());
+    
+    if (!connection)
+        request->SetError(String(&errorBuffer[0]));
+    else
+    {
+        const mg_request_info* info = mg_get_request_info(connection);
+        // For a response, Civetweb stores the protocol version in the method and the status code in the URI
+        String version(info->request_method);
+        int statusCode = ToInt(info->uri);
+        request->SetOpen(statusCode);
+        
+        const char* contentLengthStr = mg_get_header(connection, "Content-Length");
+        long long contentLength = contentLengthStr ? (long long)ToUInt(contentLengthStr) : -1;
+        long long received = 0;
+        
+        // Responses to HEAD, and informational, No Content and Not Modified responses never have a body
+        bool hasBody = !isHead && statusCode >= 200 && statusCode != 204 && statusCode != 304;
+        if (!hasBody)
+            contentLength = 0;
+        
+        // Skip reading an empty body, as Civetweb would read a zero content length until the connection closes
+        unsigned char readBuffer[READ_BUFFER_SIZE];
+        if (hasBody && contentLength != 0)
+        {
+            while (!request->aborted_)
+            {
+                int bytesRead = mg_read(connection, readBuffer, sizeof(readBuffer));
+                if (bytesRead <= 0)
+                    break;
+                request->AppendData(readBuffer, bytesRead);
+                received += bytesRead;
+            }
+        }
+        
+        // Reuse the connection only if the response body was delimited and fully read, and the server agreed to keep-alive
+        const char* connectionHeader = mg_get_header(connection, "Connection");
+        bool serverKeepAlive = connectionHeader ? !String::Compare(connectionHeader, "keep-alive", false) :
+            version == "HTTP/1.1";
+        if (!isHead && serverKeepAlive && contentLength >= 0 && received == contentLength && !request->aborted_)
+            ReleaseConnection(hostKey, connection);
+        else
+            mg_close_connection(connection);
+        
+        request->SetClosed();
+    }
+    
+    LockGuard<FastMutex> lock(mutex_);
+    --numBusyWorkers_;
+}
+
+mg_connection* HttpClient::GetIdleConnection(const String& hostKey)
+{
+    LockGuard<FastMutex> lock(mutex_);
+    
+    HashMap<String, PODVector<HttpIdleConnection> >::Iterator i = idleConnections_.Find(hostKey);
+    if (i == idleConnections_.End() || i->second_.Empty())
+        return 0;
+    
+    // Take the most recently used connection, as it is the least likely to have been closed by the server
+    mg_connection* connection = i->second_.Back().connection_;
+    i->second_.Pop();
+    return connection;
+}
+
+void HttpClient::ReleaseConnection(const String& hostKey, mg_connection* connection)
+{
+    {
+        LockGuard<FastMutex> lock(mutex_);
+        
+        PODVector<HttpIdleConnection>& connections = idleConnections_[hostKey];
+        if (connections.Size() < maxIdleConnections_)
+        {
+            HttpIdleConnection idle;
+            idle.connection_ = connection;
+            idle.idleTime_ = Time::GetSystemTime();
+            connections.Push(idle);
+            return;
+        }
+    }
+    
+    mg_close_connection(connection);
+}
+
+void HttpClient::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    using namespace HttpRequestFinished;
+    
+    for (unsigned i = 0; i < requests_.Size();)
+    {
+        HttpRequest* request = requests_[i];
+        HttpRequestState state = request->GetState();
+        bool finished = state == HTTP_CLOSED || state == HTTP_ERROR;
+        
+        // If only referred to by this subsystem, the request has expired: abort it and stop tracking when finished
+        if (request->Refs() == 1)
+        {
+            request->aborted_ = true;
+            if (finished)
+                requests_.Erase(i);
+            else
+                ++i;
+            continue;
+        }
+        
+        if (finished)
+        {
+            // Hold a reference during the event, as the handler may release the caller's
+            SharedPtr<HttpRequest> finishedRequest(request);
+            requests_.Erase(i);
+            
+            VariantMap& newEventData = GetEventDataMap();
+            newEventData[P_REQUEST] = finishedRequest.Get();
+            newEventData[P_STATUSCODE] = finishedRequest->GetStatusCode();
+            newEventData[P_SUCCESS] = state == HTTP_CLOSED;
+            SendEvent(E_HTTPREQUESTFINISHED, newEventData);
+        }
+        else
+            ++i;
+    }
+    
+    // Close connections which have been idle too long, before the server closes them
+    PODVector<mg_connection*> expired;
+    unsigned now = Time::GetSystemTime();
+    
+    bool idle;
+    {
+        LockGuard<FastMutex> lock(mutex_);
+        for (HashMap<String, PODVector<HttpIdleConnection> >::Iterator i = idleConnections_.Begin(); i != idleConnections_.End();)
+        {
+            PODVector<HttpIdleConnection>& connections = i->second_;
+            for (unsigned j = connections.Size() - 1; j < connections.Size(); --j)
+            {
+                if (now - connections[j].idleTime_ >= keepAliveTimeout_)
+                {
+                    expired.Push(connections[j].connection_);
+                    connections.Erase(j);
+                }
+            }
+            if (connections.Empty())
+                i = idleConnections_.Erase(i);
+            else
+                ++i;
+        }
+        idle = requests_.Empty() && idleConnections_.Empty();
+    }
+    
+    for (unsigned i = 0; i < expired.Size(); ++i)
+        mg_close_connection(expired[i]);
+    
+    if (idle)
+        UnsubscribeFromEvent(E_BEGINFRAME);
+}
+
+}
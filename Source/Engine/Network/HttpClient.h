@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Condition.h"
+#include "HashMap.h"
+#include "HttpRequest.h"
+#include "List.h"
+#include "Object.h"
+
+struct mg_connection;
+
+namespace Urho3D
+{
+
+class HttpWorkerThread;
+
+/// Idle keep-alive connection to a host.
+struct HttpIdleConnection
+{
+    /// Civetweb connection.
+    mg_connection* connection_;
+    /// System time in milliseconds when the connection became idle.
+    unsigned idleTime_;
+};
+
+/// %HTTP client subsystem. Executes queued HTTP requests in a pool of worker threads, keeps connections to each host alive for reuse, and sends an event when each request finishes.
+class URHO3D_API HttpClient : public Object
+{
+    OBJECT(HttpClient);
+    
+    friend class HttpWorkerThread;
+    
+public:
+    /// Construct.
+    HttpClient(Context* context);
+    /// Destruct. Abort the requests in progress and close the connections.
+    ~HttpClient();
+    
+    /// Queue an HTTP request to the specified URL. Empty verb defaults to a GET request. Return a request object which can be used to read the response data. The request is aborted if the object expires before it has finished.
+    SharedPtr<HttpRequest> MakeRequest(const String& url, const String& verb = String::EMPTY, const Vector<String>& headers = Vector<String>(), const String& postData = String::EMPTY);
+    /// Set maximum number of worker threads. Workers are started on demand; lowering the maximum does not stop workers already started.
+    void SetMaxWorkers(unsigned num);
+    /// Set maximum number of idle connections kept alive per host.
+    void SetMaxIdleConnections(unsigned num);
+    /// Set how long in milliseconds an idle connection is kept alive.
+    void SetKeepAliveTimeout(unsigned ms);
+    
+    /// Return maximum number of worker threads.
+    unsigned GetMaxWorkers() const { return maxWorkers_; }
+    /// Return number of worker threads started.
+    unsigned GetNumWorkers() const { return threads_.Size(); }
+    /// Return maximum number of idle connections kept alive per host.
+    unsigned GetMaxIdleConnections() const { return maxIdleConnections_; }
+    /// Return how long in milliseconds an idle connection is kept alive.
+    unsigned GetKeepAliveTimeout() const { return keepAliveTimeout_; }
+    /// Return number of requests queued or in progress.
+    unsigned GetNumPendingRequests() const { return requests_.Size(); }
+    
+private:
+    /// Wait for the next queued request, or return null when shutting down. Called by the worker threads.
+    HttpRequest* TakeRequest();
+    /// Execute a request. Called by the worker threads.
+    void ProcessRequest(HttpRequest* request);
+    /// Return an idle connection to a host for reuse, or null if none.
+    mg_connection* GetIdleConnection(const String& hostKey);
+    /// Store a connection for reuse, or close it if the host already has enough idle connections.
+    void ReleaseConnection(const String& hostKey, mg_connection* connection);
+    /// Handle frame begin event. Abort expired requests, send finished events and close timed out connections.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    
+    /// Worker threads.
+    Vector<SharedPtr<HttpWorkerThread> > threads_;
+    /// Requests queued or in progress. Accessed only by the main thread.
+    Vector<SharedPtr<HttpRequest> > requests_;
+    /// Queue of requests waiting for a worker. Pointers are kept valid by the requests vector.
+    List<HttpRequest*> queue_;
+    /// Idle connections by host.
+    HashMap<String, PODVector<HttpIdleConnection> > idleConnections_;
+    /// Mutex for the queue and the idle connections.
+    FastMutex mutex_;
+    /// Condition for waking idle workers when requests are queued or on shutdown.
+    Condition requestCondition_;
+    /// Number of workers executing a request.
+    unsigned numBusyWorkers_;
+    /// Maximum number of worker threads.
+    unsigned maxWorkers_;
+    /// Maximum number of idle connections per host.
+    unsigned maxIdleConnections_;
+    /// Idle connection keep-alive time in milliseconds.
+    unsigned keepAliveTimeout_;
+    /// Shutdown flag for the worker threads.
+    bool shutDown_;
+};
+
+}
@@ -23,173 +23,32 @@
 #include "Precompiled.h"
 #include "HttpRequest.h"
 #include "Log.h"
-#include "Profiler.h"
 #include "Timer.h"
 
-#include <civetweb.h>
-
 #include "DebugNew.h"
 
 namespace Urho3D
 {
 
-static const unsigned ERROR_BUFFER_SIZE = 256;
-static const unsigned READ_BUFFER_SIZE = 65536; // Must be a power of two
-
 HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData) :
     url_(url.Trimmed()),
     verb_(!verb.Empty() ? verb : "GET"),
     headers_(headers),
     postData_(postData),
     state_(HTTP_INITIALIZING),
-    httpReadBuffer_(new unsigned char[READ_BUFFER_SIZE]),
-    readBuffer_(new unsigned char[READ_BUFFER_SIZE]),
+    statusCode_(0),
     readPosition_(0),
-    writePosition_(0)
+    aborted_(false)
 {
     // Size of response is unknown, so just set maximum value. The position will also be changed
     // to maximum value once the request is done, signaling end for Deserializer::IsEof().
     size_ = M_MAX_UNSIGNED;
     
     LOGDEBUG("HTTP " + verb_ + " request to URL " + url_);
-    
-    // Start the worker thread to actually create the connection and read the response data.
-    Run();
 }
 
 HttpRequest::~HttpRequest()
 {
-    Stop();
-}
-
-void HttpRequest::ThreadFunction()
-{
-    String protocol = "http";
-    String host;
-    String path = "/";
-    int port = 80;
-    
-    unsigned protocolEnd = url_.Find("://");
-    if (protocolEnd != String::NPOS)
-    {
-        protocol = url_.Substring(0, protocolEnd);
-        host = url_.Substring(protocolEnd + 3);
-    }
-    else
-        host = url_;
-    
-    unsigned pathStart = host.Find('/');
-    if (pathStart != String::NPOS)
-    {
-        path = host.Substring(pathStart);
-        host = host.Substring(0, pathStart);
-    }
-    
-    unsigned portStart = host.Find(':');
-    if (portStart != String::NPOS)
-    {
-        port = ToInt(host.Substring(portStart + 1));
-        host = host.Substring(0, portStart);
-    }
-    
-    char errorBuffer[ERROR_BUFFER_SIZE];
-    memset(errorBuffer, 0, sizeof(errorBuffer));
-    
-    String headersStr;
-    for (unsigned i = 0; i < headers_.Size(); ++i)
-    {
-        // Trim and only add non-empty header strings
-        String header = headers_[i].Trimmed();
-        if (header.Length())
-            headersStr += header + "\r\n";
-    }
-    
-    // Initiate the connection. This may block due to DNS query
-    /// \todo SSL mode will not actually work unless Civetweb's SSL mode is initialized with an external SSL DLL
-    mg_connection* connection = 0;
-    if (postData_.Empty())
-    {
-        connection = mg_download(host.CString(), port, protocol.Compare("https", false) ? 0 : 1, errorBuffer, sizeof(errorBuffer),
-            "%s %s HTTP/1.0\r\n"
-            "Host: %s\r\n"
-            "%s"
-            "\r\n", verb_.CString(), path.CString(), host.CString(), headersStr.CString());
-    }
-    else
-    {
-        connection = mg_download(host.CString(), port, protocol.Compare("https", false) ? 0 : 1, errorBuffer, sizeof(errorBuffer),
-            "%s %s HTTP/1.0\r\n"
-            "Host: %s\r\n"
-            "%s"
-            "Content-Length: %d\r\n"
-            "\r\n"
-            "%s", verb_.CString(), path.CString(), host.CString(), headersStr.CString(), postData_.Length(), postData_.CString());
-    }
-    
-    {
-        MutexLock lock(mutex_);
-        state_ = connection ? HTTP_OPEN : HTTP_ERROR;
-        
-        // If no connection could be made, store the error and exit
-        if (state_ == HTTP_ERROR)
-        {
-            error_ = String(&errorBuffer[0]);
-            return;
-        }
-    }
-    
-    // Loop while should run, read data from the connection, copy to the main thread buffer if there is space
-    while (shouldRun_)
-    {
-        // Read less than full buffer to be able to distinguish between full and empty ring buffer. Reading may block
-        int bytesRead = mg_read(connection, httpReadBuffer_.Get(), READ_BUFFER_SIZE / 4);
-        if (bytesRead <= 0)
-            break;
-        
-        mutex_.Acquire();
-        
-        // Wait until enough space in the main thread's ring buffer
-        for (;;)
-        {
-            unsigned spaceInBuffer = READ_BUFFER_SIZE - ((writePosition_ - readPosition_) & (READ_BUFFER_SIZE - 1));
-            if ((int)spaceInBuffer > bytesRead || !shouldRun_)
-                break;
-            
-            mutex_.Release();
-            Time::Sleep(5);
-            mutex_.Acquire();
-        }
-        
-        if (!shouldRun_)
-        {
-            mutex_.Release();
-            break;
-        }
-        
-        if (writePosition_ + bytesRead <= READ_BUFFER_SIZE)
-            memcpy(readBuffer_.Get() + writePosition_, httpReadBuffer_.Get(), bytesRead);
-        else
-        {
-            // Handle ring buffer wrap
-            unsigned part1 = READ_BUFFER_SIZE - writePosition_;
-            unsigned part2 = bytesRead - part1;
-            memcpy(readBuffer_.Get() + writePosition_, httpReadBuffer_.Get(), part1);
-            memcpy(readBuffer_.Get(), httpReadBuffer_.Get() + part1, part2);
-        }
-        
-        writePosition_ += bytesRead;
-        writePosition_ &= READ_BUFFER_SIZE - 1;
-        
-        mutex_.Release();
-    }
-    
-    // Close the connection
-    mg_close_connection(connection);
-    
-    {
-        MutexLock lock(mutex_);
-        state_ = HTTP_CLOSED;
-    }
 }
 
 unsigned HttpRequest::Read(void* dest, unsigned size)
@@ -220,22 +79,23 @@ unsigned HttpRequest::Read(void* dest, unsigned size)
             if (bytesAvailable > sizeLeft)
                 bytesAvailable = sizeLeft;
             
-            if (readPosition_ + bytesAvailable <= READ_BUFFER_SIZE)
-                memcpy(destPtr, readBuffer_.Get() + readPosition_, bytesAvailable);
-            else
-            {
-                // Handle ring buffer wrap
-                unsigned part1 = READ_BUFFER_SIZE - readPosition_;
-                unsigned part2 = bytesAvailable - part1;
-                memcpy(destPtr, readBuffer_.Get() + readPosition_, part1);
-                memcpy(destPtr + part1, readBuffer_.Get(), part2);
-            }
-            
+            memcpy(destPtr, &buffer_[readPosition_], bytesAvailable);
             readPosition_ += bytesAvailable;
-            readPosition_ &= READ_BUFFER_SIZE - 1;
             sizeLeft -= bytesAvailable;
             totalRead += bytesAvailable;
             destPtr += bytesAvailable;
+            
+            // Discard the data already read once it makes up most of the buffer
+            if (readPosition_ == buffer_.Size())
+            {
+                buffer_.Clear();
+                readPosition_ = 0;
+            }
+            else if (readPosition_ >= buffer_.Size() / 2)
+            {
+                buffer_.Erase(0, readPosition_);
+                readPosition_ = 0;
+            }
         }
         
         if (!sizeLeft || !bytesAvailable)
@@ -267,15 +127,49 @@ HttpRequestState HttpRequest::GetState() const
     return state_;
 }
 
+int HttpRequest::GetStatusCode() const
+{
+    MutexLock lock(mutex_);
+    return statusCode_;
+}
+
 unsigned HttpRequest::GetAvailableSize() const
 {
     MutexLock lock(mutex_);
     return const_cast<HttpRequest*>(this)->CheckEofAndAvailableSize();
 }
 
+void HttpRequest::SetOpen(int statusCode)
+{
+    MutexLock lock(mutex_);
+    statusCode_ = statusCode;
+    state_ = HTTP_OPEN;
+}
+
+void HttpRequest::AppendData(const void* data, unsigned size)
+{
+    MutexLock lock(mutex_);
+    unsigned oldSize = buffer_.Size();
+    buffer_.Resize(oldSize + size);
+    memcpy(&buffer_[oldSize], data, size);
+}
+
+void HttpRequest::SetClosed()
+{
+    MutexLock lock(mutex_);
+    state_ = HTTP_CLOSED;
+}
+
+void HttpRequest::SetError(const String& error)
+{
+    MutexLock lock(mutex_);
+    error_ = error;
+    state_ = HTTP_ERROR;
+}
+
 unsigned HttpRequest::CheckEofAndAvailableSize()
 {
-    unsigned bytesAvailable = (writePosition_ - readPosition_) & (READ_BUFFER_SIZE - 1);
+    unsigned bytesAvailable = buffer_.Size() - readPosition_;
     if (state_ == HTTP_ERROR || (state_ == HTTP_CLOSED && !bytesAvailable))
         position_ = M_MAX_UNSIGNED;
     return bytesAvailable;
@@ -22,15 +22,15 @@
 
 #pragma once
 
-#include "ArrayPtr.h"
 #include "Deserializer.h"
 #include "Mutex.h"
 #include "RefCounted.h"
-#include "Thread.h"
 
 namespace Urho3D
 {
 
+class HttpClient;
+
 /// HTTP connection state
 enum HttpRequestState
 {
@@ -40,19 +40,18 @@ enum HttpRequestState
     HTTP_CLOSED
 };
 
-/// An HTTP connection with response data stream.
-class HttpRequest : public RefCounted, public Deserializer, public Thread
+/// An HTTP request with response data stream. Executed by the HttpClient subsystem's worker threads.
+class URHO3D_API HttpRequest : public RefCounted, public Deserializer
 {
+    friend class HttpClient;
+    
 public:
-    /// Construct with parameters.
+    /// Construct with parameters. The request is not executed until queued to the HttpClient subsystem.
     HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData);
-    /// Destruct. Release the connection object.
+    /// Destruct.
     ~HttpRequest();
     
-    /// Process the connection in the worker thread until closed.
-    virtual void ThreadFunction();
-    
-    /// Read response data from the HTTP connection and return number of bytes actually read. While the connection is open, will block while trying to read the specified size. To avoid blocking, only read up to as many bytes as GetAvailableSize() returns.
+    /// Read response data and return number of bytes actually read. While the connection is open, will block while trying to read the specified size. To avoid blocking, only read up to as many bytes as GetAvailableSize() returns.
     virtual unsigned Read(void* dest, unsigned size);
     /// Set position from the beginning of the stream. Not supported.
     virtual unsigned Seek(unsigned position);
@@ -65,12 +64,22 @@ public:
     String GetError() const;
     /// Return connection state.
     HttpRequestState GetState() const;
-    /// Return amount of bytes in the read buffer.
+    /// Return HTTP status code of the response, or 0 if no response has been received.
+    int GetStatusCode() const;
+    /// Return amount of bytes received and not yet read.
     unsigned GetAvailableSize() const;
     /// Return whether connection is in the open state.
     bool IsOpen() const { return GetState() == HTTP_OPEN; }
     
 private:
+    /// Set the response status and enter the open state. Called by a worker thread.
+    void SetOpen(int statusCode);
+    /// Append received response data. Called by a worker thread.
+    void AppendData(const void* data, unsigned size);
+    /// Enter the closed state. Called by a worker thread.
+    void SetClosed();
+    /// Enter the error state. Called by a worker thread.
+    void SetError(const String& error);
     /// Check for end of the data stream and return available size in buffer. Must only be called when the mutex is held by the main thread.
     unsigned CheckEofAndAvailableSize();
     
@@ -86,16 +95,16 @@ private:
     String postData_;
     /// Connection state.
     HttpRequestState state_;
+    /// HTTP status code of the response.
+    int statusCode_;
     /// Mutex for synchronizing the worker and the main thread.
     mutable Mutex mutex_;
-    /// Read buffer for the worker thread.
-    SharedArrayPtr<unsigned char> httpReadBuffer_;
-    /// Read buffer for the main thread.
-    SharedArrayPtr<unsigned char> readBuffer_;
-    /// Read buffer read cursor.
+    /// Received response data.
+    PODVector<unsigned char> buffer_;
+    /// Read cursor into the received data.
     unsigned readPosition_;
-    /// Read buffer write cursor.
-    unsigned writePosition_;
+    /// Abort flag. Set by the HttpClient when the request object has expired.
+    volatile bool aborted_;
 };
 
 }
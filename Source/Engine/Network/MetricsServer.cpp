@@ -0,0 +1,641 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Precompiled.h"
+#include "Connection.h"
+#include "Context.h"
+#include "CoreEvents.h"
+#include "Log.h"
+#include "MetricsServer.h"
+#include "Network.h"
+#include "Profiler.h"
+#include "ResourceCache.h"
+#include "Scene.h"
+#include "WorkQueue.h"
+
+#include <civetweb.h>
+#include <cstdio>
+
+#include "DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Upper bounds of the finite frame time histogram buckets in microseconds.
+static const long long frameTimeBucketBounds[NUM_FRAME_TIME_BUCKETS] =
+{
+    1000,
+    2000,
+    5000,
+    10000,
+    16667,
+    33333,
+    50000,
+    100000,
+    250000,
+    1000000
+};
+
+static const float DEFAULT_SNAPSHOT_INTERVAL = 1.0f;
+static const char* NUM_SERVER_THREADS = "2";
+
+static void AppendNumber(String& dest, double value)
+{
+    char buffer[64];
+    sprintf(buffer, "%.9g", value);
+    dest += (const char*)buffer;
+}
+
+static String EscapeLabel(const String& value)
+{
+    String ret;
+    ret.Reserve(value.Length());
+    for (unsigned i = 0; i < value.Length(); ++i)
+    {
+        char c = value[i];
+        if (c == '\\' || c == '"')
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if (c == '\n')
+            ret += "\\n";
+        else
+            ret += c;
+    }
+    return ret;
+}
+
+static String EscapeJSON(const String& value)
+{
+    String ret;
+    ret.Reserve(value.Length() + 2);
+    ret += '"';
+    for (unsigned i = 0; i < value.Length(); ++i)
+    {
+        unsigned char c = (unsigned char)value[i];
+        if (c == '\\' || c == '"')
+        {
+            ret += '\\';
+            ret += (char)c;
+        }
+        else if (c < 0x20)
+        {
+            char buffer[8];
+            sprintf(buffer, "\\u%04x", c);
+            ret += (const char*)buffer;
+        }
+        else
+            ret += (char)c;
+    }
+    ret += '"';
+    return ret;
+}
+
+static void AppendHeader(String& dest, const char* name, const char* type, const char* help)
+{
+    dest += "# HELP ";
+    dest += name;
+    dest += " ";
+    dest += help;
+    dest += "\n# TYPE ";
+    dest += name;
+    dest += " ";
+    dest += type;
+    dest += "\n";
+}
+
+static void AppendSample(String& dest, const char* name, const String& labels, double value)
+{
+    dest += name;
+    if (!labels.Empty())
+        dest += "{" + labels + "}";
+    dest += " ";
+    AppendNumber(dest, value);
+    dest += "\n";
+}
+
+static int HandleMetricsRequest(mg_connection* conn, void* cbdata)
+{
+    MetricsServer* server = static_cast<MetricsServer*>(cbdata);
+    const mg_request_info* info = mg_get_request_info(conn);
+    String uri(info->uri);
+    
+    String body;
+    const char* contentType = "application/json";
+    if (uri == "/metrics")
+    {
+        body = server->GetMetricsText();
+        contentType = "text/plain; version=0.0.4";
+    }
+    else if (uri == "/stats/scene")
+        body = server->GetSceneStatsJSON();
+    else if (uri == "/stats/resources")
+        body = server->GetResourceStatsJSON();
+    else
+    {
+        mg_printf(conn, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        return 1;
+    }
+    
+    mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %u\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n",
+        contentType, body.Length());
+    if (strcmp(info->request_method, "HEAD"))
+        mg_write(conn, body.CString(), body.Length());
+    return 1;
+}
+
+static void GetProfilerBlocks(const ProfilerBlock* block, const String& parentPath, Vector<MetricsProfilerBlock>& dest)
+{
+    for (PODVector<ProfilerBlock*>::ConstIterator i = block->children_.Begin(); i != block->children_.End(); ++i)
+    {
+        const ProfilerBlock* child = *i;
+        MetricsProfilerBlock data;
+        data.path_ = parentPath.Empty() ? String(child->name_) : parentPath + "/" + child->name_;
+        data.totalTime_ = child->totalTime_;
+        data.totalCount_ = child->totalCount_;
+        data.frameTime_ = child->frameTime_;
+        dest.Push(data);
+        GetProfilerBlocks(child, data.path_, dest);
+    }
+}
+
+MetricsSnapshot::MetricsSnapshot() :
+    frameTimeSum_(0),
+    numFrames_(0),
+    uptime_(0.0f),
+    workUtilization_(0.0f),
+    totalMemoryUse_(0)
+{
+    for (unsigned i = 0; i <= NUM_FRAME_TIME_BUCKETS; ++i)
+        frameTimeBuckets_[i] = 0;
+}
+
+MetricsServer::MetricsServer(Context* context) :
+    Object(context),
+    server_(0),
+    port_(0),
+    snapshotInterval_(DEFAULT_SNAPSHOT_INTERVAL),
+    frameTimeSum_(0),
+    numFrames_(0)
+{
+    for (unsigned i = 0; i <= NUM_FRAME_TIME_BUCKETS; ++i)
+        frameTimeBuckets_[i] = 0;
+}
+
+MetricsServer::~MetricsServer()
+{
+    Stop();
+}
+
+bool MetricsServer::Start(unsigned short port, bool localOnly)
+{
+    if (server_)
+    {
+        if (port == port_)
+            return true;
+        Stop();
+    }
+    
+    String listeningPorts = localOnly ? "127.0.0.1:" + String(port) : String(port);
+    const char* options[] =
+    {
+        "listening_ports", listeningPorts.CString(),
+        "num_threads", NUM_SERVER_THREADS,
+        0
+    };
+    
+    // Have a valid snapshot to serve before the first interval has passed
+    frameTimer_.Reset();
+    uptimeTimer_.Reset();
+    UpdateSnapshot();
+    
+    mg_callbacks callbacks;
+    memset(&callbacks, 0, sizeof callbacks);
+    server_ = mg_start(&callbacks, this, options);
+    if (!server_)
+    {
+        LOGERROR("Failed to start metrics server on port " + String(port));
+        return false;
+    }
+    
+    mg_set_request_handler(server_, "/metrics", HandleMetricsRequest, this);
+    mg_set_request_handler(server_, "/stats", HandleMetricsRequest, this);
+    port_ = port;
+    
+    SubscribeToEvent(E_ENDFRAME, HANDLER(MetricsServer, HandleEndFrame));
+    LOGINFO("Started metrics server on port " + String(port));
+    return true;
+}
+
+void MetricsServer::Stop()
+{
+    if (!server_)
+        return;
+    
+    // Blocks until the server threads have finished serving
+    mg_stop(server_);
+    server_ = 0;
+    port_ = 0;
+    
+    UnsubscribeFromEvent(E_ENDFRAME);
+    LOGINFO("Stopped metrics server");
+}
+
+void MetricsServer::SetSnapshotInterval(float interval)
+{
+    snapshotInterval_ = Max(interval, 0.0f);
+}
+
+void MetricsServer::AddScene(Scene* scene)
+{
+    if (!scene)
+        return;
+    
+    for (Vector<WeakPtr<Scene> >::ConstIterator i = scenes_.Begin(); i != scenes_.End(); ++i)
+    {
+        if (*i == scene)
+            return;
+    }
+    
+    scenes_.Push(WeakPtr<Scene>(scene));
+}
+
+void MetricsServer::RemoveScene(Scene* scene)
+{
+    for (Vector<WeakPtr<Scene> >::Iterator i = scenes_.Begin(); i != scenes_.End(); ++i)
+    {
+        if (*i == scene)
+        {
+            scenes_.Erase(i);
+            return;
+        }
+    }
+}
+
+String MetricsServer::GetMetricsText()
+{
+    MetricsSnapshot snapshot;
+    GetSnapshot(snapshot);
+    
+    String ret;
+    
+    AppendHeader(ret, "urho3d_uptime_seconds", "gauge", "Seconds since the metrics server was started.");
+    AppendSample(ret, "urho3d_uptime_seconds", String::EMPTY, snapshot.uptime_);
+    
+    AppendHeader(ret, "urho3d_frame_time_seconds", "histogram", "Wall clock time between frames.");
+    unsigned cumulative = 0;
+    for (unsigned i = 0; i < NUM_FRAME_TIME_BUCKETS; ++i)
+    {
+        cumulative += snapshot.frameTimeBuckets_[i];
+        String labels = "le=\"";
+        AppendNumber(labels, frameTimeBucketBounds[i] / 1000000.0);
+        labels += "\"";
+        AppendSample(ret, "urho3d_frame_time_seconds_bucket", labels, cumulative);
+    }
+    AppendSample(ret, "urho3d_frame_time_seconds_bucket", "le=\"+Inf\"", snapshot.numFrames_);
+    AppendSample(ret, "urho3d_frame_time_seconds_sum", String::EMPTY, snapshot.frameTimeSum_ / 1000000.0);
+    AppendSample(ret, "urho3d_frame_time_seconds_count", String::EMPTY, snapshot.numFrames_);
+    
+    if (!snapshot.profilerBlocks_.Empty())
+    {
+        AppendHeader(ret, "urho3d_profiler_block_seconds_total", "counter", "Total time spent in a profiler block.");
+        for (unsigned i = 0; i < snapshot.profilerBlocks_.Size(); ++i)
+        {
+            const MetricsProfilerBlock& block = snapshot.profilerBlocks_[i];
+            AppendSample(ret, "urho3d_profiler_block_seconds_total", "block=\"" + EscapeLabel(block.path_) + "\"", block.totalTime_ / 1000000.0);
+        }
+        AppendHeader(ret, "urho3d_profiler_block_calls_total", "counter", "Total calls of a profiler block.");
+        for (unsigned i = 0; i < snapshot.profilerBlocks_.Size(); ++i)
+        {
+            const MetricsProfilerBlock& block = snapshot.profilerBlocks_[i];
+            AppendSample(ret, "urho3d_profiler_block_calls_total", "block=\"" + EscapeLabel(block.path_) + "\"", block.totalCount_);
+        }
+        AppendHeader(ret, "urho3d_profiler_block_frame_seconds", "gauge", "Time spent in a profiler block on the last frame.");
+        for (unsigned i = 0; i < snapshot.profilerBlocks_.Size(); ++i)
+        {
+            const MetricsProfilerBlock& block = snapshot.profilerBlocks_[i];
+            AppendSample(ret, "urho3d_profiler_block_frame_seconds", "block=\"" + EscapeLabel(block.path_) + "\"", block.frameTime_ / 1000000.0);
+        }
+    }
+    
+    AppendHeader(ret, "urho3d_resource_memory_bytes", "gauge", "Memory use of loaded resources by type.");
+    for (unsigned i = 0; i < snapshot.resourceGroups_.Size(); ++i)
+    {
+        const MetricsResourceGroup& group = snapshot.resourceGroups_[i];
+        AppendSample(ret, "urho3d_resource_memory_bytes", "type=\"" + EscapeLabel(group.type_) + "\"", group.memoryUse_);
+    }
+    AppendHeader(ret, "urho3d_resource_count", "gauge", "Number of loaded resources by type.");
+    for (unsigned i = 0; i < snapshot.resourceGroups_.Size(); ++i)
+    {
+        const MetricsResourceGroup& group = snapshot.resourceGroups_[i];
+        AppendSample(ret, "urho3d_resource_count", "type=\"" + EscapeLabel(group.type_) + "\"", group.numResources_);
+    }
+    AppendHeader(ret, "urho3d_resource_memory_total_bytes", "gauge", "Memory use of all loaded resources.");
+    AppendSample(ret, "urho3d_resource_memory_total_bytes", String::EMPTY, snapshot.totalMemoryUse_);
+    
+    AppendHeader(ret, "urho3d_network_connections", "gauge", "Number of network connections.");
+    AppendSample(ret, "urho3d_network_connections", String::EMPTY, snapshot.connections_.Size());
+    if (!snapshot.connections_.Empty())
+    {
+        static const char* names[] =
+        {
+            "urho3d_network_round_trip_seconds",
+            "urho3d_network_packets_in_per_second",
+            "urho3d_network_packets_out_per_second",
+            "urho3d_network_bytes_in_per_second",
+            "urho3d_network_bytes_out_per_second"
+        };
+        static const char* helps[] =
+        {
+            "Round trip time of a connection.",
+            "Incoming packet rate of a connection.",
+            "Outgoing packet rate of a connection.",
+            "Incoming data rate of a connection.",
+            "Outgoing data rate of a connection."
+        };
+        
+        for (unsigned j = 0; j < 5; ++j)
+        {
+            AppendHeader(ret, names[j], "gauge", helps[j]);
+            for (unsigned i = 0; i < snapshot.connections_.Size(); ++i)
+            {
+                const MetricsConnection& connection = snapshot.connections_[i];
+                String labels = "address=\"" + EscapeLabel(connection.address_) + "\",role=\"" + (connection.client_ ? "client" : "server") + "\"";
+                float values[] =
+                {
+                    connection.roundTripTime_ / 1000.0f,
+                    connection.packetsInPerSec_,
+                    connection.packetsOutPerSec_,
+                    connection.bytesInPerSec_,
+                    connection.bytesOutPerSec_
+                };
+                AppendSample(ret, names[j], labels, values[j]);
+            }
+        }
+    }
+    
+    AppendHeader(ret, "urho3d_workqueue_busy_seconds_total", "counter", "Total time spent executing work items by thread, 0 being the main thread.");
+    for (unsigned i = 0; i < snapshot.workBusyTime_.Size(); ++i)
+        AppendSample(ret, "urho3d_workqueue_busy_seconds_total", "thread=\"" + String(i) + "\"", snapshot.workBusyTime_[i] / 1000000.0);
+    AppendHeader(ret, "urho3d_workqueue_worker_threads", "gauge", "Number of work queue worker threads.");
+    AppendSample(ret, "urho3d_workqueue_worker_threads", String::EMPTY, snapshot.workBusyTime_.Size() ? snapshot.workBusyTime_.Size() - 1 : 0);
+    AppendHeader(ret, "urho3d_workqueue_utilization", "gauge", "Fraction of worker thread time spent executing work items during the last snapshot interval.");
+    AppendSample(ret, "urho3d_workqueue_utilization", String::EMPTY, snapshot.workUtilization_);
+    
+    AppendHeader(ret, "urho3d_scene_nodes", "gauge", "Number of scene nodes.");
+    for (unsigned i = 0; i < snapshot.scenes_.Size(); ++i)
+    {
+        const MetricsScene& scene = snapshot.scenes_[i];
+        String name = EscapeLabel(scene.name_);
+        AppendSample(ret, "urho3d_scene_nodes", "scene=\"" + name + "\",mode=\"replicated\"", scene.numReplicatedNodes_);
+        AppendSample(ret, "urho3d_scene_nodes", "scene=\"" + name + "\",mode=\"local\"", scene.numLocalNodes_);
+    }
+    AppendHeader(ret, "urho3d_scene_components", "gauge", "Number of scene components.");
+    for (unsigned i = 0; i < snapshot.scenes_.Size(); ++i)
+    {
+        const MetricsScene& scene = snapshot.scenes_[i];
+        String name = EscapeLabel(scene.name_);
+        AppendSample(ret, "urho3d_scene_components", "scene=\"" + name + "\",mode=\"replicated\"", scene.numReplicatedComponents_);
+        AppendSample(ret, "urho3d_scene_components", "scene=\"" + name + "\",mode=\"local\"", scene.numLocalComponents_);
+    }
+    
+    return ret;
+}
+
+String MetricsServer::GetSceneStatsJSON()
+{
+    MetricsSnapshot snapshot;
+    GetSnapshot(snapshot);
+    
+    String ret = "{\"scenes\":[";
+    for (unsigned i = 0; i < snapshot.scenes_.Size(); ++i)
+    {
+        const MetricsScene& scene = snapshot.scenes_[i];
+        if (i)
+            ret += ",";
+        ret += "{\"name\":" + EscapeJSON(scene.name_);
+        ret += ",\"replicatedNodes\":" + String(scene.numReplicatedNodes_);
+        ret += ",\"localNodes\":" + String(scene.numLocalNodes_);
+        ret += ",\"replicatedComponents\":" + String(scene.numReplicatedComponents_);
+        ret += ",\"localComponents\":" + String(scene.numLocalComponents_);
+        ret += ",\"connections\":" + String(scene.numConnections_);
+        ret += ",\"elapsedTime\":";
+        AppendNumber(ret, scene.elapsedTime_);
+        ret += ",\"timeScale\":";
+        AppendNumber(ret, scene.timeScale_);
+        ret += ",\"updateEnabled\":";
+        ret += scene.updateEnabled_ ? "true" : "false";
+        ret += ",\"asyncProgress\":";
+        AppendNumber(ret, scene.asyncProgress_);
+        ret += "}";
+    }
+    ret += "],\"connections\":[";
+    for (unsigned i = 0; i < snapshot.connections_.Size(); ++i)
+    {
+        const MetricsConnection& connection = snapshot.connections_[i];
+        if (i)
+            ret += ",";
+        ret += "{\"address\":" + EscapeJSON(connection.address_);
+        ret += ",\"client\":";
+        ret += connection.client_ ? "true" : "false";
+        ret += ",\"connected\":";
+        ret += connection.connected_ ? "true" : "false";
+        ret += ",\"roundTripTime\":";
+        AppendNumber(ret, connection.roundTripTime_);
+        ret += ",\"bytesInPerSec\":";
+        AppendNumber(ret, connection.bytesInPerSec_);
+        ret += ",\"bytesOutPerSec\":";
+        AppendNumber(ret, connection.bytesOutPerSec_);
+        ret += "}";
+    }
+    ret += "]}";
+    
+    return ret;
+}
+
+String MetricsServer::GetResourceStatsJSON()
+{
+    MetricsSnapshot snapshot;
+    GetSnapshot(snapshot);
+    
+    String ret = "{\"totalMemoryUse\":" + String(snapshot.totalMemoryUse_) + ",\"types\":[";
+    for (unsigned i = 0; i < snapshot.resourceGroups_.Size(); ++i)
+    {
+        const MetricsResourceGroup& group = snapshot.resourceGroups_[i];
+        if (i)
+            ret += ",";
+        ret += "{\"type\":" + EscapeJSON(group.type_);
+        ret += ",\"count\":" + String(group.numResources_);
+        ret += ",\"memoryUse\":" + String(group.memoryUse_);
+        ret += ",\"memoryBudget\":" + String(group.memoryBudget_);
+        ret += "}";
+    }
+    ret += "]}";
+    
+    return ret;
+}
+
+void MetricsServer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    long long frameTime = frameTimer_.GetUSec(true);
+    unsigned bucket = 0;
+    while (bucket < NUM_FRAME_TIME_BUCKETS && frameTime > frameTimeBucketBounds[bucket])
+        ++bucket;
+    ++frameTimeBuckets_[bucket];
+    frameTimeSum_ += frameTime;
+    ++numFrames_;
+    
+    if (snapshotTimer_.GetUSec(false) >= (long long)(snapshotInterval_ * 1000000.0f))
+    {
+        PROFILE(UpdateMetricsSnapshot);
+        UpdateSnapshot();
+    }
+}
+
+void MetricsServer::UpdateSnapshot()
+{
+    // Gather into a local snapshot first, so that the serving threads are blocked only for the copy
+    MetricsSnapshot snapshot;
+    
+    for (unsigned i = 0; i <= NUM_FRAME_TIME_BUCKETS; ++i)
+        snapshot.frameTimeBuckets_[i] = frameTimeBuckets_[i];
+    snapshot.frameTimeSum_ = frameTimeSum_;
+    snapshot.numFrames_ = numFrames_;
+    snapshot.uptime_ = uptimeTimer_.GetMSec(false) / 1000.0f;
+    
+    long long elapsed = snapshotTimer_.GetUSec(true);
+    
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    if (queue)
+    {
+        unsigned numThreads = queue->GetNumThreads();
+        snapshot.workBusyTime_.Resize(numThreads + 1);
+        long long busyDelta = 0;
+        for (unsigned i = 0; i <= numThreads; ++i)
+        {
+            snapshot.workBusyTime_[i] = queue->GetBusyTime(i);
+            if (i && i < lastWorkBusyTime_.Size())
+                busyDelta += snapshot.workBusyTime_[i] - lastWorkBusyTime_[i];
+        }
+        if (numThreads && elapsed > 0 && lastWorkBusyTime_.Size() == numThreads + 1)
+            snapshot.workUtilization_ = Clamp((float)((double)busyDelta / ((double)elapsed * numThreads)), 0.0f, 1.0f);
+        lastWorkBusyTime_ = snapshot.workBusyTime_;
+    }
+    
+    Profiler* profiler = GetSubsystem<Profiler>();
+    if (profiler)
+        GetProfilerBlocks(profiler->GetRootBlock(), String::EMPTY, snapshot.profilerBlocks_);
+    
+    ResourceCache* cache = GetSubsystem<ResourceCache>();
+    if (cache)
+    {
+        const HashMap<StringHash, ResourceGroup>& groups = cache->GetAllResources();
+        for (HashMap<StringHash, ResourceGroup>::ConstIterator i = groups.Begin(); i != groups.End(); ++i)
+        {
+            const HashMap<StringHash, SharedPtr<Resource> >& resources = i->second_.resources_;
+            if (resources.Empty())
+                continue;
+            
+            MetricsResourceGroup group;
+            group.type_ = resources.Begin()->second_->GetTypeName();
+            group.numResources_ = resources.Size();
+            group.memoryUse_ = i->second_.memoryUse_;
+            group.memoryBudget_ = i->second_.memoryBudget_;
+            snapshot.resourceGroups_.Push(group);
+        }
+        snapshot.totalMemoryUse_ = cache->GetTotalMemoryUse();
+    }
+    
+    PODVector<Scene*> scenes;
+    for (Vector<WeakPtr<Scene> >::Iterator i = scenes_.Begin(); i != scenes_.End();)
+    {
+        if (*i)
+        {
+            scenes.Push(i->Get());
+            ++i;
+        }
+        else
+            i = scenes_.Erase(i);
+    }
+    
+    Vector<SharedPtr<Connection> > connections;
+    Network* network = GetSubsystem<Network>();
+    if (network)
+    {
+        connections = network->GetClientConnections();
+        if (network->GetServerConnection())
+            connections.Push(SharedPtr<Connection>(network->GetServerConnection()));
+    }
+    
+    for (unsigned i = 0; i < connections.Size(); ++i)
+    {
+        Connection* connection = connections[i];
+        MetricsConnection data;
+        data.address_ = connection->ToString();
+        data.client_ = connection->IsClient();
+        data.connected_ = connection->IsConnected();
+        data.roundTripTime_ = connection->GetRoundTripTime();
+        data.packetsInPerSec_ = connection->GetPacketsInPerSec();
+        data.packetsOutPerSec_ = connection->GetPacketsOutPerSec();
+        data.bytesInPerSec_ = connection->GetBytesInPerSec();
+        data.bytesOutPerSec_ = connection->GetBytesOutPerSec();
+        snapshot.connections_.Push(data);
+        
+        Scene* scene = connection->GetScene();
+        if (scene && !scenes.Contains(scene))
+            scenes.Push(scene);
+    }
+    
+    for (unsigned i = 0; i < scenes.Size(); ++i)
+    {
+        Scene* scene = scenes[i];
+        MetricsScene data;
+        data.name_ = scene->GetName();
+        data.numReplicatedNodes_ = scene->GetNumReplicatedNodes();
+        data.numLocalNodes_ = scene->GetNumLocalNodes();
+        data.numReplicatedComponents_ = scene->GetNumReplicatedComponents();
+        data.numLocalComponents_ = scene->GetNumLocalComponents();
+        data.numConnections_ = 0;
+        for (unsigned j = 0; j < connections.Size(); ++j)
+        {
+            if (connections[j]->IsClient() && connections[j]->GetScene() == scene)
+                ++data.numConnections_;
+        }
+        data.elapsedTime_ = scene->GetElapsedTime();
+        data.timeScale_ = scene->GetTimeScale();
+        data.updateEnabled_ = scene->IsUpdateEnabled();
+        data.asyncProgress_ = scene->GetAsyncProgress();
+        snapshot.scenes_.Push(data);
+    }
+    
+    MutexLock lock(snapshotMutex_);
+    snapshot_ = snapshot;
+}
+
+void MetricsServer::GetSnapshot(MetricsSnapshot& dest)
+{
+    MutexLock lock(snapshotMutex_);
+    dest = snapshot_;
+}
+
+}
@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Mutex.h"
+#include "Object.h"
+#include "Timer.h"
+
+struct mg_context;
+
+namespace Urho3D
+{
+
+class Scene;
+
+/// Number of finite frame time histogram buckets.
+static const unsigned NUM_FRAME_TIME_BUCKETS = 10;
+
+/// Profiler block totals in a metrics snapshot.
+struct MetricsProfilerBlock
+{
+    /// Block path from the root, separated with slashes.
+    String path_;
+    /// Total accumulated time in microseconds.
+    long long totalTime_;
+    /// Total accumulated calls.
+    unsigned totalCount_;
+    /// Time on the previous frame in microseconds.
+    long long frameTime_;
+};
+
+/// Resource type memory use in a metrics snapshot.
+struct MetricsResourceGroup
+{
+    /// Resource type name.
+    String type_;
+    /// Number of resources.
+    unsigned numResources_;
+    /// Memory use in bytes.
+    unsigned memoryUse_;
+    /// Memory budget in bytes, or zero if unlimited.
+    unsigned memoryBudget_;
+};
+
+/// Network connection statistics in a metrics snapshot.
+struct MetricsConnection
+{
+    /// Remote address and port.
+    String address_;
+    /// Whether is a client connection.
+    bool client_;
+    /// Whether is fully connected.
+    bool connected_;
+    /// Round trip time in milliseconds.
+    float roundTripTime_;
+    /// Incoming packets per second.
+    float packetsInPerSec_;
+    /// Outgoing packets per second.
+    float packetsOutPerSec_;
+    /// Incoming bytes per second.
+    float bytesInPerSec_;
+    /// Outgoing bytes per second.
+    float bytesOutPerSec_;
+};
+
+/// Scene statistics in a metrics snapshot.
+struct MetricsScene
+{
+    /// Scene name.
+    String name_;
+    /// Number of replicated nodes.
+    unsigned numReplicatedNodes_;
+    /// Number of local nodes.
+    unsigned numLocalNodes_;
+    /// Number of replicated components.
+    unsigned numReplicatedComponents_;
+    /// Number of local components.
+    unsigned numLocalComponents_;
+    /// Number of client connections in the scene.
+    unsigned numConnections_;
+    /// Elapsed scene time.
+    float elapsedTime_;
+    /// Scene time scale.
+    float timeScale_;
+    /// Update enabled flag.
+    bool updateEnabled_;
+    /// Asynchronous loading progress, or 1 if not loading.
+    float asyncProgress_;
+};
+
+/// Engine state copied from the main thread for serving metrics.
+struct MetricsSnapshot
+{
+    /// Construct.
+    MetricsSnapshot();
+    
+    /// Frame counts in each frame time histogram bucket, the last bucket being unbounded.
+    unsigned frameTimeBuckets_[NUM_FRAME_TIME_BUCKETS + 1];
+    /// Sum of frame times in microseconds.
+    long long frameTimeSum_;
+    /// Number of frames.
+    unsigned numFrames_;
+    /// Seconds since the server was started.
+    float uptime_;
+    /// Microseconds spent executing work items, indexed by thread (0 = main thread.)
+    PODVector<long long> workBusyTime_;
+    /// Fraction of worker thread time spent executing work items during the last snapshot interval.
+    float workUtilization_;
+    /// Total memory use of all resources in bytes.
+    unsigned totalMemoryUse_;
+    /// Profiler blocks.
+    Vector<MetricsProfilerBlock> profilerBlocks_;
+    /// Resource groups.
+    Vector<MetricsResourceGroup> resourceGroups_;
+    /// Network connections.
+    Vector<MetricsConnection> connections_;
+    /// Scenes.
+    Vector<MetricsScene> scenes_;
+};
+
+/// %Metrics server subsystem. Serves Prometheus-format metrics and JSON statistics over HTTP from Civetweb's own threads, while the main thread only copies a snapshot of the engine state at a fixed interval.
+class URHO3D_API MetricsServer : public Object
+{
+    OBJECT(MetricsServer);
+    
+public:
+    /// Construct.
+    MetricsServer(Context* context);
+    /// Destruct. Stop the server.
+    ~MetricsServer();
+    
+    /// Start serving on a port. If local only, accept connections only from the loopback address. Return true if successful.
+    bool Start(unsigned short port, bool localOnly = true);
+    /// Stop serving.
+    void Stop();
+    /// Set interval in seconds between snapshots of the engine state.
+    void SetSnapshotInterval(float interval);
+    /// Add a scene to report in the scene statistics. The scenes of network connections are reported automatically.
+    void AddScene(Scene* scene);
+    /// Remove a scene from the scene statistics.
+    void RemoveScene(Scene* scene);
+    
+    /// Return whether the server is running.
+    bool IsRunning() const { return server_ != 0; }
+    /// Return the port being served, or 0 if not running.
+    unsigned short GetPort() const { return port_; }
+    /// Return interval in seconds between snapshots of the engine state.
+    float GetSnapshotInterval() const { return snapshotInterval_; }
+    /// Return the latest snapshot as Prometheus text exposition format. Safe to call from any thread.
+    String GetMetricsText();
+    /// Return the latest scene statistics as JSON. Safe to call from any thread.
+    String GetSceneStatsJSON();
+    /// Return the latest resource statistics as JSON. Safe to call from any thread.
+    String GetResourceStatsJSON();
+    
+private:
+    /// Handle end of frame. Accumulate the frame time and copy a snapshot when the interval has passed.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    /// Copy the engine state into the snapshot. Called in the main thread.
+    void UpdateSnapshot();
+    /// Return a copy of the latest snapshot.
+    void GetSnapshot(MetricsSnapshot& dest);
+    
+    /// Civetweb server context.
+    mg_context* server_;
+    /// Port being served.
+    unsigned short port_;
+    /// Interval in seconds between snapshots.
+    float snapshotInterval_;
+    /// Explicitly reported scenes.
+    Vector<WeakPtr<Scene> > scenes_;
+    /// Frame time measurement timer.
+    HiresTimer frameTimer_;
+    /// Snapshot interval timer.
+    HiresTimer snapshotTimer_;
+    /// Uptime timer.
+    Timer uptimeTimer_;
+    /// Frame time histogram accumulated in the main thread.
+    unsigned frameTimeBuckets_[NUM_FRAME_TIME_BUCKETS + 1];
+    /// Sum of frame times in microseconds accumulated in the main thread.
+    long long frameTimeSum_;
+    /// Number of frames accumulated in the main thread.
+    unsigned numFrames_;
+    /// Work item busy times at the previous snapshot.
+    PODVector<long long> lastWorkBusyTime_;
+    /// Latest snapshot. Guarded by the snapshot mutex.
+    MetricsSnapshot snapshot_;
+    /// Snapshot mutex.
+    Mutex snapshotMutex_;
+};
+
+}
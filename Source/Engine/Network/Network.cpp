@@ -25,7 +25,8 @@
 #include "CoreEvents.h"
 #include "EngineEvents.h"
 #include "FileSystem.h"
-#include "HttpRequest.h"
+#include "FrameRecorder.h"
+#include "HttpClient.h"
 #include "InputEvents.h"
 #include "IOEvents.h"
 #include "Log.h"
@@ -122,18 +123,14 @@ void Network::HandleMessage(kNet::MessageConnection *source, kNet::packet_id_t p
     Connection* connection = GetConnection(source);
     if (connection)
     {
-        MemoryBuffer msg(data, numBytes);
-        if (connection->ProcessMessage(msgId, msg))
-            return;
-        
-        // If message was not handled internally, forward as an event
-        using namespace NetworkMessage;
+        if (connection->IsClient())
+        {
+            FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+            if (recorder)
+                recorder->RecordClientMessage(connection, msgId, (const unsigned char*)data, numBytes);
+        }
         
-        VariantMap& eventData = GetEventDataMap();
-        eventData[P_CONNECTION] = connection;
-        eventData[P_MESSAGEID] = (int)msgId;
-        eventData[P_DATA].SetBuffer(msg.GetData(), msg.GetSize());
-        connection->SendEvent(E_NETWORKMESSAGE, eventData);
+        ProcessMessage(connection, msgId, (const unsigned char*)data, numBytes);
     }
     else
         LOGWARNING("Discarding message from unknown MessageConnection " + ToString((void*)source));
@@ -170,6 +167,10 @@ void Network::NewConnectionEstablished(kNet::MessageConnection* connection)
     clientConnections_[connection] = newConnection;
     LOGINFO("Client " + newConnection->ToString() + " connected");
     
+    FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+    if (recorder)
+        recorder->RecordClientConnected(newConnection);
+    
     using namespace ClientConnected;
     
     VariantMap& eventData = GetEventDataMap();
@@ -188,6 +189,10 @@ void Network::ClientDisconnected(kNet::MessageConnection* connection)
         Connection* connection = i->second_;
         LOGINFO("Client " + connection->ToString() + " disconnected");
         
+        FrameRecorder* recorder = GetSubsystem<FrameRecorder>();
+        if (recorder)
+            recorder->RecordClientDisconnected(connection);
+        
         using namespace ClientDisconnected;
         
         VariantMap& eventData = GetEventDataMap();
@@ -384,11 +389,55 @@ void Network::SendPackageToClients(Scene* scene, PackageFile* package)
 
 SharedPtr<HttpRequest> Network::MakeHttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData)
 {
-    PROFILE(MakeHttpRequest);
+    HttpClient* client = GetSubsystem<HttpClient>();
+    if (!client)
+    {
+        client = new HttpClient(context_);
+        context_->RegisterSubsystem(client);
+    }
+    
+    // The request is executed in the HTTP client's worker threads, can not know at this point if it has an error or not
+    return client->MakeRequest(url, verb, headers, postData);
+}
+
+Connection* Network::AddReplayConnection()
+{
+    SharedPtr<Connection> newConnection(new Connection(context_, true, kNet::SharedPtr<kNet::MessageConnection>()));
+    // There is no MessageConnection, so key the connection by its own address, which kNet will never pass to us
+    clientConnections_[reinterpret_cast<kNet::MessageConnection*>(newConnection.Get())] = newConnection;
+    LOGINFO("Replayed client connected");
+    
+    using namespace ClientConnected;
+    
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_CONNECTION] = newConnection;
+    newConnection->SendEvent(E_CLIENTCONNECTED, eventData);
+    
+    return newConnection;
+}
+
+void Network::RemoveReplayConnection(Connection* connection)
+{
+    HashMap<kNet::MessageConnection*, SharedPtr<Connection> >::Iterator i =
+        clientConnections_.Find(reinterpret_cast<kNet::MessageConnection*>(connection));
+    if (i == clientConnections_.End())
+        return;
     
-    // The initialization of the request will take time, can not know at this point if it has an error or not
-    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData));
-    return request;
+    LOGINFO("Replayed client disconnected");
+    
+    using namespace ClientDisconnected;
+    
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_CONNECTION] = connection;
+    connection->SendEvent(E_CLIENTDISCONNECTED, eventData);
+    
+    clientConnections_.Erase(i);
+}
+
+void Network::ReplayMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes)
+{
+    if (connection && !connection->GetMessageConnection())
+        ProcessMessage(connection, msgID, data, numBytes);
 }
 
 Connection* Network::GetConnection(kNet::MessageConnection* connection) const
@@ -475,7 +524,8 @@ void Network::PostUpdate(float timeStep)
         SendEvent(E_NETWORKUPDATE);
         updateAcc_ = fmodf(updateAcc_, updateInterval_);
         
-        if (IsServerRunning())
+        // Replayed client connections are updated also when the server is not running
+        if (IsServerRunning() || !clientConnections_.Empty())
         {
             // Collect and prepare all networked scenes
             {
@@ -566,6 +616,22 @@ void Network::OnServerDisconnected()
     }
 }
 
+void Network::ProcessMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes)
+{
+    MemoryBuffer msg(data, numBytes);
+    if (connection->ProcessMessage(msgID, msg))
+        return;
+    
+    // If message was not handled internally, forward as an event
+    using namespace NetworkMessage;
+    
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_CONNECTION] = connection;
+    eventData[P_MESSAGEID] = msgID;
+    eventData[P_DATA].SetBuffer(msg.GetData(), msg.GetSize());
+    connection->SendEvent(E_NETWORKMESSAGE, eventData);
+}
+
 void RegisterNetworkLibrary(Context* context)
 {
     NetworkPriority::RegisterObject(context);
@@ -93,8 +93,14 @@ public:
     void SetPackageCacheDir(const String& path);
     /// Trigger all client connections in the specified scene to download a package file from the server. Can be used to download additional resource packages when clients are already joined in the scene. The package must have been added as a requirement to the scene, or else the eventual download will fail.
     void SendPackageToClients(Scene* scene, PackageFile* package);
-    /// Perform an HTTP request to the specified URL. Empty verb defaults to a GET request. Return a request object which can be used to read the response data.
+    /// Perform an HTTP request to the specified URL using the HttpClient subsystem. Empty verb defaults to a GET request. Return a request object which can be used to read the response data.
     SharedPtr<HttpRequest> MakeHttpRequest(const String& url, const String& verb = String::EMPTY, const Vector<String>& headers = Vector<String>(), const String& postData = String::EMPTY);
+    /// Add a client connection without a kNet connection for replaying recorded traffic. Sends the ClientConnected event.
+    Connection* AddReplayConnection();
+    /// Remove a replayed client connection. Sends the ClientDisconnected event.
+    void RemoveReplayConnection(Connection* connection);
+    /// Process a recorded message as if it had been received from a replayed client connection.
+    void ReplayMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes);
 
     /// Return network update FPS.
     int GetUpdateFps() const { return updateFps_; }
@@ -125,6 +131,8 @@ private:
     void OnServerConnected();
     /// Handle server disconnection.
     void OnServerDisconnected();
+    /// Process a message from a connection, or forward it as an event if not handled internally.
+    void ProcessMessage(Connection* connection, int msgID, const unsigned char* data, unsigned numBytes);
     
     /// kNet instance.
     kNet::Network* network_;
@@ -97,4 +97,12 @@ EVENT(E_REMOTEEVENTDATA, RemoteEventData)
     PARAM(P_CONNECTION, Connection);      // Connection pointer
 }
 
+/// HTTP request has finished, either by receiving the whole response or with an error. Response data may remain to be read.
+EVENT(E_HTTPREQUESTFINISHED, HttpRequestFinished)
+{
+    PARAM(P_REQUEST, Request);            // HttpRequest pointer
+    PARAM(P_STATUSCODE, StatusCode);      // int
+    PARAM(P_SUCCESS, Success);            // bool
+}
+
 }
@@ -28,6 +28,7 @@
 #include "ResourceCache.h"
 #include "ResourceEvents.h"
 #include "Timer.h"
+#include "WorkQueue.h"
 
 #include "DebugNew.h"
 
@@ -37,6 +38,7 @@ namespace Urho3D
 BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
     owner_(owner)
 {
+    SetName("ResourceLoader");
 }
 
 void BackgroundLoader::ThreadFunction()
@@ -154,9 +156,14 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
             LOGWARNING("Resource " + caller->GetName() + " requested for a background loaded resource but was not in the background load queue");
     }
     
-    // Start the background loader thread now
+    // Start the background loader thread now, on the cores reserved for I/O if any
     if (!IsStarted())
+    {
+        WorkQueue* queue = owner_->GetSubsystem<WorkQueue>();
+        if (queue)
+            SetAffinity(queue->GetReservedCPUs());
         Run();
+    }
     
     return true;
 }
@@ -63,11 +63,27 @@ static const char* checkDirs[] = {
 
 static const SharedPtr<Resource> noResource;
 
+// Match file names in the directory index in lowercase where the filesystem is case-insensitive by default
+#if defined(WIN32) || (defined(__APPLE__) && !defined(IOS))
+#define CASE_INSENSITIVE_INDEX
+#endif
+
+/// Return whether the files of a resource directory can be listed for the directory index. Directories inside the Android APK can not.
+static bool CanIndexResourceDir(const String& path)
+{
+    #ifdef ANDROID
+    return !path.StartsWith("/apk/");
+    #else
+    return true;
+    #endif
+}
+
 ResourceCache::ResourceCache(Context* context) :
     Object(context),
     autoReloadResources_(false),
     returnFailedResources_(false),
     searchPackagesFirst_(true),
+    useDirectoryIndex_(true),
     finishBackgroundResourcesMs_(5)
 {
     // Register Resource library object factories
@@ -108,10 +124,15 @@ bool ResourceCache::AddResourceDir(const String& pathName, unsigned priority)
     }
     
     // If the priority isn't last or greater than size insert at position otherwise push.
+    unsigned index = resourceDirs_.Size();
     if (priority > PRIORITY_LAST && priority < resourceDirs_.Size())
-        resourceDirs_.Insert(priority, fixedPath);
-    else
-        resourceDirs_.Push(fixedPath);
+        index = priority;
+    resourceDirs_.Insert(index, fixedPath);
+    resourceDirIndices_.Insert(index, HashSet<String>());
+    
+    // Index the files of the directory up front, so that lookups do not need to access the filesystem
+    if (useDirectoryIndex_)
+        BuildDirectoryIndex(resourceDirIndices_[index], fixedPath);
     
     // If resource auto-reloading active, create a file watcher for the directory
     if (autoReloadResources_)
@@ -174,6 +195,7 @@ void ResourceCache::RemoveResourceDir(const String& pathName)
         if (!resourceDirs_[i].Compare(fixedPath, false))
         {
             resourceDirs_.Erase(i);
+            resourceDirIndices_.Erase(i);
             // Remove the filewatcher with the matching path
             for (unsigned j = 0; j < fileWatchers_.Size(); ++j)
             {
@@ -446,6 +468,24 @@ void ResourceCache::SetReturnFailedResources(bool enable)
     returnFailedResources_ = enable;
 }
 
+void ResourceCache::SetUseDirectoryIndex(bool enable)
+{
+    MutexLock lock(resourceMutex_);
+    
+    if (enable != useDirectoryIndex_)
+    {
+        for (unsigned i = 0; i < resourceDirs_.Size(); ++i)
+        {
+            if (enable)
+                BuildDirectoryIndex(resourceDirIndices_[i], resourceDirs_[i]);
+            else
+                resourceDirIndices_[i].Clear();
+        }
+        
+        useDirectoryIndex_ = enable;
+    }
+}
+
 SharedPtr<File> ResourceCache::GetFile(const String& nameIn, bool sendEventOnFailure)
 {
     MutexLock lock(resourceMutex_);
@@ -671,15 +711,14 @@ bool ResourceCache::Exists(const String& nameIn) const
             return true;
     }
     
-    FileSystem* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.Size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + name))
+        if (ResourceDirContains(i, name))
             return true;
     }
     
     // Fallback using absolute path
-    if (fileSystem->FileExists(name))
+    if (GetSubsystem<FileSystem>()->FileExists(name))
         return true;
 
     return false;
@@ -715,10 +754,9 @@ String ResourceCache::GetResourceFileName(const String& name) const
 {
     MutexLock lock(resourceMutex_);
     
-    FileSystem* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.Size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + name))
+        if (ResourceDirContains(i, name))
             return resourceDirs_[i] + name;
     }
     
@@ -944,6 +982,9 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
         String fileName;
         while (fileWatchers_[i]->GetNextChange(fileName))
         {
+            if (useDirectoryIndex_)
+                UpdateDirectoryIndex(fileWatchers_[i]->GetPath(), fileName);
+            
             ReloadResourceWithDependencies(fileName);
 
             // Finally send a general file changed event even if the file was not a tracked resource
@@ -965,10 +1006,9 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
 
 File* ResourceCache::SearchResourceDirs(const String& nameIn)
 {
-    FileSystem* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.Size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + nameIn))
+        if (ResourceDirContains(i, nameIn))
         {
             // Construct the file first with full path, then rename it to not contain the resource path,
             // so that the file's name can be used in further GetFile() calls (for example over the network)
@@ -979,12 +1019,101 @@ File* ResourceCache::SearchResourceDirs(const String& nameIn)
     }
 
     // Fallback using absolute path
-    if (fileSystem->FileExists(nameIn))
+    if (GetSubsystem<FileSystem>()->FileExists(nameIn))
         return new File(context_, nameIn);
 
     return 0;
 }
 
+bool ResourceCache::ResourceDirContains(unsigned index, const String& name) const
+{
+    if (!useDirectoryIndex_ || !CanIndexResourceDir(resourceDirs_[index]))
+        return GetSubsystem<FileSystem>()->FileExists(resourceDirs_[index] + name);
+    
+    #ifdef CASE_INSENSITIVE_INDEX
+    return resourceDirIndices_[index].Contains(name.ToLower());
+    #else
+    return resourceDirIndices_[index].Contains(name);
+    #endif
+}
+
+void ResourceCache::BuildDirectoryIndex(HashSet<String>& dest, const String& path) const
+{
+    PROFILE(BuildDirectoryIndex);
+    
+    dest.Clear();
+    if (!CanIndexResourceDir(path))
+        return;
+    
+    Vector<String> files;
+    GetSubsystem<FileSystem>()->ScanDir(files, path, "*", SCAN_FILES | SCAN_HIDDEN, true);
+    
+    for (unsigned i = 0; i < files.Size(); ++i)
+    {
+        #ifdef CASE_INSENSITIVE_INDEX
+        dest.Insert(files[i].ToLower());
+        #else
+        dest.Insert(files[i]);
+        #endif
+    }
+    
+    LOGDEBUG("Indexed " + String(files.Size()) + " files in resource path " + path);
+}
+
+void ResourceCache::UpdateDirectoryIndex(const String& path, const String& fileName)
+{
+    MutexLock lock(resourceMutex_);
+    
+    for (unsigned i = 0; i < resourceDirs_.Size(); ++i)
+    {
+        if (resourceDirs_[i].Compare(path, false))
+            continue;
+        
+        HashSet<String>& index = resourceDirIndices_[i];
+        FileSystem* fileSystem = GetSubsystem<FileSystem>();
+        String fullName = path + fileName;
+        #ifdef CASE_INSENSITIVE_INDEX
+        String indexName = fileName.ToLower();
+        #else
+        String indexName = fileName;
+        #endif
+        
+        if (fileSystem->FileExists(fullName))
+            index.Insert(indexName);
+        else if (fileSystem->DirExists(fullName))
+        {
+            // A directory was added or renamed, so index its files
+            Vector<String> files;
+            fileSystem->ScanDir(files, fullName, "*", SCAN_FILES | SCAN_HIDDEN, true);
+            for (unsigned j = 0; j < files.Size(); ++j)
+            {
+                #ifdef CASE_INSENSITIVE_INDEX
+                index.Insert(indexName + "/" + files[j].ToLower());
+                #else
+                index.Insert(indexName + "/" + files[j]);
+                #endif
+            }
+        }
+        else
+        {
+            // A file or directory was removed. If it was not an indexed file, remove the files below the directory
+            if (!index.Erase(indexName))
+            {
+                String dirPrefix = indexName + "/";
+                for (HashSet<String>::Iterator j = index.Begin(); j != index.End();)
+                {
+                    if (j->StartsWith(dirPrefix))
+                        j = index.Erase(j);
+                    else
+                        ++j;
+                }
+            }
+        }
+        
+        return;
+    }
+}
+
 File* ResourceCache::SearchPackages(const String& nameIn)
 {
     for (unsigned i = 0; i < packages_.Size(); ++i)
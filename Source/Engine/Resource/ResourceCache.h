@@ -126,6 +126,8 @@ public:
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
     /// Set the resource router object. By default there is none, so the routing process is skipped.
     void SetResourceRouter(ResourceRouter* router) { resourceRouter_ = router; }
+    /// Enable or disable the in-memory index of the files in the resource directories. Default true. When enabled, file lookups from the resource directories do not access the filesystem, and files added to a resource directory by other means than the engine's file watchers are not found until the index is rebuilt by re-enabling it.
+    void SetUseDirectoryIndex(bool enable);
     
     /// Open and return a file from the resource load paths or from inside a package file. If not found, use a fallback search with absolute path. Return null if fails. Can be called from outside the main thread.
     SharedPtr<File> GetFile(const String& name, bool sendEventOnFailure = true);
@@ -173,6 +175,8 @@ public:
     int GetFinishBackgroundResourcesMs() const { return finishBackgroundResourcesMs_; }
     /// Return the resource router.
     ResourceRouter* GetResourceRouter() const { return resourceRouter_; }
+    /// Return whether the resource directory file index is in use.
+    bool GetUseDirectoryIndex() const { return useDirectoryIndex_; }
 
     /// Return either the path itself or its parent, based on which of them has recognized resource subdirectories.
     String GetPreferredResourceDir(const String& path) const;
@@ -198,6 +202,12 @@ private:
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
     /// Search FileSystem for file.
     File* SearchResourceDirs(const String& nameIn);
+    /// Return whether a resource directory contains a file. Uses the directory index if enabled.
+    bool ResourceDirContains(unsigned index, const String& name) const;
+    /// Build the file index of a resource directory.
+    void BuildDirectoryIndex(HashSet<String>& dest, const String& path) const;
+    /// Update the file index of a resource directory for a file change reported by its file watcher.
+    void UpdateDirectoryIndex(const String& path, const String& fileName);
     /// Search resource packages for file.
     File* SearchPackages(const String& nameIn);
     
@@ -207,6 +217,8 @@ private:
     HashMap<StringHash, ResourceGroup> resourceGroups_;
     /// Resource load directories.
     Vector<String> resourceDirs_;
+    /// File indices of the resource directories, in the same order as the directories. Empty if the index is not in use.
+    Vector<HashSet<String> > resourceDirIndices_;
     /// File watchers for resource directories, if automatic reloading enabled.
     Vector<SharedPtr<FileWatcher> > fileWatchers_;
     /// Package files.
@@ -223,6 +235,8 @@ private:
     bool returnFailedResources_;
     /// Search priority flag.
     bool searchPackagesFirst_;
+    /// Resource directory file index flag.
+    bool useDirectoryIndex_;
     /// How many milliseconds maximum per frame to spend on finishing background loaded resources.
     int finishBackgroundResourcesMs_;
 };
@@ -59,7 +59,8 @@ void AttributeAnimationInfo::ApplyValue(const Variant& newValue)
 
 Animatable::Animatable(Context* context) :
     Serializable(context),
-    animationEnabled_(true)
+    animationEnabled_(true),
+    animationUpdateIndex_(M_MAX_UNSIGNED)
 {
 }
 
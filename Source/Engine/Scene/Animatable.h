@@ -62,6 +62,8 @@ class URHO3D_API Animatable : public Serializable
 {
     OBJECT(Animatable);
 
+    friend class Scene;
+
 public:
     /// Construct.
     Animatable(Context* context);
@@ -88,6 +90,8 @@ public:
 
     /// Return animation enabled.
     bool GetAnimationEnabled() const { return animationEnabled_; }
+    /// Return whether has attribute animations.
+    bool HasAttributeAnimations() const { return !attributeAnimationInfos_.Empty(); }
     /// Return object animation.
     ObjectAnimation* GetObjectAnimation() const;
     /// Return attribute animation.
@@ -128,6 +132,10 @@ protected:
     HashSet<const AttributeInfo*> animatedNetworkAttributes_;
     /// Attribute animation infos.
     HashMap<String, SharedPtr<AttributeAnimationInfo> > attributeAnimationInfos_;
+
+private:
+    /// Index in the scene's attribute animation update list. Managed by Scene.
+    unsigned animationUpdateIndex_;
 };
 
 }
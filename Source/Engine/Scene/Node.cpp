@@ -1368,7 +1368,10 @@ void Node::MarkReplicationDirty()
 
 Node* Node::CreateChild(unsigned id, CreateMode mode)
 {
-    SharedPtr<Node> newNode(new Node(context_));
+    // Create through the factory so that node pooling can be used
+    SharedPtr<Node> newNode = StaticCast<Node>(context_->CreateObject(Node::GetTypeStatic()));
+    if (!newNode)
+        newNode = new Node(context_);
 
     // If zero ID specified, or the ID is already taken, let the scene assign
     if (scene_)
@@ -1462,14 +1465,14 @@ void Node::SetTransformSilent(const Vector3& position, const Quaternion& rotatio
 
 void Node::OnAttributeAnimationAdded()
 {
-    if (attributeAnimationInfos_.Size() == 1)
-        SubscribeToEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE, HANDLER(Node, HandleAttributeAnimationUpdate));
+    if (attributeAnimationInfos_.Size() == 1 && scene_)
+        scene_->AddAnimationUpdate(this);
 }
 
 void Node::OnAttributeAnimationRemoved()
 {
-    if (attributeAnimationInfos_.Empty())
-        UnsubscribeFromEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE);
+    if (attributeAnimationInfos_.Empty() && scene_)
+        scene_->RemoveAnimationUpdate(this);
 }
 
 void Node::SetObjectAttributeAnimation(const String& name, ValueAnimation* attributeAnimation, WrapMode wrapMode, float speed)
@@ -1767,11 +1770,4 @@ void Node::RemoveComponent(Vector<SharedPtr<Component> >::Iterator i)
         componentWeak->SetNode(0);
 }
 
-void Node::HandleAttributeAnimationUpdate(StringHash eventType, VariantMap& eventData)
-{
-    using namespace AttributeAnimationUpdate;
-
-    UpdateAttributeAnimations(eventData[P_TIMESTEP].GetFloat());
-}
-
 }
@@ -55,6 +55,10 @@ static const float DEFAULT_SNAP_THRESHOLD = 5.0f;
 
 Scene::Scene(Context* context) :
     Node(context),
+    replicatedNodes_(FIRST_REPLICATED_ID, LAST_REPLICATED_ID),
+    localNodes_(FIRST_LOCAL_ID, LAST_LOCAL_ID),
+    replicatedComponents_(FIRST_REPLICATED_ID, LAST_REPLICATED_ID),
+    localComponents_(FIRST_LOCAL_ID, LAST_LOCAL_ID),
     replicatedNodeID_(FIRST_REPLICATED_ID),
     replicatedComponentID_(FIRST_REPLICATED_ID),
     localNodeID_(FIRST_LOCAL_ID),
@@ -67,7 +71,8 @@ Scene::Scene(Context* context) :
     snapThreshold_(DEFAULT_SNAP_THRESHOLD),
     updateEnabled_(true),
     asyncLoading_(false),
-    threadedUpdate_(false)
+    threadedUpdate_(false),
+    updatingAnimations_(false)
 {
     // Assign an ID to self so that nodes can refer to this node as a parent
     SetID(GetFreeNodeID(REPLICATED));
@@ -85,10 +90,13 @@ Scene::~Scene()
     RemoveAllChildren();
 
     // Remove scene reference and owner from all nodes that still exist
-    for (HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
-        i->second_->ResetScene();
-    for (HashMap<unsigned, Node*>::Iterator i = localNodes_.Begin(); i != localNodes_.End(); ++i)
-        i->second_->ResetScene();
+    PODVector<Node*> nodes;
+    replicatedNodes_.GetObjects(nodes);
+    for (PODVector<Node*>::Iterator i = nodes.Begin(); i != nodes.End(); ++i)
+        (*i)->ResetScene();
+    localNodes_.GetObjects(nodes);
+    for (PODVector<Node*>::Iterator i = nodes.Begin(); i != nodes.End(); ++i)
+        (*i)->ResetScene();
 }
 
 void Scene::RegisterObject(Context* context)
@@ -190,8 +198,10 @@ void Scene::AddReplicationState(NodeReplicationState* state)
     Node::AddReplicationState(state);
 
     // This is the first update for a new connection. Mark all replicated nodes dirty
-    for (HashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
-        state->sceneState_->dirtyNodes_.Insert(i->first_);
+    PODVector<Node*> nodes;
+    replicatedNodes_.GetObjects(nodes);
+    for (PODVector<Node*>::ConstIterator i = nodes.Begin(); i != nodes.End(); ++i)
+        state->sceneState_->dirtyNodes_.Insert((*i)->GetID());
 }
 
 bool Scene::LoadXML(Deserializer& source)
@@ -467,11 +477,15 @@ void Scene::Clear(bool clearReplicated, bool clearLocal)
     {
         replicatedNodeID_ = FIRST_REPLICATED_ID;
         replicatedComponentID_ = FIRST_REPLICATED_ID;
+        replicatedNodes_.ClearFreeIDs();
+        replicatedComponents_.ClearFreeIDs();
     }
     if (clearLocal)
     {
         localNodeID_ = FIRST_LOCAL_ID;
         localComponentID_ = FIRST_LOCAL_ID;
+        localNodes_.ClearFreeIDs();
+        localComponents_.ClearFreeIDs();
     }
 }
 
@@ -539,42 +553,22 @@ void Scene::UnregisterAllVars()
 
 Node* Scene::GetNode(unsigned id) const
 {
-    if (id < FIRST_LOCAL_ID)
-    {
-        HashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Find(id);
-        if (i != replicatedNodes_.End())
-            return i->second_;
-        else
-            return 0;
-    }
-    else
-    {
-        HashMap<unsigned, Node*>::ConstIterator i = localNodes_.Find(id);
-        if (i != localNodes_.End())
-            return i->second_;
-        else
-            return 0;
-    }
+    return id < FIRST_LOCAL_ID ? replicatedNodes_.Find(id) : localNodes_.Find(id);
 }
 
 Component* Scene::GetComponent(unsigned id) const
 {
-    if (id < FIRST_LOCAL_ID)
-    {
-        HashMap<unsigned, Component*>::ConstIterator i = replicatedComponents_.Find(id);
-        if (i != replicatedComponents_.End())
-            return i->second_;
-        else
-            return 0;
-    }
-    else
-    {
-        HashMap<unsigned, Component*>::ConstIterator i = localComponents_.Find(id);
-        if (i != localComponents_.End())
-            return i->second_;
-        else
-            return 0;
-    }
+    return id < FIRST_LOCAL_ID ? replicatedComponents_.Find(id) : localComponents_.Find(id);
+}
+
+unsigned Scene::GetNodeGeneration(unsigned id) const
+{
+    return id < FIRST_LOCAL_ID ? replicatedNodes_.GetGeneration(id) : localNodes_.GetGeneration(id);
+}
+
+unsigned Scene::GetComponentGeneration(unsigned id) const
+{
+    return id < FIRST_LOCAL_ID ? replicatedComponents_.GetGeneration(id) : localComponents_.GetGeneration(id);
 }
 
 float Scene::GetAsyncProgress() const
@@ -617,7 +611,8 @@ void Scene::Update(float timeStep)
     // Update variable timestep logic
     SendEvent(E_SCENEUPDATE, eventData);
 
-    // Update scene attribute animation.
+    // Update scene attribute animation. Nodes and components are updated in bulk, other subscribers through the event
+    UpdateAnimations(timeStep);
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
 
     // Update scene subsystems. If a physics world is present, it will be updated, triggering fixed timestep logic updates
@@ -672,72 +667,24 @@ void Scene::EndThreadedUpdate()
 
 void Scene::DelayedMarkedDirty(Component* component)
 {
-    MutexLock lock(sceneMutex_);
+    LockGuard<SpinLock> lock(sceneLock_);
     delayedDirtyComponents_.Push(component);
 }
 
 unsigned Scene::GetFreeNodeID(CreateMode mode)
 {
     if (mode == REPLICATED)
-    {
-        for (;;)
-        {
-            unsigned ret = replicatedNodeID_;
-            if (replicatedNodeID_ < LAST_REPLICATED_ID)
-                ++replicatedNodeID_;
-            else
-                replicatedNodeID_ = FIRST_REPLICATED_ID;
-
-            if (!replicatedNodes_.Contains(ret))
-                return ret;
-        }
-    }
+        return replicatedNodes_.GetFreeID(replicatedNodeID_);
     else
-    {
-        for (;;)
-        {
-            unsigned ret =  localNodeID_;
-            if (localNodeID_ < LAST_LOCAL_ID)
-                ++localNodeID_;
-            else
-                localNodeID_ = FIRST_LOCAL_ID;
-
-            if (!localNodes_.Contains(ret))
-                return ret;
-        }
-    }
+        return localNodes_.GetFreeID(localNodeID_);
 }
 
 unsigned Scene::GetFreeComponentID(CreateMode mode)
 {
     if (mode == REPLICATED)
-    {
-        for (;;)
-        {
-            unsigned ret = replicatedComponentID_;
-            if (replicatedComponentID_ < LAST_REPLICATED_ID)
-                ++replicatedComponentID_;
-            else
-                replicatedComponentID_ = FIRST_REPLICATED_ID;
-
-            if (!replicatedComponents_.Contains(ret))
-                return ret;
-        }
-    }
+        return replicatedComponents_.GetFreeID(replicatedComponentID_);
     else
-    {
-        for (;;)
-        {
-            unsigned ret =  localComponentID_;
-            if (localComponentID_ < LAST_LOCAL_ID)
-                ++localComponentID_;
-            else
-                localComponentID_ = FIRST_LOCAL_ID;
-
-            if (!localComponents_.Contains(ret))
-                return ret;
-        }
-    }
+        return localComponents_.GetFreeID(localComponentID_);
 }
 
 void Scene::NodeAdded(Node* node)
@@ -755,6 +702,8 @@ void Scene::NodeAdded(Node* node)
     }
 
     node->SetScene(this);
+    if (node->HasAttributeAnimations())
+        AddAnimationUpdate(node);
 
     // If the new node has an ID of zero (default), assign a replicated ID now
     unsigned id = node->GetID();
@@ -767,28 +716,28 @@ void Scene::NodeAdded(Node* node)
     // If node with same ID exists, remove the scene reference from it and overwrite with the new node
     if (id < FIRST_LOCAL_ID)
     {
-        HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Find(id);
-        if (i != replicatedNodes_.End() && i->second_ != node)
+        Node* oldNode = replicatedNodes_.Find(id);
+        if (oldNode && oldNode != node)
         {
             LOGWARNING("Overwriting node with ID " + String(id));
-            i->second_->ResetScene();
+            oldNode->ResetScene();
         }
 
-        replicatedNodes_[id] = node;
+        replicatedNodes_.Insert(id, node);
 
         MarkNetworkUpdate(node);
         MarkReplicationDirty(node);
     }
     else
     {
-        HashMap<unsigned, Node*>::Iterator i = localNodes_.Find(id);
-        if (i != localNodes_.End() && i->second_ != node)
+        Node* oldNode = localNodes_.Find(id);
+        if (oldNode && oldNode != node)
         {
             LOGWARNING("Overwriting node with ID " + String(id));
-            i->second_->ResetScene();
+            oldNode->ResetScene();
         }
 
-        localNodes_[id] = node;
+        localNodes_.Insert(id, node);
     }
 }
 
@@ -806,6 +755,7 @@ void Scene::NodeRemoved(Node* node)
     else
         localNodes_.Erase(id);
 
+    RemoveAnimationUpdate(node);
     node->SetID(0);
     node->SetScene(0);
 }
@@ -818,26 +768,29 @@ void Scene::ComponentAdded(Component* component)
     unsigned id = component->GetID();
     if (id < FIRST_LOCAL_ID)
     {
-        HashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Find(id);
-        if (i != replicatedComponents_.End() && i->second_ != component)
+        Component* oldComponent = replicatedComponents_.Find(id);
+        if (oldComponent && oldComponent != component)
         {
             LOGWARNING("Overwriting component with ID " + String(id));
-            i->second_->SetID(0);
+            oldComponent->SetID(0);
         }
 
-        replicatedComponents_[id] = component;
+        replicatedComponents_.Insert(id, component);
     }
     else
     {
-        HashMap<unsigned, Component*>::Iterator i = localComponents_.Find(id);
-        if (i != localComponents_.End() && i->second_ != component)
+        Component* oldComponent = localComponents_.Find(id);
+        if (oldComponent && oldComponent != component)
         {
             LOGWARNING("Overwriting component with ID " + String(id));
-            i->second_->SetID(0);
+            oldComponent->SetID(0);
         }
 
-        localComponents_[id] = component;
+        localComponents_.Insert(id, component);
     }
+
+    if (component->HasAttributeAnimations())
+        AddAnimationUpdate(component);
 }
 
 void Scene::ComponentRemoved(Component* component)
@@ -851,9 +804,45 @@ void Scene::ComponentRemoved(Component* component)
     else
         localComponents_.Erase(id);
 
+    RemoveAnimationUpdate(component);
     component->SetID(0);
 }
 
+void Scene::AddAnimationUpdate(Animatable* animatable)
+{
+    // The index may be stale if the object belonged to a destroyed scene, so verify it
+    unsigned index = animatable->animationUpdateIndex_;
+    if (index < animationUpdates_.Size() && animationUpdates_[index] == animatable)
+        return;
+
+    animatable->animationUpdateIndex_ = animationUpdates_.Size();
+    animationUpdates_.Push(WeakPtr<Animatable>(animatable));
+}
+
+void Scene::RemoveAnimationUpdate(Animatable* animatable)
+{
+    unsigned index = animatable->animationUpdateIndex_;
+    if (index >= animationUpdates_.Size() || animationUpdates_[index] != animatable)
+        return;
+
+    animatable->animationUpdateIndex_ = M_MAX_UNSIGNED;
+
+    // During the update only null the entry, so that the update loop indices stay valid
+    if (updatingAnimations_)
+    {
+        animationUpdates_[index].Reset();
+        return;
+    }
+
+    if (index != animationUpdates_.Size() - 1)
+    {
+        animationUpdates_[index] = animationUpdates_.Back();
+        if (animationUpdates_[index])
+            animationUpdates_[index]->animationUpdateIndex_ = index;
+    }
+    animationUpdates_.Pop();
+}
+
 void Scene::SetVarNamesAttr(String value)
 {
     Vector<String> varNames = value.Split(';');
@@ -902,11 +891,15 @@ void Scene::CleanupConnection(Connection* connection)
 {
     Node::CleanupConnection(connection);
 
-    for (HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
-        i->second_->CleanupConnection(connection);
+    PODVector<Node*> nodes;
+    replicatedNodes_.GetObjects(nodes);
+    for (PODVector<Node*>::Iterator i = nodes.Begin(); i != nodes.End(); ++i)
+        (*i)->CleanupConnection(connection);
 
-    for (HashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Begin(); i != replicatedComponents_.End(); ++i)
-        i->second_->CleanupConnection(connection);
+    PODVector<Component*> components;
+    replicatedComponents_.GetObjects(components);
+    for (PODVector<Component*>::Iterator i = components.Begin(); i != components.End(); ++i)
+        (*i)->CleanupConnection(connection);
 }
 
 void Scene::MarkNetworkUpdate(Node* node)
@@ -917,7 +910,7 @@ void Scene::MarkNetworkUpdate(Node* node)
             networkUpdateNodes_.Insert(node->GetID());
         else
         {
-            MutexLock lock(sceneMutex_);
+            LockGuard<SpinLock> lock(sceneLock_);
             networkUpdateNodes_.Insert(node->GetID());
         }
     }
@@ -931,7 +924,7 @@ void Scene::MarkNetworkUpdate(Component* component)
             networkUpdateComponents_.Insert(component->GetID());
         else
         {
-            MutexLock lock(sceneMutex_);
+            LockGuard<SpinLock> lock(sceneLock_);
             networkUpdateComponents_.Insert(component->GetID());
         }
     }
@@ -1217,6 +1210,39 @@ void Scene::PreloadResourcesXML(const XMLElement& element)
     }
 }
 
+void Scene::UpdateAnimations(float timeStep)
+{
+    if (animationUpdates_.Empty())
+        return;
+
+    PROFILE(UpdateAttributeAnimations);
+
+    // Objects added during the update are first updated on the next frame
+    updatingAnimations_ = true;
+    unsigned numUpdates = animationUpdates_.Size();
+    for (unsigned i = 0; i < numUpdates; ++i)
+    {
+        Animatable* animatable = animationUpdates_[i];
+        if (animatable)
+            animatable->UpdateAttributeAnimations(timeStep);
+    }
+    updatingAnimations_ = false;
+
+    // Compact away entries that were removed during the update or whose objects were destroyed
+    for (unsigned i = animationUpdates_.Size() - 1; i < animationUpdates_.Size(); --i)
+    {
+        if (!animationUpdates_[i])
+        {
+            if (i != animationUpdates_.Size() - 1)
+            {
+                animationUpdates_[i] = animationUpdates_.Back();
+                animationUpdates_[i]->animationUpdateIndex_ = i;
+            }
+            animationUpdates_.Pop();
+        }
+    }
+}
+
 void RegisterSceneLibrary(Context* context)
 {
     ValueAnimation::RegisterObject(context);
@@ -25,6 +25,7 @@
 #include "HashSet.h"
 #include "Mutex.h"
 #include "Node.h"
+#include "SceneIDMap.h"
 #include "SceneResolver.h"
 #include "XMLElement.h"
 
@@ -145,6 +146,18 @@ public:
     Node* GetNode(unsigned id) const;
     /// Return component from the whole scene by ID, or null if not found.
     Component* GetComponent(unsigned id) const;
+    /// Return how many times a node ID has been released. Store along with the ID to detect whether it has since been reused.
+    unsigned GetNodeGeneration(unsigned id) const;
+    /// Return how many times a component ID has been released. Store along with the ID to detect whether it has since been reused.
+    unsigned GetComponentGeneration(unsigned id) const;
+    /// Return number of replicated nodes, including the scene itself.
+    unsigned GetNumReplicatedNodes() const { return replicatedNodes_.Size(); }
+    /// Return number of local nodes.
+    unsigned GetNumLocalNodes() const { return localNodes_.Size(); }
+    /// Return number of replicated components.
+    unsigned GetNumReplicatedComponents() const { return replicatedComponents_.Size(); }
+    /// Return number of local components.
+    unsigned GetNumLocalComponents() const { return localComponents_.Size(); }
     /// Return whether updates are enabled.
     bool IsUpdateEnabled() const { return updateEnabled_; }
     /// Return whether an asynchronous loading operation is in progress.
@@ -208,6 +221,10 @@ public:
     void MarkNetworkUpdate(Component* component);
     /// Mark a node dirty in scene replication states. The node does not need to have own replication state yet.
     void MarkReplicationDirty(Node* node);
+    /// Add a node or component to the attribute animation update. Called when it gets its first attribute animation or is added to the scene with animations.
+    void AddAnimationUpdate(Animatable* animatable);
+    /// Remove a node or component from the attribute animation update.
+    void RemoveAnimationUpdate(Animatable* animatable);
 
 private:
     /// Handle the logic update event to update the scene, if active.
@@ -226,15 +243,17 @@ private:
     void PreloadResources(File* file, bool isSceneFile);
     /// Preload resources from an XML scene or object prefab file.
     void PreloadResourcesXML(const XMLElement& element);
+    /// Update the attribute animations of all animated nodes and components in one pass.
+    void UpdateAnimations(float timeStep);
 
     /// Replicated scene nodes by ID.
-    HashMap<unsigned, Node*> replicatedNodes_;
+    SceneIDMap<Node> replicatedNodes_;
     /// Local scene nodes by ID.
-    HashMap<unsigned, Node*> localNodes_;
+    SceneIDMap<Node> localNodes_;
     /// Replicated components by ID.
-    HashMap<unsigned, Component*> replicatedComponents_;
+    SceneIDMap<Component> replicatedComponents_;
     /// Local components by ID.
-    HashMap<unsigned, Component*> localComponents_;
+    SceneIDMap<Component> localComponents_;
     /// Asynchronous loading progress.
     AsyncProgress asyncProgress_;
     /// Node and component ID resolver for asynchronous loading.
@@ -251,8 +270,10 @@ private:
     HashSet<unsigned> networkUpdateComponents_;
     /// Delayed dirty notification queue for components.
     PODVector<Component*> delayedDirtyComponents_;
-    /// Mutex for the delayed dirty notification queue.
-    Mutex sceneMutex_;
+    /// Nodes and components with attribute animations. Entries removed during the update are nulled and compacted afterward.
+    Vector<WeakPtr<Animatable> > animationUpdates_;
+    /// Lock for the delayed dirty notification and network update queues during threaded update.
+    SpinLock sceneLock_;
     /// Preallocated event data map for smoothing update events.
     VariantMap smoothingData_;
     /// Next free non-local node ID.
@@ -281,6 +302,8 @@ private:
     bool asyncLoading_;
     /// Threaded update flag.
     bool threadedUpdate_;
+    /// Attribute animation update in progress flag.
+    bool updatingAnimations_;
 };
 
 /// Register Scene library objects.
@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "HashMap.h"
+
+namespace Urho3D
+{
+
+/// Minimum number of IDs that are mapped densely regardless of the object count.
+static const unsigned MIN_DENSE_IDS = 1024;
+/// Number of released IDs that must be waiting before the oldest of them is reused. Delays reuse so that network messages and other references to removed objects do not immediately resolve to new ones.
+static const unsigned ID_REUSE_DELAY = 1024;
+
+/// Scene ID map slot.
+template <class T> struct SceneIDSlot
+{
+    /// Construct.
+    SceneIDSlot() :
+        object_(0),
+        generation_(0)
+    {
+    }
+    
+    /// Object using the ID, or null if unused.
+    T* object_;
+    /// Number of times the ID has been released.
+    unsigned generation_;
+};
+
+/// Map from the scene node or component IDs of one ID range to objects. IDs near the beginning of the range are mapped with a dense array, released IDs are reused in first-in, first-out order to keep the IDs dense, and per-ID generation counters allow detecting stale IDs.
+template <class T> class SceneIDMap
+{
+public:
+    /// Construct with ID range.
+    SceneIDMap(unsigned firstID, unsigned lastID) :
+        firstID_(firstID),
+        lastID_(lastID),
+        numObjects_(0),
+        freeHead_(0)
+    {
+    }
+    
+    /// Add an object. Replaces any previous object with the same ID.
+    void Insert(unsigned id, T* object)
+    {
+        SceneIDSlot<T>& slot = GetSlot(id);
+        if (!slot.object_)
+            ++numObjects_;
+        slot.object_ = object;
+    }
+    
+    /// Remove the object with the given ID, advance the ID's generation and queue the ID for reuse.
+    void Erase(unsigned id)
+    {
+        SceneIDSlot<T>* slot = FindSlot(id);
+        if (!slot || !slot->object_)
+            return;
+        
+        slot->object_ = 0;
+        ++slot->generation_;
+        --numObjects_;
+        freeIDs_.Push(id);
+    }
+    
+    /// Return a free ID. Reuses the oldest released ID if enough are waiting, otherwise advances the sequential ID counter.
+    unsigned GetFreeID(unsigned& nextID)
+    {
+        while (freeIDs_.Size() - freeHead_ > ID_REUSE_DELAY)
+        {
+            unsigned id = freeIDs_[freeHead_++];
+            // Compact the free ID queue once half of it has been consumed
+            if (freeHead_ >= freeIDs_.Size() / 2)
+            {
+                freeIDs_.Erase(0, freeHead_);
+                freeHead_ = 0;
+            }
+            // The ID may have been taken explicitly in the meanwhile
+            if (!Find(id))
+                return id;
+        }
+        
+        for (;;)
+        {
+            unsigned ret = nextID;
+            if (nextID < lastID_)
+                ++nextID;
+            else
+                nextID = firstID_;
+            
+            if (!Find(ret))
+                return ret;
+        }
+    }
+    
+    /// Forget the released IDs waiting for reuse. Called when the ID counter is reset.
+    void ClearFreeIDs()
+    {
+        freeIDs_.Clear();
+        freeHead_ = 0;
+    }
+    
+    /// Return object by ID, or null if not found.
+    T* Find(unsigned id) const
+    {
+        unsigned index = id - firstID_;
+        if (index < slots_.Size())
+            return slots_[index].object_;
+        if (overflow_.Empty())
+            return 0;
+        
+        typename HashMap<unsigned, SceneIDSlot<T> >::ConstIterator i = overflow_.Find(id);
+        return i != overflow_.End() ? i->second_.object_ : 0;
+    }
+    
+    /// Return how many times an ID has been released.
+    unsigned GetGeneration(unsigned id) const
+    {
+        unsigned index = id - firstID_;
+        if (index < slots_.Size())
+            return slots_[index].generation_;
+        
+        typename HashMap<unsigned, SceneIDSlot<T> >::ConstIterator i = overflow_.Find(id);
+        return i != overflow_.End() ? i->second_.generation_ : 0;
+    }
+    
+    /// Return all objects.
+    void GetObjects(PODVector<T*>& dest) const
+    {
+        dest.Clear();
+        dest.Reserve(numObjects_);
+        
+        for (unsigned i = 0; i < slots_.Size(); ++i)
+        {
+            if (slots_[i].object_)
+                dest.Push(slots_[i].object_);
+        }
+        for (typename HashMap<unsigned, SceneIDSlot<T> >::ConstIterator i = overflow_.Begin(); i != overflow_.End(); ++i)
+        {
+            if (i->second_.object_)
+                dest.Push(i->second_.object_);
+        }
+    }
+    
+    /// Return number of objects.
+    unsigned Size() const { return numObjects_; }
+    
+private:
+    /// Return the slot for an ID, or null if not found.
+    SceneIDSlot<T>* FindSlot(unsigned id)
+    {
+        unsigned index = id - firstID_;
+        if (index < slots_.Size())
+            return &slots_[index];
+        
+        typename HashMap<unsigned, SceneIDSlot<T> >::Iterator i = overflow_.Find(id);
+        return i != overflow_.End() ? &i->second_ : 0;
+    }
+    
+    /// Return the slot for an ID, creating it if necessary.
+    SceneIDSlot<T>& GetSlot(unsigned id)
+    {
+        unsigned index = id - firstID_;
+        if (index < slots_.Size())
+            return slots_[index];
+        
+        // Grow the dense array if the ID is not too far from the current object count, otherwise use the sparse overflow map
+        unsigned denseLimit = numObjects_ * 2 > MIN_DENSE_IDS ? numObjects_ * 2 : MIN_DENSE_IDS;
+        if (index >= denseLimit)
+            return overflow_[id];
+        
+        unsigned oldSize = slots_.Size();
+        unsigned newSize = oldSize * 2 < denseLimit ? oldSize * 2 : denseLimit;
+        if (newSize <= index)
+            newSize = index + 1;
+        slots_.Resize(newSize);
+        for (unsigned i = oldSize; i < newSize; ++i)
+            slots_[i] = SceneIDSlot<T>();
+        
+        // Move overflowed IDs now covered by the dense array
+        for (typename HashMap<unsigned, SceneIDSlot<T> >::Iterator i = overflow_.Begin(); i != overflow_.End();)
+        {
+            if (i->first_ - firstID_ < newSize)
+            {
+                slots_[i->first_ - firstID_] = i->second_;
+                i = overflow_.Erase(i);
+            }
+            else
+                ++i;
+        }
+        
+        return slots_[index];
+    }
+    
+    /// Dense ID slots, starting from the first ID of the range.
+    PODVector<SceneIDSlot<T> > slots_;
+    /// Sparse ID slots beyond the dense array.
+    HashMap<unsigned, SceneIDSlot<T> > overflow_;
+    /// Released IDs in release order.
+    PODVector<unsigned> freeIDs_;
+    /// First ID of the range.
+    unsigned firstID_;
+    /// Last ID of the range.
+    unsigned lastID_;
+    /// Number of objects.
+    unsigned numObjects_;
+    /// Index of the oldest released ID in the queue.
+    unsigned freeHead_;
+};
+
+}
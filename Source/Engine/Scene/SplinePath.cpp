@@ -32,6 +32,22 @@ namespace Urho3D
 extern const char* interpolationModeNames[];
 extern const char* LOGIC_CATEGORY;
 
+static const unsigned NUM_ARC_LENGTH_SAMPLES = 256;
+static const unsigned MAX_STACK_KNOTS = 32;
+
+/// Evaluate a Bezier curve with de Casteljau's algorithm, using caller-supplied work memory.
+static Vector3 BezierPoint(const Vector3* knots, unsigned numKnots, float t, Vector3* work)
+{
+    for (unsigned i = 0; i < numKnots; ++i)
+        work[i] = knots[i];
+    for (unsigned n = numKnots - 1; n > 0; --n)
+    {
+        for (unsigned i = 0; i < n; ++i)
+            work[i] = work[i].Lerp(work[i + 1], t);
+    }
+    return work[0];
+}
+
 SplinePath::SplinePath(Context* context) :
     Component(context),
     spline_(BEZIER_CURVE),
@@ -108,12 +124,12 @@ void SplinePath::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 {
     if (debug && node_ && IsEnabledEffective())
     {
-        if (spline_.GetKnots().Size() > 1)
+        if (knotPositions_.Size() > 1)
         {
-            Vector3 a = spline_.GetPoint(0.f).GetVector3();
+            Vector3 a = GetPoint(0.f);
             for (float f = 0.01f; f <= 1.0f; f = f + 0.01f)
             {
-                Vector3 b = spline_.GetPoint(f).GetVector3();
+                Vector3 b = GetPoint(f);
                 debug->AddLine(a, b, Color::GREEN);
                 a = b;
             }
@@ -202,12 +218,83 @@ void SplinePath::SetPosition(float factor)
     else if (t > 1.0f)
         t = 1.0f;
 
-    traveled_ = t;
+    // The traveled amount is stored as a fraction of the path length, so convert the spline factor to it
+    traveled_ = length_ > 0.0f ? GetLengthAtFactor(t) / length_ : t;
 }
 
 Vector3 SplinePath::GetPoint(float factor) const
 {
-    return spline_.GetPoint(factor).GetVector3();
+    unsigned numKnots = knotPositions_.Size();
+    if (numKnots < 2)
+        return numKnots == 1 ? knotPositions_[0] : Vector3::ZERO;
+
+    float t = Clamp(factor, 0.0f, 1.0f);
+    if (numKnots <= MAX_STACK_KNOTS)
+    {
+        Vector3 work[MAX_STACK_KNOTS];
+        return BezierPoint(&knotPositions_[0], numKnots, t, work);
+    }
+    else
+    {
+        PODVector<Vector3> work(numKnots);
+        return BezierPoint(&knotPositions_[0], numKnots, t, &work[0]);
+    }
+}
+
+void SplinePath::GetPoints(const PODVector<float>& factors, PODVector<Vector3>& dest) const
+{
+    unsigned numKnots = knotPositions_.Size();
+    dest.Resize(factors.Size());
+    if (numKnots < 2)
+    {
+        Vector3 point = numKnots == 1 ? knotPositions_[0] : Vector3::ZERO;
+        for (unsigned i = 0; i < dest.Size(); ++i)
+            dest[i] = point;
+        return;
+    }
+
+    // Allocate the work memory once for the whole batch
+    PODVector<Vector3> work(numKnots);
+    for (unsigned i = 0; i < factors.Size(); ++i)
+        dest[i] = BezierPoint(&knotPositions_[0], numKnots, Clamp(factors[i], 0.0f, 1.0f), &work[0]);
+}
+
+float SplinePath::GetFactorAtLength(float distance) const
+{
+    if (length_ <= 0.0f || distance <= 0.0f)
+        return 0.0f;
+    if (distance >= length_)
+        return 1.0f;
+
+    // Binary search for the sample interval containing the distance, then interpolate within it
+    unsigned low = 0;
+    unsigned high = arcLengths_.Size() - 1;
+    while (high - low > 1)
+    {
+        unsigned mid = (low + high) >> 1;
+        if (arcLengths_[mid] <= distance)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    float intervalLength = arcLengths_[high] - arcLengths_[low];
+    float fraction = intervalLength > 0.0f ? (distance - arcLengths_[low]) / intervalLength : 0.0f;
+    return ((float)low + fraction) / (float)(arcLengths_.Size() - 1);
+}
+
+float SplinePath::GetLengthAtFactor(float factor) const
+{
+    if (arcLengths_.Size() < 2 || factor <= 0.0f)
+        return 0.0f;
+    if (factor >= 1.0f)
+        return length_;
+
+    // The arc length table is sampled at uniformly spaced factors, so interpolate between the two nearest samples
+    float position = factor * (float)(arcLengths_.Size() - 1);
+    unsigned low = (unsigned)position;
+    float fraction = position - (float)low;
+    return arcLengths_[low] + (arcLengths_[low + 1] - arcLengths_[low]) * fraction;
 }
 
 void SplinePath::Move(float timeStep)
@@ -221,7 +308,8 @@ void SplinePath::Move(float timeStep)
     float distanceCovered = elapsedTime_ * speed_;
     traveled_ = distanceCovered / length_;
 
-    controlledNode_->SetWorldPosition(GetPoint(traveled_));
+    // Map the distance to a spline factor through the arc length table so that the movement speed stays constant
+    controlledNode_->SetWorldPosition(GetPointAtLength(distanceCovered));
 }
 
 void SplinePath::Reset()
@@ -331,17 +419,29 @@ void SplinePath::UpdateNodeIds()
 
 void SplinePath::CalculateLength()
 {
-    if (spline_.GetKnots().Size() <= 0)
-        return;
+    const VariantVector& knots = spline_.GetKnots();
+    knotPositions_.Resize(knots.Size());
+    for (unsigned i = 0; i < knots.Size(); ++i)
+        knotPositions_[i] = knots[i].GetVector3();
 
     length_ = 0.f;
+    arcLengths_.Clear();
+    if (knotPositions_.Size() < 2)
+        return;
+
+    // Sum the chord lengths between uniformly spaced factors into a cumulative table
+    PODVector<float> factors(NUM_ARC_LENGTH_SAMPLES + 1);
+    for (unsigned i = 0; i <= NUM_ARC_LENGTH_SAMPLES; ++i)
+        factors[i] = (float)i / (float)NUM_ARC_LENGTH_SAMPLES;
+    PODVector<Vector3> points;
+    GetPoints(factors, points);
 
-    Vector3 a = spline_.GetKnot(0).GetVector3();
-    for (float f = 0.000f; f <= 1.000f; f += 0.001f)
+    arcLengths_.Resize(NUM_ARC_LENGTH_SAMPLES + 1);
+    arcLengths_[0] = 0.f;
+    for (unsigned i = 1; i <= NUM_ARC_LENGTH_SAMPLES; ++i)
     {
-        Vector3 b = spline_.GetPoint(f).GetVector3();
-        length_ += Abs((a - b).Length());
-        a = b;
+        length_ += (points[i] - points[i - 1]).Length();
+        arcLengths_[i] = length_;
     }
 }
 
@@ -64,7 +64,7 @@ public:
     void SetInterpolationMode(InterpolationMode interpolationMode);
     /// Set the movement Speed.
     void SetSpeed(float speed) { speed_ = speed; }
-    /// Set the controlled Node's position on the SplinePath.
+    /// Set the controlled Node's position on the SplinePath as a spline factor from 0.f to 1.f, the same as in GetPoint().
     void SetPosition(float factor);
     /// Set the Node to be moved along the SplinePath.
     void SetControlledNode(Node* controlled);
@@ -74,12 +74,22 @@ public:
     /// Get the movement Speed.
     float GetSpeed() const { return speed_; }
     /// Get the parent Node's last position on the spline.
-    Vector3 GetPosition() const { return GetPoint(traveled_); }
+    Vector3 GetPosition() const { return GetPointAtLength(traveled_ * length_); }
     /// Get the controlled Node.
     Node* GetControlledNode() const { return controlledNode_; }
+    /// Get the length of the SplinePath.
+    float GetLength() const { return length_; }
 
     /// Get a point on the SplinePath from 0.f to 1.f where 0 is the start and 1 is the end.
     Vector3 GetPoint(float factor) const;
+    /// Get points on the SplinePath for several factors at once.
+    void GetPoints(const PODVector<float>& factors, PODVector<Vector3>& dest) const;
+    /// Get the spline factor at a distance along the SplinePath, using the arc length table.
+    float GetFactorAtLength(float distance) const;
+    /// Get the distance along the SplinePath at a spline factor, using the arc length table.
+    float GetLengthAtFactor(float factor) const;
+    /// Get a point at a distance along the SplinePath. Equal distances give equally spaced points.
+    Vector3 GetPointAtLength(float distance) const { return GetPoint(GetFactorAtLength(distance)); }
 
     /// Move the controlled Node to the next position along the SplinePath based off the Speed value.
     void Move(float timeStep);
@@ -106,11 +116,15 @@ protected:
 private:
     /// Update the Node IDs of the Control Points.
     void UpdateNodeIds();
-    /// Calculate the length of the SplinePath. Used for movement calculations.
+    /// Update the knot positions, the arc length table and the length of the SplinePath. Used for movement calculations.
     void CalculateLength();
 
     /// The Control Points of the Spline.
     Spline spline_;
+    /// Knot positions of the Spline for evaluation without Variant conversions.
+    PODVector<Vector3> knotPositions_;
+    /// Distance along the SplinePath at uniformly spaced factors.
+    PODVector<float> arcLengths_;
     /// The Speed of movement along the Spline.
     float speed_;
     /// Amount of time that has elapsed while moving.
@@ -265,11 +265,20 @@ bool ValueAnimation::IsValid() const
 Variant ValueAnimation::GetAnimationValue(float scaledTime)
 {
     unsigned index = 1;
+    return GetAnimationValue(scaledTime, index);
+}
+
+Variant ValueAnimation::GetAnimationValue(float scaledTime, unsigned& keyFrameIndex)
+{
+    unsigned index = keyFrameIndex;
+    if (index < 1 || index > keyFrames_.Size() || scaledTime < keyFrames_[index - 1].time_)
+        index = 1;
     for (; index < keyFrames_.Size(); ++index)
     {
         if (scaledTime < keyFrames_[index].time_)
             break;
     }
+    keyFrameIndex = index;
 
     if (index >= keyFrames_.Size() || !interpolatable_)
         return keyFrames_[index - 1].value_;
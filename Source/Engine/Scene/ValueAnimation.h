@@ -111,6 +111,8 @@ public:
     float GetEndTime() const { return endTime_; }
     /// Return animation value.
     Variant GetAnimationValue(float scaledTime);
+    /// Return animation value, continuing the key frame search from the index found on the previous call when time has moved forward.
+    Variant GetAnimationValue(float scaledTime, unsigned& keyFrameIndex);
     /// Has event frames.
     bool HasEventFrames() const { return !eventFrames_.Empty(); }
     /// Return all event frames between time.
@@ -35,7 +35,8 @@ ValueAnimationInfo::ValueAnimationInfo(ValueAnimation* animation, WrapMode wrapM
     wrapMode_(wrapMode),
     speed_(speed),
     currentTime_(0.0f),
-    lastScaledTime_(0.0f)
+    lastScaledTime_(0.0f),
+    keyFrameIndex_(1)
 {
     speed_ = Max(0.0f, speed_);
 }
@@ -46,7 +47,8 @@ ValueAnimationInfo::ValueAnimationInfo(Object* target, ValueAnimation* animation
     wrapMode_(wrapMode),
     speed_(speed),
     currentTime_(0.0f),
-    lastScaledTime_(0.0f)
+    lastScaledTime_(0.0f),
+    keyFrameIndex_(1)
 {
     speed_ = Max(0.0f, speed_);
 }
@@ -57,7 +59,8 @@ ValueAnimationInfo::ValueAnimationInfo(const ValueAnimationInfo& other) :
     wrapMode_(other.wrapMode_),
     speed_(other.speed_),
     currentTime_(0.0f),
-    lastScaledTime_(0.0f)
+    lastScaledTime_(0.0f),
+    keyFrameIndex_(1)
 {
 }
 
@@ -81,7 +84,7 @@ bool ValueAnimationInfo::Update(float timeStep)
     float scaledTime = CalculateScaledTime(currentTime_, finished);
 
     // Apply to the target object
-    ApplyValue(animation_->GetAnimationValue(scaledTime));
+    ApplyValue(animation_->GetAnimationValue(scaledTime, keyFrameIndex_));
 
     // Send keyframe event if necessary
     if (animation_->HasEventFrames())
@@ -81,6 +81,8 @@ protected:
     float currentTime_;
     /// Last scaled time.
     float lastScaledTime_;
+    /// Key frame index found on the last update.
+    unsigned keyFrameIndex_;
 };
 
 }
@@ -25,6 +25,7 @@
 #include "Console.h"
 #include "DebugHud.h"
 #include "Engine.h"
+#include "FrameRecorder.h"
 
 namespace Urho3D
 {
@@ -128,17 +129,58 @@ static void RegisterEngine(asIScriptEngine* engine)
     engine->RegisterObjectMethod("Engine", "bool get_pauseMinimized() const", asMETHOD(Engine, GetPauseMinimized), asCALL_THISCALL);
     engine->RegisterObjectMethod("Engine", "void set_autoExit(bool)", asMETHOD(Engine, SetAutoExit), asCALL_THISCALL);
     engine->RegisterObjectMethod("Engine", "bool get_autoExit() const", asMETHOD(Engine, GetAutoExit), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "void set_serverTickMode(bool)", asMETHOD(Engine, SetServerTickMode), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "bool get_serverTickMode() const", asMETHOD(Engine, GetServerTickMode), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "float get_averageFrameTime() const", asMETHOD(Engine, GetAverageFrameTime), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "float get_frameTimeDeviation() const", asMETHOD(Engine, GetFrameTimeDeviation), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "float get_maxFrameTimeDeviation() const", asMETHOD(Engine, GetMaxFrameTimeDeviation), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "float get_frameLimiterSpinTime() const", asMETHOD(Engine, GetFrameLimiterSpinTime), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "float get_presentTime() const", asMETHOD(Engine, GetPresentTime), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "void set_pipelinedPresent(bool)", asMETHOD(Engine, SetPipelinedPresent), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "bool get_pipelinedPresent() const", asMETHOD(Engine, GetPipelinedPresent), asCALL_THISCALL);
     engine->RegisterObjectMethod("Engine", "bool get_initialized() const", asMETHOD(Engine, IsInitialized), asCALL_THISCALL);
     engine->RegisterObjectMethod("Engine", "bool get_exiting() const", asMETHOD(Engine, IsExiting), asCALL_THISCALL);
     engine->RegisterObjectMethod("Engine", "bool get_headless() const", asMETHOD(Engine, IsHeadless), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Engine", "bool get_serverProfile() const", asMETHOD(Engine, IsServerProfile), asCALL_THISCALL);
     engine->RegisterGlobalFunction("Engine@+ get_engine()", asFUNCTION(GetEngine), asCALL_CDECL);
 }
 
+static FrameRecorder* GetFrameRecorder()
+{
+    return GetScriptContext()->GetSubsystem<FrameRecorder>();
+}
+
+static void FrameRecorderAddRecordedEvent(const String& eventType, FrameRecorder* ptr)
+{
+    ptr->AddRecordedEvent(eventType);
+}
+
+static void FrameRecorderRemoveRecordedEvent(const String& eventType, FrameRecorder* ptr)
+{
+    ptr->RemoveRecordedEvent(eventType);
+}
+
+static void RegisterFrameRecorder(asIScriptEngine* engine)
+{
+    RegisterObject<FrameRecorder>(engine, "FrameRecorder");
+    engine->RegisterObjectMethod("FrameRecorder", "bool StartRecording(const String&in)", asMETHOD(FrameRecorder, StartRecording), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "void StopRecording()", asMETHOD(FrameRecorder, StopRecording), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "bool StartReplay(const String&in, const String&in profileFileName = String())", asMETHOD(FrameRecorder, StartReplay), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "void StopReplay()", asMETHOD(FrameRecorder, StopReplay), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "void AddRecordedEvent(const String&in)", asFUNCTION(FrameRecorderAddRecordedEvent), asCALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("FrameRecorder", "void RemoveRecordedEvent(const String&in)", asFUNCTION(FrameRecorderRemoveRecordedEvent), asCALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("FrameRecorder", "bool get_recording() const", asMETHOD(FrameRecorder, IsRecording), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "bool get_replaying() const", asMETHOD(FrameRecorder, IsReplaying), asCALL_THISCALL);
+    engine->RegisterObjectMethod("FrameRecorder", "uint get_numFrames() const", asMETHOD(FrameRecorder, GetNumFrames), asCALL_THISCALL);
+    engine->RegisterGlobalFunction("FrameRecorder@+ get_frameRecorder()", asFUNCTION(GetFrameRecorder), asCALL_CDECL);
+}
+
 void RegisterEngineAPI(asIScriptEngine* engine)
 {
     RegisterConsole(engine);
     RegisterDebugHud(engine);
     RegisterEngine(engine);
+    RegisterFrameRecorder(engine);
 }
 
 }
@@ -1422,6 +1422,10 @@ static void RegisterRenderer(asIScriptEngine* engine)
     engine->RegisterObjectMethod("Renderer", "float get_mobileShadowBiasMul() const", asMETHOD(Renderer, GetMobileShadowBiasMul), asCALL_THISCALL);
     engine->RegisterObjectMethod("Renderer", "void set_mobileShadowBiasAdd(float)", asMETHOD(Renderer, SetMobileShadowBiasAdd), asCALL_THISCALL);
     engine->RegisterObjectMethod("Renderer", "float get_mobileShadowBiasAdd() const", asMETHOD(Renderer, GetMobileShadowBiasAdd), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Renderer", "void set_lightClustering(bool)", asMETHOD(Renderer, SetLightClustering), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Renderer", "bool get_lightClustering() const", asMETHOD(Renderer, GetLightClustering), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Renderer", "void set_shadowCasterCaching(bool)", asMETHOD(Renderer, SetShadowCasterCaching), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Renderer", "bool get_shadowCasterCaching() const", asMETHOD(Renderer, GetShadowCasterCaching), asCALL_THISCALL);
     engine->RegisterObjectMethod("Renderer", "uint get_numPrimitives() const", asMETHOD(Renderer, GetNumPrimitives), asCALL_THISCALL);
     engine->RegisterObjectMethod("Renderer", "uint get_numBatches() const", asMETHOD(Renderer, GetNumBatches), asCALL_THISCALL);
     engine->RegisterObjectMethod("Renderer", "uint get_numViews() const", asMETHOD(Renderer, GetNumViews), asCALL_THISCALL);
@@ -24,7 +24,9 @@
 #ifdef URHO3D_NETWORK
 #include "APITemplates.h"
 #include "Controls.h"
+#include "HttpClient.h"
 #include "HttpRequest.h"
+#include "MetricsServer.h"
 #include "Network.h"
 #include "NetworkPriority.h"
 #include "Protocol.h"
@@ -105,6 +107,11 @@ static void RegisterConnection(asIScriptEngine* engine)
     engine->RegisterObjectMethod("Connection", "bool get_sceneLoaded() const", asMETHOD(Connection, IsSceneLoaded), asCALL_THISCALL);
     engine->RegisterObjectMethod("Connection", "String get_address() const", asMETHOD(Connection, GetAddress), asCALL_THISCALL);
     engine->RegisterObjectMethod("Connection", "uint16 get_port() const", asMETHOD(Connection, GetPort), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Connection", "float get_roundTripTime() const", asMETHOD(Connection, GetRoundTripTime), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Connection", "float get_packetsInPerSec() const", asMETHOD(Connection, GetPacketsInPerSec), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Connection", "float get_packetsOutPerSec() const", asMETHOD(Connection, GetPacketsOutPerSec), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Connection", "float get_bytesInPerSec() const", asMETHOD(Connection, GetBytesInPerSec), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Connection", "float get_bytesOutPerSec() const", asMETHOD(Connection, GetBytesOutPerSec), asCALL_THISCALL);
     engine->RegisterObjectMethod("Connection", "uint get_numDownloads() const", asMETHOD(Connection, GetNumDownloads), asCALL_THISCALL);
     engine->RegisterObjectMethod("Connection", "const String& get_downloadName() const", asMETHOD(Connection, GetDownloadName), asCALL_THISCALL);
     engine->RegisterObjectMethod("Connection", "float get_downloadProgress() const", asMETHOD(Connection, GetDownloadProgress), asCALL_THISCALL);
@@ -135,6 +142,7 @@ static void RegisterHttpRequest(asIScriptEngine* engine)
     engine->RegisterObjectMethod("HttpRequest", "const String& get_verb() const", asMETHOD(HttpRequest, GetVerb), asCALL_THISCALL);
     engine->RegisterObjectMethod("HttpRequest", "String get_error() const", asMETHOD(HttpRequest, GetError), asCALL_THISCALL);
     engine->RegisterObjectMethod("HttpRequest", "HttpRequestState get_state() const", asMETHOD(HttpRequest, GetState), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpRequest", "int get_statusCode() const", asMETHOD(HttpRequest, GetStatusCode), asCALL_THISCALL);
     engine->RegisterObjectMethod("HttpRequest", "uint get_availableSize() const", asMETHOD(HttpRequest, GetAvailableSize), asCALL_THISCALL);
     engine->RegisterObjectMethod("HttpRequest", "bool get_open() const", asMETHOD(HttpRequest, IsOpen), asCALL_THISCALL);
 }
@@ -217,6 +225,58 @@ void RegisterNetwork(asIScriptEngine* engine)
     engine->RegisterGlobalFunction("Network@+ get_network()", asFUNCTION(GetNetwork), asCALL_CDECL);
 }
 
+static HttpRequest* HttpClientMakeRequest(const String& url, const String& verb, CScriptArray* headers, const String& postData, HttpClient* ptr)
+{
+    SharedPtr<HttpRequest> request = ptr->MakeRequest(url, verb, ArrayToVector<String>(headers), postData);
+    // The shared pointer will go out of scope, so have to increment the reference count
+    // (here an auto handle can not be used)
+    if (request)
+        request->AddRef();
+    return request.Get();
+}
+
+static HttpClient* GetHttpClient()
+{
+    return GetScriptContext()->GetSubsystem<HttpClient>();
+}
+
+static void RegisterHttpClient(asIScriptEngine* engine)
+{
+    RegisterObject<HttpClient>(engine, "HttpClient");
+    engine->RegisterObjectMethod("HttpClient", "HttpRequest@ MakeRequest(const String&in, const String&in verb = String(), Array<String>@+ headers = null, const String&in postData = String())", asFUNCTION(HttpClientMakeRequest), asCALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("HttpClient", "void set_maxWorkers(uint)", asMETHOD(HttpClient, SetMaxWorkers), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "uint get_maxWorkers() const", asMETHOD(HttpClient, GetMaxWorkers), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "void set_maxIdleConnections(uint)", asMETHOD(HttpClient, SetMaxIdleConnections), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "uint get_maxIdleConnections() const", asMETHOD(HttpClient, GetMaxIdleConnections), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "void set_keepAliveTimeout(uint)", asMETHOD(HttpClient, SetKeepAliveTimeout), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "uint get_keepAliveTimeout() const", asMETHOD(HttpClient, GetKeepAliveTimeout), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "uint get_numWorkers() const", asMETHOD(HttpClient, GetNumWorkers), asCALL_THISCALL);
+    engine->RegisterObjectMethod("HttpClient", "uint get_numPendingRequests() const", asMETHOD(HttpClient, GetNumPendingRequests), asCALL_THISCALL);
+    engine->RegisterGlobalFunction("HttpClient@+ get_httpClient()", asFUNCTION(GetHttpClient), asCALL_CDECL);
+}
+
+static MetricsServer* GetMetricsServer()
+{
+    return GetScriptContext()->GetSubsystem<MetricsServer>();
+}
+
+static void RegisterMetricsServer(asIScriptEngine* engine)
+{
+    RegisterObject<MetricsServer>(engine, "MetricsServer");
+    engine->RegisterObjectMethod("MetricsServer", "bool Start(uint16, bool localOnly = true)", asMETHOD(MetricsServer, Start), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "void Stop()", asMETHOD(MetricsServer, Stop), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "void AddScene(Scene@+)", asMETHOD(MetricsServer, AddScene), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "void RemoveScene(Scene@+)", asMETHOD(MetricsServer, RemoveScene), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "String GetMetricsText()", asMETHOD(MetricsServer, GetMetricsText), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "String GetSceneStatsJSON()", asMETHOD(MetricsServer, GetSceneStatsJSON), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "String GetResourceStatsJSON()", asMETHOD(MetricsServer, GetResourceStatsJSON), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "void set_snapshotInterval(float)", asMETHOD(MetricsServer, SetSnapshotInterval), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "float get_snapshotInterval() const", asMETHOD(MetricsServer, GetSnapshotInterval), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "bool get_running() const", asMETHOD(MetricsServer, IsRunning), asCALL_THISCALL);
+    engine->RegisterObjectMethod("MetricsServer", "uint16 get_port() const", asMETHOD(MetricsServer, GetPort), asCALL_THISCALL);
+    engine->RegisterGlobalFunction("MetricsServer@+ get_metricsServer()", asFUNCTION(GetMetricsServer), asCALL_CDECL);
+}
+
 void RegisterNetworkAPI(asIScriptEngine* engine)
 {
     RegisterControls(engine);
@@ -224,6 +284,8 @@ void RegisterNetworkAPI(asIScriptEngine* engine)
     RegisterConnection(engine);
     RegisterHttpRequest(engine);
     RegisterNetwork(engine);
+    RegisterHttpClient(engine);
+    RegisterMetricsServer(engine);
 }
 
 }
@@ -241,6 +241,9 @@ static void RegisterSplinePath(asIScriptEngine* engine)
     engine->RegisterObjectMethod("SplinePath", "void RemoveControlPoint(Node@+ point)", asMETHOD(SplinePath, RemoveControlPoint), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void ClearControlPoints()", asMETHOD(SplinePath, ClearControlPoints), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "Vector3 GetPoint(float) const", asMETHOD(SplinePath, GetPoint), asCALL_THISCALL);
+    engine->RegisterObjectMethod("SplinePath", "float GetFactorAtLength(float) const", asMETHOD(SplinePath, GetFactorAtLength), asCALL_THISCALL);
+    engine->RegisterObjectMethod("SplinePath", "float GetLengthAtFactor(float) const", asMETHOD(SplinePath, GetLengthAtFactor), asCALL_THISCALL);
+    engine->RegisterObjectMethod("SplinePath", "Vector3 GetPointAtLength(float) const", asMETHOD(SplinePath, GetPointAtLength), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void set_interpolationMode(InterpolationMode)", asMETHOD(SplinePath, SetInterpolationMode), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void set_speed(float)", asMETHOD(SplinePath, SetSpeed), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void set_position(float)", asMETHOD(SplinePath, SetPosition), asCALL_THISCALL);
@@ -248,6 +251,7 @@ static void RegisterSplinePath(asIScriptEngine* engine)
     engine->RegisterObjectMethod("SplinePath", "InterpolationMode get_interpolationMode() const", asMETHOD(SplinePath, GetInterpolationMode), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "float get_speed() const", asMETHOD(SplinePath, GetSpeed), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "Vector3 get_position() const", asMETHOD(SplinePath, GetPosition), asCALL_THISCALL);
+    engine->RegisterObjectMethod("SplinePath", "float get_length() const", asMETHOD(SplinePath, GetLength), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "Node@ get_controlledNode() const", asMETHOD(SplinePath, GetControlledNode), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void Move(float)", asMETHOD(SplinePath, Move), asCALL_THISCALL);
     engine->RegisterObjectMethod("SplinePath", "void Reset()", asMETHOD(SplinePath, Reset), asCALL_THISCALL);
@@ -290,6 +294,12 @@ static void RegisterScene(asIScriptEngine* engine)
     engine->RegisterObjectMethod("Scene", "void UnregisterAllVars(const String&in)", asMETHOD(Scene, UnregisterAllVars), asCALL_THISCALL);
     engine->RegisterObjectMethod("Scene", "Component@+ GetComponent(uint)", asMETHODPR(Scene, GetComponent, (unsigned) const, Component*), asCALL_THISCALL);
     engine->RegisterObjectMethod("Scene", "Node@+ GetNode(uint)", asMETHOD(Scene, GetNode), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint GetNodeGeneration(uint) const", asMETHOD(Scene, GetNodeGeneration), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint GetComponentGeneration(uint) const", asMETHOD(Scene, GetComponentGeneration), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint get_numReplicatedNodes() const", asMETHOD(Scene, GetNumReplicatedNodes), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint get_numLocalNodes() const", asMETHOD(Scene, GetNumLocalNodes), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint get_numReplicatedComponents() const", asMETHOD(Scene, GetNumReplicatedComponents), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Scene", "uint get_numLocalComponents() const", asMETHOD(Scene, GetNumLocalComponents), asCALL_THISCALL);
     engine->RegisterObjectMethod("Scene", "const String& GetVarName(StringHash) const", asMETHOD(Scene, GetVarName), asCALL_THISCALL);
     engine->RegisterObjectMethod("Scene", "void Update(float)", asMETHOD(Scene, Update), asCALL_THISCALL);
     engine->RegisterObjectMethod("Scene", "void set_updateEnabled(bool)", asMETHOD(Scene, SetUpdateEnabled), asCALL_THISCALL);
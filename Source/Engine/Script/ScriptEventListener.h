@@ -36,8 +36,6 @@ struct DelayedCall
 {
     /// Period for repeating calls.
     float period_;
-    /// Delay time remaining until execution.
-    float delay_;
     /// Repeat flag.
     bool repeat_;
     /// Function declaration.
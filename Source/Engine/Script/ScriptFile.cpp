@@ -350,12 +350,11 @@ bool ScriptFile::Execute(asIScriptObject* object, asIScriptFunction* method, con
 
 void ScriptFile::DelayedExecute(float delay, bool repeat, const String& declaration, const VariantVector& parameters)
 {
-    DelayedCall call;
-    call.period_ = call.delay_ = Max(delay, 0.0f);
+    DelayedCall& call = delayedCalls_[delayedCallTimers_.AddTimer(delay, repeat)];
+    call.period_ = Max(delay, 0.0f);
     call.repeat_ = repeat;
     call.declaration_ = declaration;
     call.parameters_ = parameters;
-    delayedCalls_.Push(call);
     
     // Make sure we are registered to the application update event, because delayed calls are executed there
     if (!subscribed_)
@@ -368,13 +367,19 @@ void ScriptFile::DelayedExecute(float delay, bool repeat, const String& declarat
 void ScriptFile::ClearDelayedExecute(const String& declaration)
 {
     if (declaration.Empty())
+    {
         delayedCalls_.Clear();
+        delayedCallTimers_.RemoveAllTimers();
+    }
     else
     {
-        for (Vector<DelayedCall>::Iterator i = delayedCalls_.Begin(); i != delayedCalls_.End();)
+        for (HashMap<unsigned, DelayedCall>::Iterator i = delayedCalls_.Begin(); i != delayedCalls_.End();)
         {
-            if (declaration == i->declaration_)
+            if (declaration == i->second_.declaration_)
+            {
+                delayedCallTimers_.RemoveTimer(i->first_);
                 i = delayedCalls_.Erase(i);
+            }
             else
                 ++i;
         }
@@ -747,6 +752,7 @@ void ScriptFile::ReleaseModule()
         functions_.Clear();
         methods_.Clear();
         delayedCalls_.Clear();
+        delayedCallTimers_.RemoveAllTimers();
         eventInvokers_.Clear();
         
         asIScriptEngine* engine = script_->GetScriptEngine();
@@ -778,27 +784,20 @@ void ScriptFile::HandleUpdate(StringHash eventType, VariantMap& eventData)
     
     float timeStep = eventData[P_TIMESTEP].GetFloat();
     
-    // Execute delayed calls
-    for (unsigned i = 0; i < delayedCalls_.Size();)
+    // Execute delayed calls whose timers fired
+    delayedCallTimers_.Advance(timeStep, firedDelayedCalls_);
+    for (unsigned i = 0; i < firedDelayedCalls_.Size(); ++i)
     {
-        DelayedCall& call = delayedCalls_[i];
-        bool remove = false;
-        
-        call.delay_ -= timeStep;
-        if (call.delay_ <= 0.0f)
-        {
-            if (!call.repeat_)
-                remove = true;
-            else
-                call.delay_ += call.period_;
-            
-            Execute(call.declaration_, call.parameters_);
-        }
+        // The call may have been cleared by an earlier call on the same frame
+        unsigned handle = firedDelayedCalls_[i];
+        HashMap<unsigned, DelayedCall>::Iterator call = delayedCalls_.Find(handle);
+        if (call == delayedCalls_.End())
+            continue;
         
-        if (remove)
-            delayedCalls_.Erase(i);
-        else
-            ++i;
+        bool repeat = call->second_.repeat_;
+        Execute(call->second_.declaration_, call->second_.parameters_);
+        if (!repeat)
+            delayedCalls_.Erase(handle);
     }
 }
 
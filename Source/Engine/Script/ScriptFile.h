@@ -26,6 +26,7 @@
 #include "HashSet.h"
 #include "Resource.h"
 #include "ScriptEventListener.h"
+#include "TimerWheel.h"
 
 class asIObjectType;
 class asIScriptContext;
@@ -131,8 +132,12 @@ private:
     HashMap<String, asIScriptFunction*> functions_;
     /// Search cache for methods.
     HashMap<asIObjectType*, HashMap<String, asIScriptFunction*> > methods_;
-    /// Delayed function calls.
-    Vector<DelayedCall> delayedCalls_;
+    /// Delayed function calls by timer handle.
+    HashMap<unsigned, DelayedCall> delayedCalls_;
+    /// Timers for delayed function calls.
+    TimerWheel delayedCallTimers_;
+    /// Timer handles of the delayed function calls to execute on the current frame.
+    PODVector<unsigned> firedDelayedCalls_;
     /// Event helper objects for handling procedural or non-ScriptInstance script events
     HashMap<asIScriptObject*, SharedPtr<ScriptEventInvoker> > eventInvokers_;
     /// Byte code for asynchronous loading.
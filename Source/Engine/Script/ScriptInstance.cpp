@@ -252,12 +252,11 @@ void ScriptInstance::DelayedExecute(float delay, bool repeat, const String& decl
     if (!scriptObject_)
         return;
 
-    DelayedCall call;
-    call.period_ = call.delay_ = Max(delay, 0.0f);
+    DelayedCall& call = delayedCalls_[delayedCallTimers_.AddTimer(delay, repeat)];
+    call.period_ = Max(delay, 0.0f);
     call.repeat_ = repeat;
     call.declaration_ = declaration;
     call.parameters_ = parameters;
-    delayedCalls_.Push(call);
 
     // Make sure we are registered to the scene update event, because delayed calls are executed there
     if (!subscribed_)
@@ -267,13 +266,19 @@ void ScriptInstance::DelayedExecute(float delay, bool repeat, const String& decl
 void ScriptInstance::ClearDelayedExecute(const String& declaration)
 {
     if (declaration.Empty())
+    {
         delayedCalls_.Clear();
+        delayedCallTimers_.RemoveAllTimers();
+    }
     else
     {
-        for (Vector<DelayedCall>::Iterator i = delayedCalls_.Begin(); i != delayedCalls_.End();)
+        for (HashMap<unsigned, DelayedCall>::Iterator i = delayedCalls_.Begin(); i != delayedCalls_.End();)
         {
-            if (declaration == i->declaration_)
+            if (declaration == i->second_.declaration_)
+            {
+                delayedCallTimers_.RemoveTimer(i->first_);
                 i = delayedCalls_.Erase(i);
+            }
             else
                 ++i;
         }
@@ -362,14 +367,19 @@ void ScriptInstance::SetScriptFileAttr(ResourceRef value)
 void ScriptInstance::SetDelayedCallsAttr(PODVector<unsigned char> value)
 {
     MemoryBuffer buf(value);
-    delayedCalls_.Resize(buf.ReadVLE());
-    for (Vector<DelayedCall>::Iterator i = delayedCalls_.Begin(); i != delayedCalls_.End(); ++i)
+    delayedCalls_.Clear();
+    delayedCallTimers_.RemoveAllTimers();
+    unsigned numCalls = buf.ReadVLE();
+    for (unsigned i = 0; i < numCalls; ++i)
     {
-        i->period_ = buf.ReadFloat();
-        i->delay_ = buf.ReadFloat();
-        i->repeat_ = buf.ReadBool();
-        i->declaration_ = buf.ReadString();
-        i->parameters_ = buf.ReadVariantVector();
+        float period = buf.ReadFloat();
+        float delay = buf.ReadFloat();
+        bool repeat = buf.ReadBool();
+        DelayedCall& call = delayedCalls_[delayedCallTimers_.AddTimer(delay, period, repeat)];
+        call.period_ = period;
+        call.repeat_ = repeat;
+        call.declaration_ = buf.ReadString();
+        call.parameters_ = buf.ReadVariantVector();
     }
 
     if (scriptObject_ && delayedCalls_.Size() && !subscribed_)
@@ -407,13 +417,13 @@ PODVector<unsigned char> ScriptInstance::GetDelayedCallsAttr() const
 {
     VectorBuffer buf;
     buf.WriteVLE(delayedCalls_.Size());
-    for (Vector<DelayedCall>::ConstIterator i = delayedCalls_.Begin(); i != delayedCalls_.End(); ++i)
+    for (HashMap<unsigned, DelayedCall>::ConstIterator i = delayedCalls_.Begin(); i != delayedCalls_.End(); ++i)
     {
-        buf.WriteFloat(i->period_);
-        buf.WriteFloat(i->delay_);
-        buf.WriteBool(i->repeat_);
-        buf.WriteString(i->declaration_);
-        buf.WriteVariantVector(i->parameters_);
+        buf.WriteFloat(i->second_.period_);
+        buf.WriteFloat(delayedCallTimers_.GetRemainingTime(i->first_));
+        buf.WriteBool(i->second_.repeat_);
+        buf.WriteString(i->second_.declaration_);
+        buf.WriteVariantVector(i->second_.parameters_);
     }
     return buf.GetBuffer();
 }
@@ -515,6 +525,7 @@ void ScriptInstance::ClearScriptMethods()
         methods_[i] = 0;
 
     delayedCalls_.Clear();
+    delayedCallTimers_.RemoveAllTimers();
 }
 
 void ScriptInstance::ClearScriptAttributes()
@@ -694,27 +705,20 @@ void ScriptInstance::HandleSceneUpdate(StringHash eventType, VariantMap& eventDa
 
     float timeStep = eventData[P_TIMESTEP].GetFloat();
 
-    // Execute delayed calls
-    for (unsigned i = 0; i < delayedCalls_.Size();)
+    // Execute delayed calls whose timers fired
+    delayedCallTimers_.Advance(timeStep, firedDelayedCalls_);
+    for (unsigned i = 0; i < firedDelayedCalls_.Size(); ++i)
     {
-        DelayedCall& call = delayedCalls_[i];
-        bool remove = false;
-
-        call.delay_ -= timeStep;
-        if (call.delay_ <= 0.0f)
-        {
-            if (!call.repeat_)
-                remove = true;
-            else
-                call.delay_ += call.period_;
-
-            Execute(call.declaration_, call.parameters_);
-        }
+        // The call may have been cleared by an earlier call on the same frame
+        unsigned handle = firedDelayedCalls_[i];
+        HashMap<unsigned, DelayedCall>::Iterator call = delayedCalls_.Find(handle);
+        if (call == delayedCalls_.End())
+            continue;
 
-        if (remove)
-            delayedCalls_.Erase(i);
-        else
-            ++i;
+        bool repeat = call->second_.repeat_;
+        Execute(call->second_.declaration_, call->second_.parameters_);
+        if (!repeat)
+            delayedCalls_.Erase(handle);
     }
 
     // Execute delayed start before first update
@@ -24,6 +24,7 @@
 
 #include "Component.h"
 #include "ScriptEventListener.h"
+#include "TimerWheel.h"
 
 class asIScriptFunction;
 class asIScriptObject;
@@ -181,8 +182,12 @@ private:
     String className_;
     /// Pointers to supported inbuilt methods.
     asIScriptFunction* methods_[MAX_SCRIPT_METHODS];
-    /// Delayed method calls.
-    Vector<DelayedCall> delayedCalls_;
+    /// Delayed method calls by timer handle.
+    HashMap<unsigned, DelayedCall> delayedCalls_;
+    /// Timers for delayed method calls.
+    TimerWheel delayedCallTimers_;
+    /// Timer handles of the delayed method calls to execute on the current frame.
+    PODVector<unsigned> firedDelayedCalls_;
     /// Attributes, including script object variables.
     Vector<AttributeInfo> attributeInfos_;
     /// Storage for unapplied node and component ID attributes
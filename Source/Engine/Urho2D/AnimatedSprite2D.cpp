@@ -384,19 +384,7 @@ void AnimatedSprite2D::UpdateAnimation(float timeStep)
     if (!animation_)
         return;
 
-    currentTime_ += timeStep * speed_;
-
-    float time;
-    float animtationLength = animation_->GetLength();
-
-    if (looped_)
-    {
-        time = fmodf(currentTime_, animtationLength);
-        if (time < 0.0f)
-            time += animation_->GetLength();
-    }
-    else
-        time = Clamp(currentTime_, 0.0f, animtationLength);
+    float time = AdvanceAnimationTime(timeStep);
 
     // Update timeline's local transform
     for (unsigned i = 0; i < timelineTransformInfos_.Size(); ++i)
@@ -538,7 +526,33 @@ void AnimatedSprite2D::HandleScenePostUpdate(StringHash eventType, VariantMap& e
 {
     using namespace ScenePostUpdate;
     float timeStep = eventData[P_TIMESTEP].GetFloat();
-    UpdateAnimation(timeStep);
+
+    // Sprite animation only affects the rendered geometry, so in the dedicated server profile just advance the time
+    if (GetSkipPresentationUpdates())
+    {
+        if (animation_)
+            AdvanceAnimationTime(timeStep);
+    }
+    else
+        UpdateAnimation(timeStep);
+}
+
+float AnimatedSprite2D::AdvanceAnimationTime(float timeStep)
+{
+    currentTime_ += timeStep * speed_;
+
+    // Keep the stored time within the animation, so that it does not lose precision over a long run time
+    float animationLength = animation_->GetLength();
+    if (looped_)
+    {
+        currentTime_ = animationLength > 0.0f ? fmodf(currentTime_, animationLength) : 0.0f;
+        if (currentTime_ < 0.0f)
+            currentTime_ += animationLength;
+    }
+    else
+        currentTime_ = Clamp(currentTime_, 0.0f, animationLength);
+
+    return currentTime_;
 }
 
 }
@@ -121,6 +121,8 @@ protected:
     void SetAnimation(Animation2D* animation, LoopMode2D loopMode);
     /// Update animation.
     void UpdateAnimation(float timeStep);
+    /// Advance the animation time, wrapping it if looped or clamping it to the animation length if not. Return the new time.
+    float AdvanceAnimationTime(float timeStep);
     /// Calculate timeline world world transform.
     void CalculateTimelineWorldTransform(unsigned index);
     /// Handle scene post update.
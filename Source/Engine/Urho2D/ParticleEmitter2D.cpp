@@ -247,6 +247,10 @@ void ParticleEmitter2D::UpdateVertices()
 
 void ParticleEmitter2D::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
 {
+    // Particles are never seen in the dedicated server profile
+    if (GetSkipPresentationUpdates())
+        return;
+
     MarkForUpdate();
 }
 
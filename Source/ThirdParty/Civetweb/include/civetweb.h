@@ -407,6 +407,17 @@ struct mg_connection *mg_download(const char *host, int port, int use_ssl,
                                   ...) PRINTF_ARGS(6, 7);
 
 
+// Urho3D: added for HTTP keep-alive
+// Send another request on a connection opened by mg_download() and read the
+// response headers. The previous response must have been read completely.
+// Return:
+//   On success, 1. On error, 0. error_buffer contains error message.
+int mg_download_next(struct mg_connection *conn,
+                     char *error_buffer, size_t error_buffer_size,
+                     PRINTF_FORMAT_STRING(const char *request_fmt),
+                     ...) PRINTF_ARGS(4, 5);
+
+
 // Close the connection opened by mg_download().
 void mg_close_connection(struct mg_connection *conn);
 
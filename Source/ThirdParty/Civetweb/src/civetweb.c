@@ -5474,6 +5474,32 @@ struct mg_connection *mg_download(const char *host, int port, int use_ssl,
     return conn;
 }
 
+// Urho3D: added for HTTP keep-alive
+int mg_download_next(struct mg_connection *conn, char *ebuf, size_t ebuf_len,
+                     const char *fmt, ...)
+{
+    va_list ap;
+    int discard_len;
+
+    // Discard the previous response, keeping any data received after it
+    discard_len = conn->content_len >= 0 && conn->request_len > 0 &&
+                  conn->request_len + conn->content_len < (int64_t) conn->data_len ?
+                  (int) (conn->request_len + conn->content_len) : conn->data_len;
+    memmove(conn->buf, conn->buf + discard_len, conn->data_len - discard_len);
+    conn->data_len -= discard_len;
+
+    va_start(ap, fmt);
+    ebuf[0] = '\0';
+    if (mg_vprintf(conn, fmt, ap) <= 0) {
+        snprintf(ebuf, ebuf_len, "%s", "Error sending request");
+    } else {
+        getreq(conn, ebuf, ebuf_len);
+    }
+    va_end(ap);
+
+    return ebuf[0] == '\0';
+}
+
 static void process_new_connection(struct mg_connection *conn)
 {
     struct mg_request_info *ri = &conn->request_info;
@@ -0,0 +1,309 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "Context.h"
+#include "Engine.h"
+#include "File.h"
+#include "Geometry.h"
+#include "IndexBuffer.h"
+#include "JSONFile.h"
+#include "ProcessUtils.h"
+#include "Random.h"
+#include "Revision.h"
+#include "Sort.h"
+#include "StringUtils.h"
+#include "Timer.h"
+#include "VectorBuffer.h"
+#include "VertexBuffer.h"
+#include "WorkQueue.h"
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "DebugNew.h"
+
+volatile unsigned benchmarkSink = 0;
+
+int main(int argc, char** argv);
+void Run(const Vector<String>& arguments);
+
+int main(int argc, char** argv)
+{
+    Vector<String> arguments;
+    
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+    
+    Run(arguments);
+    return 0;
+}
+
+void Run(const Vector<String>& arguments)
+{
+    String filter;
+    String outputFileName;
+    unsigned numSamples = 5;
+    float scale = 1.0f;
+    bool listOnly = false;
+    
+    for (unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        if (arguments[i].Length() < 2 || arguments[i][0] != '-')
+            continue;
+        
+        String argument = arguments[i].Substring(1).ToLower();
+        String value = i + 1 < arguments.Size() ? arguments[i + 1] : String::EMPTY;
+        
+        if (argument == "filter" && !value.Empty())
+        {
+            filter = value;
+            ++i;
+        }
+        else if (argument == "output" && !value.Empty())
+        {
+            outputFileName = value;
+            ++i;
+        }
+        else if (argument == "samples" && !value.Empty())
+        {
+            numSamples = Max((int)ToUInt(value), 1);
+            ++i;
+        }
+        else if (argument == "scale" && !value.Empty())
+        {
+            scale = Max(ToFloat(value), 0.0f);
+            ++i;
+        }
+        else if (argument == "list")
+            listOnly = true;
+        else if (argument == "h" || argument == "help")
+        {
+            ErrorExit("Usage: Benchmarks [options] [engine startup options]\n\n"
+                "Options:\n"
+                "-filter <text>   Run only the benchmarks whose name contains the text\n"
+                "-output <file>   Write the results to a JSON file instead of the standard output\n"
+                "-samples <n>     Number of timed samples per benchmark, default 5\n"
+                "-scale <x>       Multiply the iteration counts, for example 0.01 for a quick test run\n"
+                "-list            List the benchmark names and exit\n\n"
+                "Engine startup options such as -serverprofile are passed to the engine, which is always headless.",
+                EXIT_SUCCESS);
+        }
+    }
+    
+    SharedPtr<Context> context(new Context());
+    SharedPtr<Engine> engine(new Engine(context));
+    
+    // Keep the log out of the standard output, which receives the results
+    VariantMap engineParameters = Engine::ParseParameters(arguments);
+    engineParameters["Headless"] = true;
+    engineParameters["LogName"] = String::EMPTY;
+    engineParameters["LogQuiet"] = true;
+    if (!engine->Initialize(engineParameters))
+        ErrorExit("Could not initialize the engine");
+    
+    Vector<SharedPtr<Benchmark> > benchmarks;
+    RegisterCoreBenchmarks(context, benchmarks);
+    RegisterSceneBenchmarks(context, benchmarks);
+    RegisterGraphicsBenchmarks(context, benchmarks);
+    #ifdef URHO3D_PHYSICS
+    RegisterPhysicsBenchmarks(context, benchmarks);
+    #endif
+    #ifdef URHO3D_NAVIGATION
+    RegisterNavigationBenchmarks(context, benchmarks);
+    #endif
+    #ifdef URHO3D_NETWORK
+    RegisterNetworkBenchmarks(context, benchmarks);
+    #endif
+    
+    SharedPtr<JSONFile> results(new JSONFile(context));
+    JSONValue root = results->CreateRoot();
+    root.SetString("revision", GetRevision());
+    root.SetString("platform", GetPlatform());
+    root.SetInt("physicalCPUs", GetNumPhysicalCPUs());
+    root.SetInt("workerThreads", context->GetSubsystem<WorkQueue>()->GetNumThreads());
+    root.SetInt("samples", numSamples);
+    root.SetFloat("scale", scale);
+    
+    // Record the build options and engine modes which affect the results
+    JSONValue options = root.CreateChild("options");
+    options.SetBool("serverProfile", engine->IsServerProfile());
+    #ifdef URHO3D_CXX11
+    options.SetBool("cxx11", true);
+    #else
+    options.SetBool("cxx11", false);
+    #endif
+    #ifdef URHO3D_ATOMIC_REFCOUNT
+    options.SetBool("atomicRefCount", true);
+    #else
+    options.SetBool("atomicRefCount", false);
+    #endif
+    #ifdef URHO3D_HASH_DEBUG
+    options.SetBool("hashDebug", true);
+    #else
+    options.SetBool("hashDebug", false);
+    #endif
+    #ifdef URHO3D_PROFILING
+    options.SetBool("profiling", true);
+    #else
+    options.SetBool("profiling", false);
+    #endif
+    
+    JSONValue resultArray = root.CreateChild("benchmarks", JSON_ARRAY);
+    HiresTimer timer;
+    
+    for (unsigned i = 0; i < benchmarks.Size(); ++i)
+    {
+        Benchmark* benchmark = benchmarks[i];
+        const String& name = benchmark->GetName();
+        if (!filter.Empty() && !name.Contains(filter, false))
+            continue;
+        if (listOnly)
+        {
+            PrintLine(name);
+            continue;
+        }
+        
+        // Seed the random number generator the same way for each benchmark so that the generated data is repeatable
+        SetRandomSeed(1);
+        if (!benchmark->Setup())
+        {
+            PrintLine("Skipped " + name, true);
+            continue;
+        }
+        
+        unsigned iterations = Max((int)(benchmark->GetIterations() * scale + 0.5f), 1);
+        // Run once untimed to warm up caches and lazily built data
+        benchmark->Run(iterations);
+        
+        PODVector<float> sampleTimes;
+        for (unsigned j = 0; j < numSamples; ++j)
+        {
+            timer.Reset();
+            benchmark->Run(iterations);
+            sampleTimes.Push(timer.GetUSec(false) / 1000.0f);
+        }
+        benchmark->TearDown();
+        Sort(sampleTimes.Begin(), sampleTimes.End());
+        
+        float median = sampleTimes[sampleTimes.Size() / 2];
+        JSONValue result = resultArray.CreateChild();
+        result.SetString("name", name);
+        result.SetInt("iterations", iterations);
+        result.SetFloat("minMs", sampleTimes.Front());
+        result.SetFloat("medianMs", median);
+        result.SetFloat("maxMs", sampleTimes.Back());
+        result.SetFloat("nsPerIteration", median * 1000000.0f / iterations);
+        
+        const HashMap<String, float>& counters = benchmark->GetCounters();
+        if (!counters.Empty())
+        {
+            JSONValue counterValues = result.CreateChild("counters");
+            for (HashMap<String, float>::ConstIterator j = counters.Begin(); j != counters.End(); ++j)
+                counterValues.SetFloat(j->first_, j->second_);
+        }
+        
+        PrintLine(name + ": " + String(median) + " ms", true);
+    }
+    
+    if (listOnly)
+        return;
+    
+    if (!outputFileName.Empty())
+    {
+        File outputFile(context, outputFileName, FILE_WRITE);
+        if (!outputFile.IsOpen())
+            ErrorExit("Could not open output file " + outputFileName);
+        results->Save(outputFile);
+    }
+    else
+    {
+        VectorBuffer buffer;
+        results->Save(buffer);
+        PrintLine(String((const char*)buffer.GetData(), buffer.GetSize()));
+    }
+}
+
+SharedPtr<Model> CreateGridModel(Context* context, unsigned size)
+{
+    unsigned numVertices = (size + 1) * (size + 1);
+    unsigned numIndices = size * size * 6;
+    float halfSize = 0.5f * size;
+    
+    PODVector<float> vertexData;
+    vertexData.Reserve(numVertices * 6);
+    for (unsigned z = 0; z <= size; ++z)
+    {
+        for (unsigned x = 0; x <= size; ++x)
+        {
+            vertexData.Push(x - halfSize);
+            vertexData.Push(0.0f);
+            vertexData.Push(z - halfSize);
+            vertexData.Push(0.0f);
+            vertexData.Push(1.0f);
+            vertexData.Push(0.0f);
+        }
+    }
+    
+    // Wind the triangles to face upward
+    PODVector<unsigned> indexData;
+    indexData.Reserve(numIndices);
+    for (unsigned z = 0; z < size; ++z)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            unsigned corner = z * (size + 1) + x;
+            indexData.Push(corner);
+            indexData.Push(corner + size + 1);
+            indexData.Push(corner + 1);
+            indexData.Push(corner + 1);
+            indexData.Push(corner + size + 1);
+            indexData.Push(corner + size + 2);
+        }
+    }
+    
+    SharedPtr<VertexBuffer> vertexBuffer(new VertexBuffer(context));
+    vertexBuffer->SetShadowed(true);
+    vertexBuffer->SetSize(numVertices, MASK_POSITION | MASK_NORMAL);
+    vertexBuffer->SetData(&vertexData[0]);
+    
+    SharedPtr<IndexBuffer> indexBuffer(new IndexBuffer(context));
+    indexBuffer->SetShadowed(true);
+    indexBuffer->SetSize(numIndices, true);
+    indexBuffer->SetData(&indexData[0]);
+    
+    SharedPtr<Geometry> geometry(new Geometry(context));
+    geometry->SetVertexBuffer(0, vertexBuffer);
+    geometry->SetIndexBuffer(indexBuffer);
+    geometry->SetDrawRange(TRIANGLE_LIST, 0, numIndices);
+    
+    SharedPtr<Model> model(new Model(context));
+    model->SetNumGeometries(1);
+    model->SetGeometry(0, 0, geometry);
+    model->SetBoundingBox(BoundingBox(Vector3(-halfSize, 0.0f, -halfSize), Vector3(halfSize, 0.0f, halfSize)));
+    
+    return model;
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "HashMap.h"
+#include "Model.h"
+
+using namespace Urho3D;
+
+/// Sink for benchmark results, to keep the compiler from optimizing the measured work away.
+extern volatile unsigned benchmarkSink;
+
+/// Headless benchmark. Setup and teardown are not timed, Run() executes the measured operation for a given number of iterations.
+class Benchmark : public RefCounted
+{
+public:
+    /// Construct with name and number of iterations per sample.
+    Benchmark(Context* context, const String& name, unsigned iterations) :
+        context_(context),
+        name_(name),
+        iterations_(iterations)
+    {
+    }
+    
+    /// Destruct.
+    virtual ~Benchmark()
+    {
+    }
+    
+    /// Prepare the data to operate on. Return false to skip the benchmark, for example if required resources are missing.
+    virtual bool Setup() { return true; }
+    /// Run the measured operation for the given number of iterations.
+    virtual void Run(unsigned iterations) = 0;
+    /// Release the data.
+    virtual void TearDown() {}
+    
+    /// Return name.
+    const String& GetName() const { return name_; }
+    /// Return number of iterations per sample.
+    unsigned GetIterations() const { return iterations_; }
+    /// Return additional result values to output along with the timings.
+    const HashMap<String, float>& GetCounters() const { return counters_; }
+    
+protected:
+    /// Set an additional result value.
+    void SetCounter(const String& name, float value) { counters_[name] = value; }
+    
+    /// Execution context.
+    Context* context_;
+    /// Name.
+    String name_;
+    /// Number of iterations per sample.
+    unsigned iterations_;
+    /// Additional result values.
+    HashMap<String, float> counters_;
+};
+
+/// Create a flat grid model of size x size quads centered on the origin, with one unit per quad. The vertex and index data are shadowed for raycasts and navigation.
+SharedPtr<Model> CreateGridModel(Context* context, unsigned size);
+
+/// Add the container, hash, variant, event and core utility benchmarks.
+void RegisterCoreBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+/// Add the scene update, node creation and serialization benchmarks.
+void RegisterSceneBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+/// Add the octree, raycast, animation and light assignment benchmarks.
+void RegisterGraphicsBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+#ifdef URHO3D_PHYSICS
+/// Add the physics benchmarks.
+void RegisterPhysicsBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+#endif
+#ifdef URHO3D_NAVIGATION
+/// Add the navigation benchmarks.
+void RegisterNavigationBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+#endif
+#ifdef URHO3D_NETWORK
+/// Add the network serialization and HTTP client benchmarks.
+void RegisterNetworkBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest);
+#endif
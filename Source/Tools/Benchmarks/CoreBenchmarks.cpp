@@ -0,0 +1,848 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "ContentHash.h"
+#include "Context.h"
+#include "Mutex.h"
+#include "ParallelSort.h"
+#include "Random.h"
+#include "Sort.h"
+#include "Thread.h"
+#include "TimerWheel.h"
+#include "WorkQueue.h"
+
+#include "DebugNew.h"
+
+STRINGHASH_CONSTANT(BENCHMARK_HASH, "BenchmarkConstantHash");
+
+EVENT(E_BENCHMARKEVENT, BenchmarkEvent)
+{
+    PARAM(P_VALUE, Value);                  // int
+    PARAM(P_POSITION, Position);            // Vector3
+}
+
+/// Names hashed by the runtime StringHash benchmark.
+static const char* hashNames[] = {
+    "Position",
+    "Rotation",
+    "ServerProfileUpdate",
+    "NodeReplicationState",
+    "ShadowMapFilterBlur",
+    "PostRenderUpdate",
+    "LightClusterAssignment",
+    "Cameras"
+};
+
+/// Names of the sort benchmark input orders.
+static const char* sortInputNames[] = {
+    "Random",
+    "Sorted",
+    "Reverse",
+    "NearlySorted"
+};
+
+/// PODVector growth by pushing values into a new vector.
+class PODVectorPushBenchmark : public Benchmark
+{
+public:
+    PODVectorPushBenchmark(Context* context) :
+        Benchmark(context, "Container/PODVectorPush1k", 20000)
+    {
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            PODVector<int> values;
+            for (int j = 0; j < 1000; ++j)
+                values.Push(j);
+            benchmarkSink += values.Back();
+        }
+    }
+};
+
+/// Vector growth by pushing strings into a new vector.
+class VectorPushStringBenchmark : public Benchmark
+{
+public:
+    VectorPushStringBenchmark(Context* context) :
+        Benchmark(context, "Container/VectorPushString1k", 2000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        value_ = "Benchmark string";
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            Vector<String> values;
+            for (unsigned j = 0; j < 1000; ++j)
+                values.Push(value_);
+            benchmarkSink += values.Size();
+        }
+    }
+    
+private:
+    /// String to push.
+    String value_;
+};
+
+/// HashMap insertion of random keys into a new map.
+class HashMapInsertBenchmark : public Benchmark
+{
+public:
+    HashMapInsertBenchmark(Context* context) :
+        Benchmark(context, "Container/HashMapInsert1k", 2000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        keys_.Resize(1000);
+        for (unsigned i = 0; i < keys_.Size(); ++i)
+            keys_[i] = (Rand() << 15) | Rand();
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            HashMap<int, int> map;
+            for (unsigned j = 0; j < keys_.Size(); ++j)
+                map[keys_[j]] = j;
+            benchmarkSink += map.Size();
+        }
+    }
+    
+private:
+    /// Keys to insert.
+    PODVector<int> keys_;
+};
+
+/// HashMap lookup of existing keys.
+class HashMapFindBenchmark : public Benchmark
+{
+public:
+    HashMapFindBenchmark(Context* context) :
+        Benchmark(context, "Container/HashMapFind", 2000000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        keys_.Resize(10000);
+        for (unsigned i = 0; i < keys_.Size(); ++i)
+        {
+            keys_[i] = (Rand() << 15) | Rand();
+            map_[keys_[i]] = i;
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numKeys = keys_.Size();
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            HashMap<int, int>::ConstIterator j = map_.Find(keys_[i % numKeys]);
+            benchmarkSink += j->second_;
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        map_.Clear();
+    }
+    
+private:
+    /// Keys to find.
+    PODVector<int> keys_;
+    /// Map to search.
+    HashMap<int, int> map_;
+};
+
+/// String concatenation.
+class StringAppendBenchmark : public Benchmark
+{
+public:
+    StringAppendBenchmark(Context* context) :
+        Benchmark(context, "Container/StringAppend100", 20000)
+    {
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            String str;
+            for (unsigned j = 0; j < 100; ++j)
+            {
+                str += "Node";
+                str += String(j);
+            }
+            benchmarkSink += str.Length();
+        }
+    }
+};
+
+/// Sort benchmark input order.
+enum SortInput
+{
+    SORTINPUT_RANDOM = 0,
+    SORTINPUT_SORTED,
+    SORTINPUT_REVERSE,
+    SORTINPUT_NEARLYSORTED
+};
+
+/// Sort benchmark algorithm.
+enum SortMethod
+{
+    SORTMETHOD_SORT = 0,
+    SORTMETHOD_STABLESORT,
+    SORTMETHOD_PARALLELSORT
+};
+
+/// Sorting integers in random, sorted, reverse or nearly sorted order.
+class SortBenchmark : public Benchmark
+{
+public:
+    SortBenchmark(Context* context, const String& name, unsigned size, SortInput input, SortMethod method, unsigned iterations) :
+        Benchmark(context, name, iterations),
+        size_(size),
+        input_(input),
+        method_(method)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        source_.Resize(size_);
+        for (unsigned i = 0; i < size_; ++i)
+        {
+            switch (input_)
+            {
+            case SORTINPUT_RANDOM:
+                source_[i] = Rand();
+                break;
+                
+            case SORTINPUT_REVERSE:
+                source_[i] = size_ - i;
+                break;
+                
+            default:
+                source_[i] = i;
+                break;
+            }
+        }
+        // Displace one percent of the values
+        if (input_ == SORTINPUT_NEARLYSORTED)
+        {
+            for (unsigned i = 0; i < size_ / 100; ++i)
+                Swap(source_[Rand() % size_], source_[Rand() % size_]);
+        }
+        
+        if (method_ == SORTMETHOD_PARALLELSORT)
+            SetCounter("threads", (float)(context_->GetSubsystem<WorkQueue>()->GetNumThreads() + 1));
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        WorkQueue* queue = context_->GetSubsystem<WorkQueue>();
+        
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            values_ = source_;
+            switch (method_)
+            {
+            case SORTMETHOD_SORT:
+                Sort(values_.Begin(), values_.End());
+                break;
+                
+            case SORTMETHOD_STABLESORT:
+                StableSort(values_.Begin(), values_.End());
+                break;
+                
+            case SORTMETHOD_PARALLELSORT:
+                ParallelSort(queue, values_.Begin(), values_.End());
+                break;
+            }
+            benchmarkSink += values_.Front();
+        }
+    }
+    
+private:
+    /// Unsorted values.
+    PODVector<int> source_;
+    /// Values being sorted.
+    PODVector<int> values_;
+    /// Number of values.
+    unsigned size_;
+    /// Input order.
+    SortInput input_;
+    /// Sorting algorithm.
+    SortMethod method_;
+};
+
+/// StringHash calculation from strings at runtime.
+class StringHashRuntimeBenchmark : public Benchmark
+{
+public:
+    StringHashRuntimeBenchmark(Context* context) :
+        Benchmark(context, "StringHash/Runtime", 2000000)
+    {
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            benchmarkSink += StringHash(hashNames[i & 7]).Value();
+    }
+};
+
+/// StringHash constant use. Evaluated at compile time when C++11 is enabled, otherwise read from a static initialized at startup.
+class StringHashConstantBenchmark : public Benchmark
+{
+public:
+    StringHashConstantBenchmark(Context* context) :
+        Benchmark(context, "StringHash/Constant", 2000000)
+    {
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            benchmarkSink += BENCHMARK_HASH.Value() ^ i;
+    }
+};
+
+/// Hashing throughput over a 1 MB buffer, either with the 64-bit content hash used for file checksums or with the per-byte SDBM hash used before it.
+class ContentHashBenchmark : public Benchmark
+{
+public:
+    ContentHashBenchmark(Context* context, bool sdbm) :
+        Benchmark(context, sdbm ? "Hash/SDBM1MB" : "Hash/ContentHash1MB", sdbm ? 50 : 500),
+        sdbm_(sdbm)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        data_.Resize(1024 * 1024);
+        for (unsigned i = 0; i < data_.Size(); ++i)
+            data_[i] = (unsigned char)Rand();
+        SetCounter("bytes", (float)data_.Size());
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            if (sdbm_)
+            {
+                unsigned hash = 0;
+                for (unsigned j = 0; j < data_.Size(); ++j)
+                    hash = SDBMHash(hash, data_[j]);
+                benchmarkSink += hash;
+            }
+            else
+                benchmarkSink += (unsigned)ContentHash::Calculate(&data_[0], data_.Size());
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        data_.Clear();
+    }
+    
+private:
+    /// Data to hash.
+    PODVector<unsigned char> data_;
+    /// Use the SDBM hash flag.
+    bool sdbm_;
+};
+
+/// Variant assignment of different value types.
+class VariantAssignBenchmark : public Benchmark
+{
+public:
+    VariantAssignBenchmark(Context* context) :
+        Benchmark(context, "Variant/Assign", 1000000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        string_ = "Variant string value";
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        Variant value;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            switch (i & 3)
+            {
+            case 0:
+                value = (int)i;
+                break;
+                
+            case 1:
+                value = (float)i;
+                break;
+                
+            case 2:
+                value = Vector3((float)i, 0.0f, 1.0f);
+                break;
+                
+            case 3:
+                value = string_;
+                break;
+            }
+            benchmarkSink += value.GetType();
+        }
+    }
+    
+private:
+    /// String value to assign.
+    String string_;
+};
+
+/// VariantMap setting and getting of event parameters.
+class VariantMapBenchmark : public Benchmark
+{
+public:
+    VariantMapBenchmark(Context* context) :
+        Benchmark(context, "Variant/VariantMapSetGet", 500000)
+    {
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        using namespace BenchmarkEvent;
+        
+        VariantMap map;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            map[P_VALUE] = (int)i;
+            map[P_POSITION] = Vector3::ONE;
+            benchmarkSink += map[P_VALUE].GetInt();
+            benchmarkSink += (unsigned)map[P_POSITION].GetVector3().x_;
+        }
+    }
+};
+
+/// Event receiver for the event dispatch benchmark.
+class BenchmarkReceiver : public Object
+{
+    OBJECT(BenchmarkReceiver);
+    
+public:
+    /// Construct and subscribe to the benchmark event, optionally only from a specific sender.
+    BenchmarkReceiver(Context* context, Object* sender) :
+        Object(context)
+    {
+        if (sender)
+            SubscribeToEvent(sender, E_BENCHMARKEVENT, HANDLER(BenchmarkReceiver, HandleBenchmarkEvent));
+        else
+            SubscribeToEvent(E_BENCHMARKEVENT, HANDLER(BenchmarkReceiver, HandleBenchmarkEvent));
+    }
+    
+private:
+    /// Handle the benchmark event.
+    void HandleBenchmarkEvent(StringHash eventType, VariantMap& eventData)
+    {
+        using namespace BenchmarkEvent;
+        
+        benchmarkSink += eventData[P_VALUE].GetInt();
+    }
+};
+
+/// Event dispatch to specific-sender and non-specific receivers.
+class EventDispatchBenchmark : public Benchmark
+{
+public:
+    EventDispatchBenchmark(Context* context) :
+        Benchmark(context, "Event/Dispatch10Receivers", 200000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        sender_ = new BenchmarkReceiver(context_, 0);
+        for (unsigned i = 0; i < 5; ++i)
+        {
+            receivers_.Push(SharedPtr<Object>(new BenchmarkReceiver(context_, sender_)));
+            receivers_.Push(SharedPtr<Object>(new BenchmarkReceiver(context_, 0)));
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        using namespace BenchmarkEvent;
+        
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            VariantMap& eventData = sender_->GetEventDataMap();
+            eventData[P_VALUE] = (int)i;
+            sender_->SendEvent(E_BENCHMARKEVENT, eventData);
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        receivers_.Clear();
+        sender_.Reset();
+    }
+    
+private:
+    /// Event sender. Also receives its own event as a non-specific receiver.
+    SharedPtr<Object> sender_;
+    /// Event receivers.
+    Vector<SharedPtr<Object> > receivers_;
+};
+
+/// Shared pointer copying, which increments and decrements the reference count. Atomic with URHO3D_ATOMIC_REFCOUNT.
+class SharedPtrCopyBenchmark : public Benchmark
+{
+public:
+    SharedPtrCopyBenchmark(Context* context) :
+        Benchmark(context, "RefCount/SharedPtrCopy", 2000000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        object_ = new RefCounted();
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            SharedPtr<RefCounted> copy(object_);
+            benchmarkSink += copy.Refs();
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        object_.Reset();
+    }
+    
+private:
+    /// Object to refer to.
+    SharedPtr<RefCounted> object_;
+};
+
+/// Weak pointer locking.
+class WeakPtrLockBenchmark : public Benchmark
+{
+public:
+    WeakPtrLockBenchmark(Context* context) :
+        Benchmark(context, "RefCount/WeakPtrLock", 2000000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        object_ = new RefCounted();
+        weakObject_ = object_;
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            SharedPtr<RefCounted> locked = weakObject_.Lock();
+            benchmarkSink += locked.Refs();
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        weakObject_.Reset();
+        object_.Reset();
+    }
+    
+private:
+    /// Object to refer to.
+    SharedPtr<RefCounted> object_;
+    /// Weak reference to the object.
+    WeakPtr<RefCounted> weakObject_;
+};
+
+/// Timer wheel advancing with many pending repeating timers, as used for script delayed calls.
+class TimerWheelAdvanceBenchmark : public Benchmark
+{
+public:
+    TimerWheelAdvanceBenchmark(Context* context) :
+        Benchmark(context, "TimerWheel/Advance10kTimers", 10000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        wheel_.RemoveAllTimers();
+        for (unsigned i = 0; i < 10000; ++i)
+            wheel_.AddTimer(Random(0.1f, 10.0f), true);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            wheel_.Advance(1.0f / 60.0f, fired_);
+            benchmarkSink += fired_.Size();
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        wheel_.RemoveAllTimers();
+    }
+    
+private:
+    /// Timer wheel.
+    TimerWheel wheel_;
+    /// Fired timer handles.
+    PODVector<unsigned> fired_;
+};
+
+/// Timer wheel adding and removing timers.
+class TimerWheelAddRemoveBenchmark : public Benchmark
+{
+public:
+    TimerWheelAddRemoveBenchmark(Context* context) :
+        Benchmark(context, "TimerWheel/AddRemove", 1000000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        wheel_.RemoveAllTimers();
+        delays_.Resize(1024);
+        for (unsigned i = 0; i < delays_.Size(); ++i)
+            delays_[i] = Random(0.01f, 100.0f);
+        handles_.Resize(delays_.Size());
+        for (unsigned i = 0; i < handles_.Size(); ++i)
+            handles_[i] = wheel_.AddTimer(delays_[i], false);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        // Replace the timers in a rolling fashion so that the number of pending timers stays constant
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            unsigned index = i & 1023;
+            wheel_.RemoveTimer(handles_[index]);
+            handles_[index] = wheel_.AddTimer(delays_[index], false);
+        }
+        benchmarkSink += wheel_.GetNumTimers();
+    }
+    
+    virtual void TearDown()
+    {
+        wheel_.RemoveAllTimers();
+    }
+    
+private:
+    /// Timer wheel.
+    TimerWheel wheel_;
+    /// Timer delays.
+    PODVector<float> delays_;
+    /// Pending timer handles.
+    PODVector<unsigned> handles_;
+};
+
+/// Acquire a lock for the lock benchmarks.
+template <class T> void AcquireBenchmarkLock(T& lock, bool shared)
+{
+    lock.Acquire();
+}
+
+/// Release a lock for the lock benchmarks.
+template <class T> void ReleaseBenchmarkLock(T& lock, bool shared)
+{
+    lock.Release();
+}
+
+/// Acquire a reader-writer lock for the lock benchmarks, for reading if shared.
+template <> void AcquireBenchmarkLock<RWLock>(RWLock& lock, bool shared)
+{
+    if (shared)
+        lock.AcquireShared();
+    else
+        lock.Acquire();
+}
+
+/// Release a reader-writer lock for the lock benchmarks.
+template <> void ReleaseBenchmarkLock<RWLock>(RWLock& lock, bool shared)
+{
+    if (shared)
+        lock.ReleaseShared();
+    else
+        lock.Release();
+}
+
+/// Thread which repeatedly acquires and releases a lock to contend with the main thread.
+template <class T> class LockContenderThread : public Thread, public RefCounted
+{
+public:
+    /// Construct.
+    LockContenderThread(T& lock, bool shared, volatile unsigned& counter) :
+        lock_(lock),
+        counter_(counter),
+        shared_(shared)
+    {
+    }
+    
+    /// Acquire and release the lock until stopped.
+    virtual void ThreadFunction()
+    {
+        while (shouldRun_)
+        {
+            AcquireBenchmarkLock(lock_, shared_);
+            ++counter_;
+            ReleaseBenchmarkLock(lock_, shared_);
+        }
+    }
+    
+private:
+    /// Lock to contend for.
+    T& lock_;
+    /// Counter to modify while holding the lock.
+    volatile unsigned& counter_;
+    /// Acquire for reading flag.
+    bool shared_;
+};
+
+/// Short critical sections protected by a lock, optionally contended by other threads doing the same.
+template <class T> class LockBenchmark : public Benchmark
+{
+public:
+    LockBenchmark(Context* context, const String& name, unsigned numContenders, bool shared = false) :
+        Benchmark(context, name, numContenders ? 200000 : 2000000),
+        counter_(0),
+        numContenders_(numContenders),
+        shared_(shared)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        counter_ = 0;
+        for (unsigned i = 0; i < numContenders_; ++i)
+        {
+            SharedPtr<LockContenderThread<T> > thread(new LockContenderThread<T>(lock_, shared_, counter_));
+            thread->Run();
+            threads_.Push(thread);
+        }
+        SetCounter("threads", (float)(numContenders_ + 1));
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            AcquireBenchmarkLock(lock_, shared_);
+            ++counter_;
+            ReleaseBenchmarkLock(lock_, shared_);
+        }
+        benchmarkSink += counter_;
+    }
+    
+    virtual void TearDown()
+    {
+        for (unsigned i = 0; i < threads_.Size(); ++i)
+            threads_[i]->Stop();
+        threads_.Clear();
+    }
+    
+private:
+    /// Lock to measure.
+    T lock_;
+    /// Counter modified while holding the lock. Readers of a reader-writer lock race on it, which does not matter for the measurement.
+    volatile unsigned counter_;
+    /// Contending threads.
+    Vector<SharedPtr<LockContenderThread<T> > > threads_;
+    /// Number of contending threads.
+    unsigned numContenders_;
+    /// Acquire for reading flag.
+    bool shared_;
+};
+
+void RegisterCoreBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new PODVectorPushBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new VectorPushStringBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new HashMapInsertBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new HashMapFindBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new StringAppendBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new SortBenchmark(context, "Container/Sort10k", 10000, SORTINPUT_RANDOM, SORTMETHOD_SORT, 200)));
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        dest.Push(SharedPtr<Benchmark>(new SortBenchmark(context, "Container/Sort100k" + String(sortInputNames[i]), 100000,
+            (SortInput)i, SORTMETHOD_SORT, 20)));
+        dest.Push(SharedPtr<Benchmark>(new SortBenchmark(context, "Container/StableSort100k" + String(sortInputNames[i]), 100000,
+            (SortInput)i, SORTMETHOD_STABLESORT, 20)));
+        dest.Push(SharedPtr<Benchmark>(new SortBenchmark(context, "Container/Sort1M" + String(sortInputNames[i]), 1000000,
+            (SortInput)i, SORTMETHOD_SORT, 4)));
+        dest.Push(SharedPtr<Benchmark>(new SortBenchmark(context, "Container/ParallelSort1M" + String(sortInputNames[i]), 1000000,
+            (SortInput)i, SORTMETHOD_PARALLELSORT, 4)));
+    }
+    dest.Push(SharedPtr<Benchmark>(new StringHashRuntimeBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new StringHashConstantBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new ContentHashBenchmark(context, false)));
+    dest.Push(SharedPtr<Benchmark>(new ContentHashBenchmark(context, true)));
+    dest.Push(SharedPtr<Benchmark>(new VariantAssignBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new VariantMapBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new EventDispatchBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new SharedPtrCopyBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new WeakPtrLockBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new TimerWheelAdvanceBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new TimerWheelAddRemoveBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<Mutex>(context, "Lock/Mutex", 0)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<FastMutex>(context, "Lock/FastMutex", 0)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<SpinLock>(context, "Lock/SpinLock", 0)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<Mutex>(context, "Lock/MutexContended4Threads", 3)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<FastMutex>(context, "Lock/FastMutexContended4Threads", 3)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<SpinLock>(context, "Lock/SpinLockContended4Threads", 3)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<RWLock>(context, "Lock/RWLockWriteContended4Threads", 3)));
+    dest.Push(SharedPtr<Benchmark>(new LockBenchmark<RWLock>(context, "Lock/RWLockReadContended4Threads", 3, true)));
+}
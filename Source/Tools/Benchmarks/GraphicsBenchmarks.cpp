@@ -0,0 +1,545 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "AnimatedModel.h"
+#include "Animation.h"
+#include "AnimationState.h"
+#include "Benchmarks.h"
+#include "Camera.h"
+#include "Context.h"
+#include "Light.h"
+#include "Log.h"
+#include "LightClusters.h"
+#include "Octree.h"
+#include "OctreeQuery.h"
+#include "Random.h"
+#include "Ray.h"
+#include "ResourceCache.h"
+#include "Scene.h"
+#include "StaticModel.h"
+#include "TriangleBVH.h"
+
+#include "DebugNew.h"
+
+/// Number of precomputed query volumes and rays, cycled through by the query benchmarks.
+static const unsigned NUM_QUERIES = 1024;
+
+/// Octree queries against a field of static models.
+class OctreeQueryBenchmark : public Benchmark
+{
+public:
+    /// Octree query type.
+    enum QueryType
+    {
+        BOX_QUERY = 0,
+        FRUSTUM_QUERY,
+        RAYCAST_AABB,
+        RAYCAST_TRIANGLE
+    };
+    
+    OctreeQueryBenchmark(Context* context, QueryType type) :
+        Benchmark(context, GetQueryName(type), type == FRUSTUM_QUERY ? 2000 : 20000),
+        type_(type)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        SharedPtr<Model> model = CreateGridModel(context_, 2);
+        scene_ = new Scene(context_);
+        octree_ = scene_->CreateComponent<Octree>();
+        for (unsigned i = 0; i < 10000; ++i)
+        {
+            Node* node = scene_->CreateChild("Object");
+            node->SetPosition(Vector3(Random(-500.0f, 500.0f), Random(-50.0f, 50.0f), Random(-500.0f, 500.0f)));
+            node->SetRotation(Quaternion(Random(360.0f), Random(360.0f), Random(360.0f)));
+            node->CreateComponent<StaticModel>()->SetModel(model);
+        }
+        
+        Camera* camera = scene_->CreateChild("Camera")->CreateComponent<Camera>();
+        camera->SetFarClip(300.0f);
+        
+        for (unsigned i = 0; i < NUM_QUERIES; ++i)
+        {
+            Vector3 position(Random(-500.0f, 500.0f), Random(-50.0f, 50.0f), Random(-500.0f, 500.0f));
+            Vector3 direction(Random(-1.0f, 1.0f), Random(-0.2f, 0.2f), Random(-1.0f, 1.0f));
+            boxes_.Push(BoundingBox(position - Vector3(20.0f, 20.0f, 20.0f), position + Vector3(20.0f, 20.0f, 20.0f)));
+            rays_.Push(Ray(position, direction.Normalized()));
+            
+            camera->GetNode()->SetPosition(position);
+            camera->GetNode()->SetDirection(direction);
+            frustums_.Push(camera->GetFrustum());
+        }
+        
+        FrameInfo frame;
+        frame.frameNumber_ = 1;
+        frame.timeStep_ = 0.0f;
+        frame.camera_ = 0;
+        octree_->Update(frame);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numResults = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            unsigned index = i & (NUM_QUERIES - 1);
+            switch (type_)
+            {
+            case BOX_QUERY:
+                {
+                    BoxOctreeQuery query(drawables_, boxes_[index], DRAWABLE_GEOMETRY);
+                    octree_->GetDrawables(query);
+                    numResults += drawables_.Size();
+                }
+                break;
+                
+            case FRUSTUM_QUERY:
+                {
+                    FrustumOctreeQuery query(drawables_, frustums_[index], DRAWABLE_GEOMETRY);
+                    octree_->GetDrawables(query);
+                    numResults += drawables_.Size();
+                }
+                break;
+                
+            case RAYCAST_AABB:
+            case RAYCAST_TRIANGLE:
+                {
+                    RayOctreeQuery query(rayResults_, rays_[index], type_ == RAYCAST_AABB ? RAY_AABB : RAY_TRIANGLE, 200.0f,
+                        DRAWABLE_GEOMETRY);
+                    octree_->Raycast(query);
+                    numResults += rayResults_.Size();
+                }
+                break;
+            }
+        }
+        SetCounter("resultsPerQuery", (float)numResults / iterations);
+    }
+    
+    virtual void TearDown()
+    {
+        drawables_.Clear();
+        rayResults_.Clear();
+        octree_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Return benchmark name for a query type.
+    static String GetQueryName(QueryType type)
+    {
+        switch (type)
+        {
+        case BOX_QUERY:
+            return "Octree/BoxQuery10k";
+            
+        case FRUSTUM_QUERY:
+            return "Octree/FrustumQuery10k";
+            
+        case RAYCAST_AABB:
+            return "Octree/RaycastAABB10k";
+            
+        default:
+            return "Octree/RaycastTriangle10k";
+        }
+    }
+    
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Octree.
+    SharedPtr<Octree> octree_;
+    /// Query boxes.
+    PODVector<BoundingBox> boxes_;
+    /// Query frustums.
+    PODVector<Frustum> frustums_;
+    /// Query rays.
+    PODVector<Ray> rays_;
+    /// Drawable query results.
+    PODVector<Drawable*> drawables_;
+    /// Raycast results.
+    PODVector<RayQueryResult> rayResults_;
+    /// Query type.
+    QueryType type_;
+};
+
+/// Octree update after moving a part of the drawables.
+class OctreeUpdateBenchmark : public Benchmark
+{
+public:
+    OctreeUpdateBenchmark(Context* context) :
+        Benchmark(context, "Octree/Update1kMoving", 500)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        SharedPtr<Model> model = CreateGridModel(context_, 2);
+        scene_ = new Scene(context_);
+        octree_ = scene_->CreateComponent<Octree>();
+        for (unsigned i = 0; i < 10000; ++i)
+        {
+            Node* node = scene_->CreateChild("Object");
+            node->SetPosition(Vector3(Random(-500.0f, 500.0f), Random(-50.0f, 50.0f), Random(-500.0f, 500.0f)));
+            node->CreateComponent<StaticModel>()->SetModel(model);
+            if (i % 10 == 0)
+                movingNodes_.Push(node);
+        }
+        
+        frame_.frameNumber_ = 1;
+        frame_.timeStep_ = 1.0f / 60.0f;
+        frame_.camera_ = 0;
+        octree_->Update(frame_);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < movingNodes_.Size(); ++j)
+                movingNodes_[j]->Translate(Vector3((i & 1) ? 1.0f : -1.0f, 0.0f, 0.0f));
+            ++frame_.frameNumber_;
+            octree_->Update(frame_);
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        movingNodes_.Clear();
+        octree_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Octree.
+    SharedPtr<Octree> octree_;
+    /// Nodes moved on each iteration.
+    PODVector<Node*> movingNodes_;
+    /// Frame info for the octree update.
+    FrameInfo frame_;
+};
+
+/// Triangle-level raycasts against a single large model, which go through the geometry's triangle BVH.
+class TriangleRaycastBenchmark : public Benchmark
+{
+public:
+    TriangleRaycastBenchmark(Context* context) :
+        Benchmark(context, "Raycast/Triangle100kModel", 100000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        // 224 x 224 quads make a little over 100000 triangles
+        const unsigned gridSize = 224;
+        scene_ = new Scene(context_);
+        octree_ = scene_->CreateComponent<Octree>();
+        scene_->CreateChild("Grid")->CreateComponent<StaticModel>()->SetModel(CreateGridModel(context_, gridSize));
+        
+        float extent = 0.5f * gridSize;
+        for (unsigned i = 0; i < NUM_QUERIES; ++i)
+        {
+            Vector3 origin(Random(-extent, extent), 10.0f, Random(-extent, extent));
+            Vector3 direction(Random(-0.5f, 0.5f), -1.0f, Random(-0.5f, 0.5f));
+            rays_.Push(Ray(origin, direction.Normalized()));
+        }
+        
+        FrameInfo frame;
+        frame.frameNumber_ = 1;
+        frame.timeStep_ = 0.0f;
+        frame.camera_ = 0;
+        octree_->Update(frame);
+        SetCounter("triangles", (float)(gridSize * gridSize * 2));
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numHits = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            RayOctreeQuery query(results_, rays_[i & (NUM_QUERIES - 1)], RAY_TRIANGLE, M_INFINITY, DRAWABLE_GEOMETRY);
+            octree_->RaycastSingle(query);
+            numHits += results_.Size();
+        }
+        SetCounter("hitRatio", (float)numHits / iterations);
+    }
+    
+    virtual void TearDown()
+    {
+        results_.Clear();
+        octree_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Octree.
+    SharedPtr<Octree> octree_;
+    /// Query rays.
+    PODVector<Ray> rays_;
+    /// Raycast results.
+    PODVector<RayQueryResult> results_;
+};
+
+/// Axis-aligned and diagonal rays against a flat grid mesh through the triangle BVH, starting at vertex-aligned positions so that they run along the planes of the BVH node boxes. Checks the hit distances against the brute-force triangle test and reports any differences in the mismatches counter.
+class TriangleBVHAxisAlignedBenchmark : public Benchmark
+{
+public:
+    TriangleBVHAxisAlignedBenchmark(Context* context) :
+        Benchmark(context, "Raycast/TriangleBVHAxisAligned", 100000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        const unsigned gridSize = 16;
+        float halfSize = 0.5f * gridSize;
+        
+        vertexData_.Clear();
+        for (unsigned z = 0; z <= gridSize; ++z)
+        {
+            for (unsigned x = 0; x <= gridSize; ++x)
+            {
+                vertexData_.Push(x - halfSize);
+                vertexData_.Push(0.0f);
+                vertexData_.Push(z - halfSize);
+            }
+        }
+        
+        indexData_.Clear();
+        for (unsigned z = 0; z < gridSize; ++z)
+        {
+            for (unsigned x = 0; x < gridSize; ++x)
+            {
+                unsigned corner = z * (gridSize + 1) + x;
+                indexData_.Push(corner);
+                indexData_.Push(corner + gridSize + 1);
+                indexData_.Push(corner + 1);
+                indexData_.Push(corner + 1);
+                indexData_.Push(corner + gridSize + 1);
+                indexData_.Push(corner + gridSize + 2);
+            }
+        }
+        
+        bvh_.Define(&vertexData_[0], 3 * sizeof(float), &indexData_[0], sizeof(unsigned), 0, indexData_.Size());
+        
+        // Straight down, and tilted along one axis so that the other direction component stays zero
+        const Vector3 directions[] = {
+            Vector3(0.0f, -1.0f, 0.0f),
+            Vector3(1.0f, -1.0f, 0.0f).Normalized(),
+            Vector3(0.0f, -1.0f, 1.0f).Normalized()
+        };
+        
+        rays_.Clear();
+        for (unsigned z = 0; z <= gridSize; ++z)
+        {
+            for (unsigned x = 0; x <= gridSize; ++x)
+            {
+                for (unsigned i = 0; i < 3; ++i)
+                    rays_.Push(Ray(Vector3(x - halfSize, 10.0f, z - halfSize), directions[i]));
+            }
+        }
+        
+        unsigned mismatches = 0;
+        for (unsigned i = 0; i < rays_.Size(); ++i)
+        {
+            float distance = bvh_.HitDistance(rays_[i]);
+            float expected = rays_[i].HitDistance(&vertexData_[0], 3 * sizeof(float), &indexData_[0], sizeof(unsigned), 0,
+                indexData_.Size());
+            if (distance != expected && !(Abs(distance - expected) < M_EPSILON))
+                ++mismatches;
+        }
+        if (mismatches)
+            LOGERROR(String(mismatches) + " of " + String(rays_.Size()) + " triangle BVH raycasts differ from the brute-force test");
+        
+        SetCounter("mismatches", (float)mismatches);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numHits = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            if (bvh_.HitDistance(rays_[i % rays_.Size()]) < M_INFINITY)
+                ++numHits;
+        }
+        benchmarkSink += numHits;
+    }
+    
+private:
+    /// Grid vertex positions.
+    PODVector<float> vertexData_;
+    /// Grid triangle indices.
+    PODVector<unsigned> indexData_;
+    /// Triangle BVH of the grid.
+    TriangleBVH bvh_;
+    /// Query rays.
+    PODVector<Ray> rays_;
+};
+
+/// Skeletal animation update of animated models.
+class SkeletalAnimationBenchmark : public Benchmark
+{
+public:
+    SkeletalAnimationBenchmark(Context* context) :
+        Benchmark(context, "Animation/AnimatedModel100", 200)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        ResourceCache* cache = context_->GetSubsystem<ResourceCache>();
+        Model* model = cache->GetResource<Model>("Models/Jack.mdl");
+        Animation* animation = cache->GetResource<Animation>("Models/Jack_Walk.ani");
+        if (!model || !animation)
+            return false;
+        
+        scene_ = new Scene(context_);
+        octree_ = scene_->CreateComponent<Octree>();
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            Node* node = scene_->CreateChild("Jack");
+            node->SetPosition(Vector3(Random(-50.0f, 50.0f), 0.0f, Random(-50.0f, 50.0f)));
+            AnimatedModel* animatedModel = node->CreateComponent<AnimatedModel>();
+            animatedModel->SetModel(model);
+            // There is no camera, so the models must be updated as if they were invisible
+            animatedModel->SetUpdateInvisible(true);
+            AnimationState* state = animatedModel->AddAnimationState(animation);
+            state->SetWeight(1.0f);
+            state->SetLooped(true);
+            state->AddTime(Random(animation->GetLength()));
+            states_.Push(state);
+        }
+        
+        frame_.frameNumber_ = 1;
+        frame_.timeStep_ = 1.0f / 60.0f;
+        frame_.camera_ = 0;
+        octree_->Update(frame_);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < states_.Size(); ++j)
+                states_[j]->AddTime(frame_.timeStep_);
+            ++frame_.frameNumber_;
+            octree_->Update(frame_);
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        states_.Clear();
+        octree_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Octree.
+    SharedPtr<Octree> octree_;
+    /// Animation states.
+    PODVector<AnimationState*> states_;
+    /// Frame info for the octree update.
+    FrameInfo frame_;
+};
+
+/// Clustered light assignment of point and spot lights.
+class LightClustersBenchmark : public Benchmark
+{
+public:
+    LightClustersBenchmark(Context* context) :
+        Benchmark(context, "LightClusters/Assign256Lights", 500)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = new Scene(context_);
+        scene_->CreateComponent<Octree>();
+        for (unsigned i = 0; i < 256; ++i)
+        {
+            Node* node = scene_->CreateChild("Light");
+            node->SetPosition(Vector3(Random(-100.0f, 100.0f), Random(0.0f, 20.0f), Random(0.0f, 200.0f)));
+            node->SetDirection(Vector3(Random(-1.0f, 1.0f), -1.0f, Random(-1.0f, 1.0f)));
+            Light* light = node->CreateComponent<Light>();
+            light->SetLightType((i & 3) ? LIGHT_POINT : LIGHT_SPOT);
+            light->SetRange(Random(5.0f, 25.0f));
+            light->SetFov(Random(30.0f, 90.0f));
+            lights_.Push(light);
+        }
+        
+        camera_ = scene_->CreateChild("Camera")->CreateComponent<Camera>();
+        camera_->SetFarClip(250.0f);
+        camera_->SetAspectRatio(16.0f / 9.0f);
+        clusters_ = new LightClusters(context_);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            clusters_->Assign(camera_, lights_);
+        SetCounter("assignments", (float)clusters_->GetNumAssignments());
+        SetCounter("overflows", (float)clusters_->GetNumOverflows());
+    }
+    
+    virtual void TearDown()
+    {
+        lights_.Clear();
+        clusters_.Reset();
+        camera_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Camera.
+    SharedPtr<Camera> camera_;
+    /// Light clusters.
+    SharedPtr<LightClusters> clusters_;
+    /// Lights to assign.
+    PODVector<Light*> lights_;
+};
+
+void RegisterGraphicsBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new OctreeQueryBenchmark(context, OctreeQueryBenchmark::BOX_QUERY)));
+    dest.Push(SharedPtr<Benchmark>(new OctreeQueryBenchmark(context, OctreeQueryBenchmark::FRUSTUM_QUERY)));
+    dest.Push(SharedPtr<Benchmark>(new OctreeQueryBenchmark(context, OctreeQueryBenchmark::RAYCAST_AABB)));
+    dest.Push(SharedPtr<Benchmark>(new OctreeQueryBenchmark(context, OctreeQueryBenchmark::RAYCAST_TRIANGLE)));
+    dest.Push(SharedPtr<Benchmark>(new OctreeUpdateBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new TriangleRaycastBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new TriangleBVHAxisAlignedBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new SkeletalAnimationBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new LightClustersBenchmark(context)));
+}
@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "Context.h"
+#include "Navigable.h"
+#include "NavigationMesh.h"
+#include "Octree.h"
+#include "Random.h"
+#include "ResourceCache.h"
+#include "Scene.h"
+#include "StaticModel.h"
+
+#include "DebugNew.h"
+
+/// Create a navigation scene with a flat ground and box obstacles.
+static SharedPtr<Scene> CreateNavigationScene(Context* context, Model* boxModel)
+{
+    SharedPtr<Scene> scene(new Scene(context));
+    scene->CreateComponent<Octree>();
+    scene->CreateComponent<Navigable>();
+    NavigationMesh* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(64);
+    
+    scene->CreateChild("Ground")->CreateComponent<StaticModel>()->SetModel(CreateGridModel(context, 128));
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        Node* node = scene->CreateChild("Obstacle");
+        node->SetPosition(Vector3(Random(-60.0f, 60.0f), 1.0f, Random(-60.0f, 60.0f)));
+        node->SetRotation(Quaternion(Random(360.0f), Vector3::UP));
+        node->SetScale(Vector3(Random(1.0f, 4.0f), 2.0f, Random(1.0f, 4.0f)));
+        node->CreateComponent<StaticModel>()->SetModel(boxModel);
+    }
+    
+    return scene;
+}
+
+/// Full navigation mesh build from scene geometry.
+class NavigationBuildBenchmark : public Benchmark
+{
+public:
+    NavigationBuildBenchmark(Context* context) :
+        Benchmark(context, "Navigation/Build", 1)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        Model* boxModel = context_->GetSubsystem<ResourceCache>()->GetResource<Model>("Models/Box.mdl");
+        if (!boxModel)
+            return false;
+        
+        scene_ = CreateNavigationScene(context_, boxModel);
+        navMesh_ = scene_->GetComponent<NavigationMesh>();
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            navMesh_->Build();
+        SetCounter("dataBytes", (float)navMesh_->GetNavigationDataAttr().Size());
+    }
+    
+    virtual void TearDown()
+    {
+        navMesh_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Navigation mesh.
+    SharedPtr<NavigationMesh> navMesh_;
+};
+
+/// Pathfinding between random points on a built navigation mesh.
+class NavigationFindPathBenchmark : public Benchmark
+{
+public:
+    NavigationFindPathBenchmark(Context* context) :
+        Benchmark(context, "Navigation/FindPath", 2000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        Model* boxModel = context_->GetSubsystem<ResourceCache>()->GetResource<Model>("Models/Box.mdl");
+        if (!boxModel)
+            return false;
+        
+        scene_ = CreateNavigationScene(context_, boxModel);
+        navMesh_ = scene_->GetComponent<NavigationMesh>();
+        if (!navMesh_->Build())
+            return false;
+        
+        for (unsigned i = 0; i < 1024; ++i)
+            points_.Push(navMesh_->GetRandomPoint());
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numWaypoints = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            navMesh_->FindPath(path_, points_[i & 1023], points_[(i * 7 + 512) & 1023]);
+            numWaypoints += path_.Size();
+        }
+        SetCounter("waypointsPerPath", (float)numWaypoints / iterations);
+    }
+    
+    virtual void TearDown()
+    {
+        points_.Clear();
+        path_.Clear();
+        navMesh_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Navigation mesh.
+    SharedPtr<NavigationMesh> navMesh_;
+    /// Path endpoints.
+    PODVector<Vector3> points_;
+    /// Path result.
+    PODVector<Vector3> path_;
+};
+
+void RegisterNavigationBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new NavigationBuildBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new NavigationFindPathBenchmark(context)));
+}
@@ -0,0 +1,294 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "Context.h"
+#include "HashSet.h"
+#include "HttpClient.h"
+#include "HttpRequest.h"
+#include "MemoryBuffer.h"
+#include "Mutex.h"
+#include "Random.h"
+#include "Scene.h"
+#include "Timer.h"
+#include "VectorBuffer.h"
+
+#include <civetweb.h>
+#include <cstring>
+
+#include "DebugNew.h"
+
+/// Node replication by writing network attribute updates of moving nodes and reading them into mirror nodes.
+class NodeReplicationBenchmark : public Benchmark
+{
+public:
+    NodeReplicationBenchmark(Context* context, bool latestData) :
+        Benchmark(context, latestData ? "Network/NodeLatestData1kNodes" : "Network/NodeDeltaUpdate1kNodes", 100),
+        latestData_(latestData)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = new Scene(context_);
+        mirrorScene_ = new Scene(context_);
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            Node* node = scene_->CreateChild("Object");
+            node->SetPosition(Vector3(Random(-100.0f, 100.0f), Random(-100.0f, 100.0f), Random(-100.0f, 100.0f)));
+            nodes_.Push(node);
+            mirrorNodes_.Push(mirrorScene_->CreateChild("Object", LOCAL));
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < nodes_.Size(); ++j)
+            {
+                nodes_[j]->Translate(Vector3(0.0f, (i & 1) ? 0.1f : -0.1f, 0.0f));
+                nodes_[j]->Yaw(1.0f);
+            }
+            scene_->PrepareNetworkUpdate();
+            
+            buffer_.Clear();
+            for (unsigned j = 0; j < nodes_.Size(); ++j)
+            {
+                if (latestData_)
+                    nodes_[j]->WriteLatestDataUpdate(buffer_);
+                else
+                    nodes_[j]->WriteInitialDeltaUpdate(buffer_);
+            }
+            
+            MemoryBuffer source(buffer_.GetData(), buffer_.GetSize());
+            for (unsigned j = 0; j < mirrorNodes_.Size(); ++j)
+            {
+                if (latestData_)
+                    mirrorNodes_[j]->ReadLatestDataUpdate(source);
+                else
+                    mirrorNodes_[j]->ReadDeltaUpdate(source);
+            }
+        }
+        SetCounter("bytesPerNode", (float)buffer_.GetSize() / nodes_.Size());
+    }
+    
+    virtual void TearDown()
+    {
+        nodes_.Clear();
+        mirrorNodes_.Clear();
+        buffer_.Clear();
+        mirrorScene_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Replicated scene.
+    SharedPtr<Scene> scene_;
+    /// Scene receiving the updates.
+    SharedPtr<Scene> mirrorScene_;
+    /// Replicated nodes.
+    PODVector<Node*> nodes_;
+    /// Nodes receiving the updates.
+    PODVector<Node*> mirrorNodes_;
+    /// Update message buffer.
+    VectorBuffer buffer_;
+    /// Latest data update mode flag. If false, writes full delta updates.
+    bool latestData_;
+};
+
+/// Variant map serialization as used by remote events and node user variables.
+class VariantMapSerializationBenchmark : public Benchmark
+{
+public:
+    VariantMapSerializationBenchmark(Context* context) :
+        Benchmark(context, "Network/VariantMapSerialization", 20000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            map_[StringHash("Int" + String(i))] = Rand();
+            map_[StringHash("Float" + String(i))] = Random(1000.0f);
+            map_[StringHash("Vector3" + String(i))] = Vector3(Random(1.0f), Random(1.0f), Random(1.0f));
+            map_[StringHash("String" + String(i))] = "Value" + String(Rand());
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numEntries = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            buffer_.Clear();
+            buffer_.WriteVariantMap(map_);
+            MemoryBuffer source(buffer_.GetData(), buffer_.GetSize());
+            numEntries += source.ReadVariantMap().Size();
+        }
+        benchmarkSink += numEntries;
+        SetCounter("bytes", (float)buffer_.GetSize());
+    }
+    
+    virtual void TearDown()
+    {
+        map_.Clear();
+        buffer_.Clear();
+    }
+    
+private:
+    /// Variant map to serialize.
+    VariantMap map_;
+    /// Serialization buffer.
+    VectorBuffer buffer_;
+};
+
+/// Remote ports of the connections served by the benchmark HTTP server.
+static HashSet<int> httpRemotePorts;
+/// Mutex for the remote ports, as the server handles requests in its own threads.
+static Mutex httpRemotePortsMutex;
+
+/// Handle a request to the benchmark HTTP server. Writes the headers and body at once to avoid delayed acknowledgement stalls. Non-null user data requests an empty body.
+static int HandleHttpBenchmarkRequest(mg_connection* connection, void* userData)
+{
+    const mg_request_info* info = mg_get_request_info(connection);
+    {
+        MutexLock lock(httpRemotePortsMutex);
+        httpRemotePorts.Insert(info->remote_port);
+    }
+    
+    if (userData)
+        mg_printf(connection, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 0\r\n\r\n");
+    else
+        mg_printf(connection, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n\r\nOK");
+    return 1;
+}
+
+/// HTTP requests through the pooled keep-alive HTTP client subsystem against a local server.
+class HttpClientBenchmark : public Benchmark
+{
+public:
+    HttpClientBenchmark(Context* context, bool emptyBody) :
+        Benchmark(context, emptyBody ? "Network/HttpClientKeepAlive200EmptyBody" : "Network/HttpClientKeepAlive200", 1),
+        server_(0),
+        port_(0),
+        emptyBody_(emptyBody)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        if (!context_->GetSubsystem<HttpClient>())
+            return false;
+        
+        mg_callbacks callbacks;
+        memset(&callbacks, 0, sizeof callbacks);
+        
+        // Try a few ports in case the first one is in use
+        for (unsigned i = 0; i < 16 && !server_; ++i)
+        {
+            port_ = 23456 + i;
+            String listeningPorts = "127.0.0.1:" + String(port_);
+            const char* options[] = { "listening_ports", listeningPorts.CString(), "num_threads", "8", "enable_keep_alive", "yes", 0 };
+            server_ = mg_start(&callbacks, 0, options);
+        }
+        if (!server_)
+            return false;
+        
+        mg_set_request_handler(server_, "/benchmark", HandleHttpBenchmarkRequest, emptyBody_ ? this : 0);
+        httpRemotePorts.Clear();
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        HttpClient* client = context_->GetSubsystem<HttpClient>();
+        Time* time = context_->GetSubsystem<Time>();
+        String baseURL = "http://127.0.0.1:" + String(port_) + "/benchmark/";
+        
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < 200; ++j)
+                requests_.Push(client->MakeRequest(baseURL + String(j)));
+            
+            // Run frames to deliver the finished request events, until all requests have finished or the time limit is reached
+            Timer timer;
+            while (timer.GetMSec(false) < 10000)
+            {
+                time->BeginFrame(0.0f);
+                time->EndFrame();
+                
+                bool finished = true;
+                for (unsigned j = 0; j < requests_.Size(); ++j)
+                {
+                    HttpRequestState state = requests_[j]->GetState();
+                    if (state != HTTP_CLOSED && state != HTTP_ERROR)
+                    {
+                        finished = false;
+                        break;
+                    }
+                }
+                if (finished)
+                    break;
+                
+                Time::Sleep(0);
+            }
+            
+            requests_.Clear();
+        }
+        
+        MutexLock lock(httpRemotePortsMutex);
+        SetCounter("connections", (float)httpRemotePorts.Size());
+    }
+    
+    virtual void TearDown()
+    {
+        requests_.Clear();
+        if (server_)
+        {
+            mg_stop(server_);
+            server_ = 0;
+        }
+    }
+    
+private:
+    /// Local HTTP server.
+    mg_context* server_;
+    /// Local HTTP server port.
+    unsigned port_;
+    /// Requests in flight.
+    Vector<SharedPtr<HttpRequest> > requests_;
+    /// Respond with an empty body flag.
+    bool emptyBody_;
+};
+
+void RegisterNetworkBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new NodeReplicationBenchmark(context, false)));
+    dest.Push(SharedPtr<Benchmark>(new NodeReplicationBenchmark(context, true)));
+    dest.Push(SharedPtr<Benchmark>(new VariantMapSerializationBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new HttpClientBenchmark(context, false)));
+    dest.Push(SharedPtr<Benchmark>(new HttpClientBenchmark(context, true)));
+}
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "CollisionShape.h"
+#include "Context.h"
+#include "PhysicsWorld.h"
+#include "Random.h"
+#include "Ray.h"
+#include "RigidBody.h"
+#include "Scene.h"
+
+#include "DebugNew.h"
+
+/// Create a physics scene with a static ground plane and the given number of dynamic boxes stacked in columns.
+static SharedPtr<Scene> CreatePhysicsScene(Context* context, unsigned numBoxes)
+{
+    SharedPtr<Scene> scene(new Scene(context));
+    scene->CreateComponent<PhysicsWorld>();
+    
+    Node* ground = scene->CreateChild("Ground");
+    ground->CreateComponent<RigidBody>();
+    ground->CreateComponent<CollisionShape>()->SetStaticPlane();
+    
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        Node* node = scene->CreateChild("Box");
+        node->SetPosition(Vector3((float)(i % 20) * 2.0f - 20.0f, 0.5f + (float)(i / 400) * 1.1f, (float)((i / 20) % 20) * 2.0f - 20.0f));
+        RigidBody* body = node->CreateComponent<RigidBody>();
+        body->SetMass(1.0f);
+        // Keep the bodies from going to sleep so that each step costs the same
+        body->SetLinearRestThreshold(0.0f);
+        body->SetAngularRestThreshold(0.0f);
+        node->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+    }
+    
+    return scene;
+}
+
+/// Physics world simulation step with dynamic boxes resting on a ground plane.
+class PhysicsStepBenchmark : public Benchmark
+{
+public:
+    PhysicsStepBenchmark(Context* context) :
+        Benchmark(context, "Physics/Step1kBoxes", 60)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = CreatePhysicsScene(context_, 1000);
+        world_ = scene_->GetComponent<PhysicsWorld>();
+        // Let the stacks settle before measuring
+        for (unsigned i = 0; i < 60; ++i)
+            world_->Update(1.0f / 60.0f);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            world_->Update(1.0f / 60.0f);
+    }
+    
+    virtual void TearDown()
+    {
+        world_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Physics world.
+    SharedPtr<PhysicsWorld> world_;
+};
+
+/// Physics world raycasts against dynamic boxes and the ground plane.
+class PhysicsRaycastBenchmark : public Benchmark
+{
+public:
+    PhysicsRaycastBenchmark(Context* context) :
+        Benchmark(context, "Physics/Raycast1kBoxes", 20000)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = CreatePhysicsScene(context_, 1000);
+        world_ = scene_->GetComponent<PhysicsWorld>();
+        world_->Update(1.0f / 60.0f);
+        
+        for (unsigned i = 0; i < 1024; ++i)
+        {
+            Vector3 origin(Random(-25.0f, 25.0f), 10.0f, Random(-25.0f, 25.0f));
+            Vector3 direction(Random(-1.0f, 1.0f), -1.0f, Random(-1.0f, 1.0f));
+            rays_.Push(Ray(origin, direction.Normalized()));
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        unsigned numBodyHits = 0;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            PhysicsRaycastResult result;
+            world_->RaycastSingle(result, rays_[i & 1023], 100.0f);
+            if (result.body_ && result.body_->GetMass() > 0.0f)
+                ++numBodyHits;
+        }
+        SetCounter("boxHitRatio", (float)numBodyHits / iterations);
+    }
+    
+    virtual void TearDown()
+    {
+        rays_.Clear();
+        world_.Reset();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Physics world.
+    SharedPtr<PhysicsWorld> world_;
+    /// Query rays.
+    PODVector<Ray> rays_;
+};
+
+void RegisterPhysicsBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new PhysicsStepBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new PhysicsRaycastBenchmark(context)));
+}
@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2008-2014 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmarks.h"
+#include "Context.h"
+#include "Engine.h"
+#include "Light.h"
+#include "Octree.h"
+#include "Random.h"
+#include "ResourceCache.h"
+#include "Scene.h"
+#include "StaticModel.h"
+#include "ValueAnimation.h"
+#include "VectorBuffer.h"
+
+#include "DebugNew.h"
+
+/// Create a scene with an octree and the given number of static model nodes at random positions.
+static SharedPtr<Scene> CreateStaticModelScene(Context* context, Model* model, unsigned numNodes, float extent)
+{
+    SharedPtr<Scene> scene(new Scene(context));
+    scene->CreateComponent<Octree>();
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild("Object");
+        node->SetPosition(Vector3(Random(-extent, extent), Random(-extent, extent), Random(-extent, extent)));
+        node->SetRotation(Quaternion(Random(360.0f), Random(360.0f), Random(360.0f)));
+        node->CreateComponent<StaticModel>()->SetModel(model);
+    }
+    return scene;
+}
+
+/// Scene update with moving nodes, including the octree reinsertion of their drawables.
+class SceneMoveAndUpdateBenchmark : public Benchmark
+{
+public:
+    SceneMoveAndUpdateBenchmark(Context* context) :
+        Benchmark(context, "Scene/MoveAndUpdate10k", 50)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = CreateStaticModelScene(context_, CreateGridModel(context_, 1), 10000, 500.0f);
+        scene_->GetChildren(nodes_);
+        frame_.frameNumber_ = 0;
+        frame_.timeStep_ = 1.0f / 60.0f;
+        frame_.camera_ = 0;
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        Octree* octree = scene_->GetComponent<Octree>();
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < nodes_.Size(); ++j)
+                nodes_[j]->Translate(Vector3(0.0f, (i & 1) ? 0.1f : -0.1f, 0.0f));
+            scene_->Update(frame_.timeStep_);
+            ++frame_.frameNumber_;
+            octree->Update(frame_);
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        nodes_.Clear();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Moving nodes.
+    PODVector<Node*> nodes_;
+    /// Frame info for the octree update.
+    FrameInfo frame_;
+};
+
+/// Scene update of many lights with attribute animations on the light color and node position.
+class AttributeAnimationBenchmark : public Benchmark
+{
+public:
+    AttributeAnimationBenchmark(Context* context) :
+        Benchmark(context, "Scene/AttributeAnimation1kLights", 200)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        SharedPtr<ValueAnimation> colorAnimation(new ValueAnimation(context_));
+        colorAnimation->SetKeyFrame(0.0f, Color::WHITE);
+        colorAnimation->SetKeyFrame(1.0f, Color::RED);
+        colorAnimation->SetKeyFrame(2.0f, Color::WHITE);
+        
+        SharedPtr<ValueAnimation> positionAnimation(new ValueAnimation(context_));
+        positionAnimation->SetKeyFrame(0.0f, Vector3::ZERO);
+        positionAnimation->SetKeyFrame(1.0f, Vector3::UP);
+        positionAnimation->SetKeyFrame(2.0f, Vector3::ZERO);
+        
+        scene_ = new Scene(context_);
+        scene_->CreateComponent<Octree>();
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            Node* node = scene_->CreateChild("Light");
+            node->SetPosition(Vector3(Random(-100.0f, 100.0f), 0.0f, Random(-100.0f, 100.0f)));
+            node->SetAttributeAnimation("Position", positionAnimation, WM_LOOP, Random(0.5f, 2.0f));
+            Light* light = node->CreateComponent<Light>();
+            light->SetLightType(LIGHT_POINT);
+            light->SetAttributeAnimation("Color", colorAnimation, WM_LOOP, Random(0.5f, 2.0f));
+        }
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+            scene_->Update(1.0f / 60.0f);
+    }
+    
+    virtual void TearDown()
+    {
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+};
+
+/// Node creation and removal, either from the heap or from the object factory pools.
+class NodeSpawnBenchmark : public Benchmark
+{
+public:
+    NodeSpawnBenchmark(Context* context, bool pooling) :
+        Benchmark(context, pooling ? "Scene/NodeSpawnPooled" : "Scene/NodeSpawnHeap", 2000),
+        pooling_(pooling)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = new Scene(context_);
+        scene_->CreateComponent<Octree>();
+        model_ = CreateGridModel(context_, 1);
+        SetPooling(pooling_);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < 100; ++j)
+            {
+                Node* node = scene_->CreateChild("Spawned");
+                node->SetPosition(Vector3((float)j, 0.0f, 0.0f));
+                node->CreateComponent<StaticModel>()->SetModel(model_);
+            }
+            scene_->RemoveAllChildren();
+        }
+    }
+    
+    virtual void TearDown()
+    {
+        scene_.Reset();
+        model_.Reset();
+        if (pooling_)
+            SetPooling(false);
+    }
+    
+private:
+    /// Enable or disable pooling of the spawned object types.
+    void SetPooling(bool enable)
+    {
+        context_->GetObjectFactory(Node::GetTypeStatic())->SetPooling(enable, 128);
+        context_->GetObjectFactory(StaticModel::GetTypeStatic())->SetPooling(enable, 128);
+    }
+    
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Model for the spawned nodes.
+    SharedPtr<Model> model_;
+    /// Pooling flag.
+    bool pooling_;
+};
+
+/// Continuous node creation and removal in a large scene, which exercises the scene node ID allocation.
+class NodeIDChurnBenchmark : public Benchmark
+{
+public:
+    NodeIDChurnBenchmark(Context* context) :
+        Benchmark(context, "Scene/NodeIDChurn10k", 500)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = new Scene(context_);
+        for (unsigned i = 0; i < 10000; ++i)
+            nodes_.Push(SharedPtr<Node>(scene_->CreateChild()));
+        oldest_ = 0;
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        // Replace the oldest nodes with new ones, so that the live IDs spread out and released IDs get reused
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            for (unsigned j = 0; j < 100; ++j)
+            {
+                SharedPtr<Node>& node = nodes_[oldest_];
+                node->Remove();
+                node = scene_->CreateChild();
+                oldest_ = (oldest_ + 1) % nodes_.Size();
+            }
+        }
+        
+        unsigned maxID = 0;
+        for (unsigned i = 0; i < nodes_.Size(); ++i)
+            maxID = Max((int)maxID, (int)nodes_[i]->GetID());
+        SetCounter("maxNodeID", (float)maxID);
+    }
+    
+    virtual void TearDown()
+    {
+        nodes_.Clear();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Nodes in creation order.
+    Vector<SharedPtr<Node> > nodes_;
+    /// Index of the oldest node.
+    unsigned oldest_;
+};
+
+/// Engine frame in headless mode, or in the dedicated server profile when started with -serverprofile, with no frame rate limit.
+class ServerTickBenchmark : public Benchmark
+{
+public:
+    ServerTickBenchmark(Context* context, unsigned numNodes) :
+        Benchmark(context, numNodes ? "Scene/ServerTick10kNodes" : "Scene/ServerTickEmpty", numNodes ? 200 : 5000),
+        numNodes_(numNodes)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        scene_ = CreateStaticModelScene(context_, CreateGridModel(context_, 1), numNodes_, 500.0f);
+        Engine* engine = context_->GetSubsystem<Engine>();
+        maxFps_ = engine->GetMaxFps();
+        engine->SetMaxFps(0);
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        Engine* engine = context_->GetSubsystem<Engine>();
+        for (unsigned i = 0; i < iterations; ++i)
+            engine->RunFrame();
+    }
+    
+    virtual void TearDown()
+    {
+        context_->GetSubsystem<Engine>()->SetMaxFps(maxFps_);
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Number of nodes.
+    unsigned numNodes_;
+    /// Engine maximum frame rate to restore.
+    int maxFps_;
+};
+
+/// Scene saving and loading in binary or XML format.
+class SceneSerializationBenchmark : public Benchmark
+{
+public:
+    SceneSerializationBenchmark(Context* context, bool xml, bool load) :
+        Benchmark(context, String("Scene/") + (load ? "Load" : "Save") + (xml ? "XML" : "Binary") + "2kNodes", xml ? 5 : 20),
+        xml_(xml),
+        load_(load)
+    {
+    }
+    
+    virtual bool Setup()
+    {
+        Model* model = context_->GetSubsystem<ResourceCache>()->GetResource<Model>("Models/Box.mdl");
+        if (!model)
+            return false;
+        
+        scene_ = CreateStaticModelScene(context_, model, 2000, 100.0f);
+        PODVector<Node*> nodes;
+        scene_->GetChildren(nodes);
+        for (unsigned i = 0; i < nodes.Size(); i += 10)
+        {
+            Light* light = nodes[i]->CreateComponent<Light>();
+            light->SetColor(Color(Random(1.0f), Random(1.0f), Random(1.0f)));
+            light->SetRange(Random(5.0f, 20.0f));
+        }
+        
+        if (xml_)
+            scene_->SaveXML(buffer_);
+        else
+            scene_->Save(buffer_);
+        SetCounter("bytes", (float)buffer_.GetSize());
+        return true;
+    }
+    
+    virtual void Run(unsigned iterations)
+    {
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            if (load_)
+            {
+                buffer_.Seek(0);
+                if (xml_)
+                    scene_->LoadXML(buffer_);
+                else
+                    scene_->Load(buffer_);
+            }
+            else
+            {
+                buffer_.Clear();
+                if (xml_)
+                    scene_->SaveXML(buffer_);
+                else
+                    scene_->Save(buffer_);
+            }
+        }
+        benchmarkSink += scene_->GetNumChildren();
+    }
+    
+    virtual void TearDown()
+    {
+        buffer_.Clear();
+        scene_.Reset();
+    }
+    
+private:
+    /// Scene.
+    SharedPtr<Scene> scene_;
+    /// Serialized scene data.
+    VectorBuffer buffer_;
+    /// XML format flag.
+    bool xml_;
+    /// Load flag. If false, measures saving instead.
+    bool load_;
+};
+
+void RegisterSceneBenchmarks(Context* context, Vector<SharedPtr<Benchmark> >& dest)
+{
+    dest.Push(SharedPtr<Benchmark>(new SceneMoveAndUpdateBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new AttributeAnimationBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new NodeSpawnBenchmark(context, false)));
+    dest.Push(SharedPtr<Benchmark>(new NodeSpawnBenchmark(context, true)));
+    dest.Push(SharedPtr<Benchmark>(new NodeIDChurnBenchmark(context)));
+    dest.Push(SharedPtr<Benchmark>(new ServerTickBenchmark(context, 0)));
+    dest.Push(SharedPtr<Benchmark>(new ServerTickBenchmark(context, 10000)));
+    dest.Push(SharedPtr<Benchmark>(new SceneSerializationBenchmark(context, false, false)));
+    dest.Push(SharedPtr<Benchmark>(new SceneSerializationBenchmark(context, false, true)));
+    dest.Push(SharedPtr<Benchmark>(new SceneSerializationBenchmark(context, true, false)));
+    dest.Push(SharedPtr<Benchmark>(new SceneSerializationBenchmark(context, true, true)));
+}
@@ -22,6 +22,7 @@
 
 #include "Context.h"
 #include "ArrayPtr.h"
+#include "ContentHash.h"
 #include "File.h"
 #include "FileSystem.h"
 #include "ProcessUtils.h"
@@ -182,6 +183,7 @@ void WritePackageFile(const String& fileName, const String& rootDir)
     }
     
     unsigned totalDataSize = 0;
+    ContentHash packageHash;
     
     // Write file data, calculate checksums & correct offsets
     for (unsigned i = 0; i < entries_.Size(); ++i)
@@ -201,11 +203,10 @@ void WritePackageFile(const String& fileName, const String& rootDir)
             ErrorExit("Could not read file " + fileFullPath);
         srcFile.Close();
         
-        for (unsigned j = 0; j < dataSize; ++j)
-        {
-            checksum_ = SDBMHash(checksum_, buffer[j]);
-            entries_[i].checksum_ = SDBMHash(entries_[i].checksum_, buffer[j]);
-        }
+        ContentHash fileHash;
+        fileHash.Update(&buffer[0], dataSize);
+        entries_[i].checksum_ = fileHash.GetChecksum();
+        packageHash.Update(&buffer[0], dataSize);
         
         if (!compress_)
         {
@@ -246,6 +247,7 @@ void WritePackageFile(const String& fileName, const String& rootDir)
     dest.WriteUInt(currentSize + sizeof(unsigned));
     
     // Write header again with correct offsets & checksums
+    checksum_ = packageHash.GetChecksum();
     dest.Seek(0);
     WriteHeader(dest);
     
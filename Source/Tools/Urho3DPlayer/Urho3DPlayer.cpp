@@ -104,6 +104,8 @@ void Urho3DPlayer::Setup()
             "-flushgpu    Flush GPU command queue each frame. Effective only on Direct3D9\n"
             "-borderless  Borderless window mode\n"
             "-headless    Headless mode. No application window will be created\n"
+            "-serverprofile Dedicated server profile. Implies headless mode and skips\n"
+            "             presentation-only updates\n"
             "-landscape   Use landscape orientations (iOS only, default)\n"
             "-portrait    Use portrait orientations (iOS only)\n"
             "-prepass     Use light pre-pass rendering\n"
@@ -112,6 +114,7 @@ void Urho3DPlayer::Setup()
             "-noshadows   Disable shadow rendering\n"
             "-nolimit     Disable frame limiter\n"
             "-nothreads   Disable worker threads\n"
+            "-pipelined   Present each frame only after the next frame's update\n"
             "-nosound     Disable sound output\n"
             "-noip        Disable sound mixing interpolation\n"
             "-sm2         Force SM2.0 rendering\n"